@@ -190,76 +190,51 @@ const Vec3 CActorComponent::GetLocalEyePos() const
 	Vec3 eyePosition { 0.0f, 0.0f, 1.82f };
 
 	// Get their character or bail early.
-	ICharacterInstance* pCharacter = GetEntity()->GetCharacter(0);
-	if (!pCharacter)
+	if (!m_skeletonBindings.Bind(GetEntity()->GetCharacter(0)))
 		return eyePosition;
 
-	// Determine the position of the left and right eyes, using their average for eyePosition.
-	const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
-	if (pAttachmentManager)
+	// Did the animators define a camera for us to use?
+	if (const IAttachment* pCameraAttachment = m_skeletonBindings.GetAttachment(EActorAttachment::Camera))
 	{
-		// Did the animators define a camera for us to use?
-		const auto eyeCamera = pAttachmentManager->GetIndexByName("#camera");
-		const IAttachment* pCameraAttachment = pAttachmentManager->GetInterfaceByIndex(eyeCamera);
-		if (pCameraAttachment)
-		{
-			// Early out and use the camera.
-			return GetEntity()->GetRotation() * pCameraAttachment->GetAttModelRelative().t;
-		}
-
-		const auto eyeLeft = pAttachmentManager->GetIndexByName("eye_left");
-		const auto eyeRight = pAttachmentManager->GetIndexByName("eye_right");
-		Vec3 eyeLeftPosition;
-		Vec3 eyeRightPosition;
-		int eyeFlags = 0;
-
-		// Is there a left eye?
-		const IAttachment* pEyeLeftAttachment = pAttachmentManager->GetInterfaceByIndex(eyeLeft);
-		if (pEyeLeftAttachment)
-		{
-			eyeLeftPosition = GetEntity()->GetRotation() * pEyeLeftAttachment->GetAttModelRelative().t;
-			eyeFlags |= 0x01;
-		}
+		// Early out and use the camera.
+		return GetEntity()->GetRotation() * pCameraAttachment->GetAttModelRelative().t;
+	}
 
-		// Is there a right eye?
-		const IAttachment* pEyeRightAttachment = pAttachmentManager->GetInterfaceByIndex(eyeRight);
-		if (pEyeRightAttachment)
-		{
-			eyeRightPosition = GetEntity()->GetRotation() * pEyeRightAttachment->GetAttModelRelative().t;
-			eyeFlags |= 0x02;
-		}
+	// Determine the position of the left and right eyes, using their average for eyePosition.
+	const IAttachment* pEyeLeftAttachment = m_skeletonBindings.GetAttachment(EActorAttachment::EyeLeft);
+	const IAttachment* pEyeRightAttachment = m_skeletonBindings.GetAttachment(EActorAttachment::EyeRight);
 
+	if (pEyeLeftAttachment && pEyeRightAttachment)
+	{
+		// Both eyes, position between the two points.
+		eyePosition = (pEyeLeftAttachment->GetAttModelRelative().t + pEyeRightAttachment->GetAttModelRelative().t) / 2.0f;
+	}
+	else if (pEyeLeftAttachment || pEyeRightAttachment)
+	{
+		// Only the one eye.
+		eyePosition = (pEyeLeftAttachment ? pEyeLeftAttachment : pEyeRightAttachment)->GetAttModelRelative().t;
+	}
+	else if (m_skeletonBindings.GetJointId(EActorJoint::Head) >= 0)
+	{
+		// No eyes, but the head is close enough.
+		const int16 headJointId = m_skeletonBindings.GetJointId(EActorJoint::Head);
+		eyePosition = m_skeletonBindings.GetCharacter()->GetISkeletonPose()->GetAbsJointByID(headJointId).t;
+	}
+	else
+	{
+		// Failure, didn't find any eyes.
+		// This will most likely spam the log. Disable it if it's annoying.
 		static bool alreadyWarned { false };
-		switch (eyeFlags)
+		if (!alreadyWarned)
 		{
-			case 0:
-				// Failure, didn't find any eyes.
-				// This will most likely spam the log. Disable it if it's annoying.
-				if (!alreadyWarned)
-				{
-					CryLogAlways("Character does not have '#camera', 'left_eye' or 'right_eye' defined.");
-					alreadyWarned = true;
-				}
-				break;
-
-			case 1:
-				// Left eye only.
-				eyePosition = eyeLeftPosition;
-				break;
-
-			case 2:
-				// Right eye only.
-				eyePosition = eyeRightPosition;
-				break;
-
-			case 3:
-				// Both eyes, position between the two points.
-				eyePosition = (eyeLeftPosition + eyeRightPosition) / 2.0f;
-				break;
+			CryLogAlways("Character does not have '#camera', 'eye_left', 'eye_right' or a head joint defined.");
+			alreadyWarned = true;
 		}
+
+		return eyePosition;
 	}
 
-	return eyePosition;
+	return GetEntity()->GetRotation() * eyePosition;
 }
 
 
@@ -268,23 +243,13 @@ Vec3 CActorComponent::GetLocalLeftHandPos() const
 	// The default, in case we can't find the actual hand position.
 	const Vec3 handPosition { -0.2f, 0.3f, 1.3f };
 
-	// Get their character or bail early.
-	ICharacterInstance* pCharacter = GetEntity()->GetCharacter(0);
-	if (pCharacter)
+	// Did the animators define a hand bone for us to use?
+	if (m_skeletonBindings.Bind(GetEntity()->GetCharacter(0)))
 	{
-		// Determine the position of the left and right eyes, using their average for eyePosition.
-		const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
+		if (const IAttachment* pAttachment = m_skeletonBindings.GetAttachment(EActorAttachment::LeftHand))
 		{
-			// Did the animators define a hand bone for us to use?
-			// #TODO: This is from SDK guys. Change this to a well defined name for our skeleton attachments.
-			const auto handBone = pAttachmentManager->GetIndexByName("left_weapon");
-			const IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(handBone);
-			if (pAttachment)
-			{
-				// We have an exact position to return.
-				return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
-			}
+			// We have an exact position to return.
+			return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
 		}
 	}
 
@@ -297,23 +262,13 @@ Vec3 CActorComponent::GetLocalRightHandPos() const
 	// The default, in case we can't find the actual hand position.
 	const Vec3 handPosition { 0.2f, 0.3f, 1.3f };
 
-	// Get their character or bail early.
-	ICharacterInstance* pCharacter = GetEntity()->GetCharacter(0);
-	if (pCharacter)
+	// Did the animators define a hand bone for us to use?
+	if (m_skeletonBindings.Bind(GetEntity()->GetCharacter(0)))
 	{
-		// Determine the position of the left and right eyes, using their average for eyePosition.
-		const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
+		if (const IAttachment* pAttachment = m_skeletonBindings.GetAttachment(EActorAttachment::RightHand))
 		{
-			// Did the animators define a hand bone for us to use?
-			// #TODO: This is from SDK guys. Change this to a well defined name for our skeleton attachments.
-			const auto handBone = pAttachmentManager->GetIndexByName("weapon");
-			const IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(handBone);
-			if (pAttachment)
-			{
-				// We have an exact position to return.
-				return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
-			}
+			// We have an exact position to return.
+			return GetEntity()->GetRotation() * pAttachment->GetAttModelRelative().t;
 		}
 	}
 
@@ -486,7 +441,9 @@ void CActorComponent::OnResetState()
 		//m_pAdvancedAnimationComponent->ResetCharacter();
 	}
 
-	// You need to reset the character after changing the animation properties.
+	// You need to reset the character after changing the animation properties. Anything we resolved on the old character
+	// no longer applies.
+	m_skeletonBindings.Invalidate();
 	m_pAdvancedAnimationComponent->ResetCharacter();
 
 	// HACK: the CAdvancedAnimation doesn't allow us to queue actions yet, this is a workaround.
@@ -616,7 +573,8 @@ void CActorComponent::OnActionItemDrop()
 
 		if (auto pInteractor = pTargetEntity->GetComponent<CEntityInteractionComponent>())
 		{
-			if (auto pInteraction = pInteractor->GetInteraction("interaction_drop")._Get())
+			static const CryHash dropVerbId = CEntityInteractionComponent::GetVerbId("interaction_drop");
+			if (auto pInteraction = pInteractor->GetInteraction(dropVerbId)._Get())
 			{
 				pInteraction->OnInteractionStart();
 			}
@@ -636,7 +594,8 @@ void CActorComponent::OnActionItemToss()
 
 		if (auto pInteractor = pTargetEntity->GetComponent<CEntityInteractionComponent>())
 		{
-			if (auto pInteraction = pInteractor->GetInteraction("interaction_toss")._Get())
+			static const CryHash tossVerbId = CEntityInteractionComponent::GetVerbId("interaction_toss");
+			if (auto pInteraction = pInteractor->GetInteraction(tossVerbId)._Get())
 			{
 				pInteraction->OnInteractionStart();
 			}
@@ -660,10 +619,10 @@ void CActorComponent::OnActionBarUse(int actionBarId)
 			if (auto pInteractor = pTargetEntity->GetComponent<CEntityInteractionComponent>())
 			{
 				// There's an interactor component, so this is an interactive entity.
-				auto verbs = pInteractor->GetVerbs();
+				const auto& verbs = pInteractor->GetVerbs();
 				if (verbs.size() >= actionBarId)
 				{
-					auto verb = verbs [actionBarId - 1];
+					const char* verb = verbs [actionBarId - 1];
 					auto pInteraction = pInteractor->GetInteraction(verb)._Get();
 
 					pInteraction->OnInteractionStart();
@@ -697,10 +656,10 @@ void CActorComponent::OnActionInspect()
 			if (auto pInteractor = pInteractionEntity->GetComponent<CEntityInteractionComponent>())
 			{
 				// There's an interactor component, so this is an interactive entity.
-				auto verbs = pInteractor->GetVerbs();
+				const auto& verbs = pInteractor->GetVerbs();
 				if (verbs.size() > 0)
 				{
-					auto verb = verbs [0];
+					const char* verb = verbs [0];
 
 					// HACK: TEST making a call to the DRS system
 					auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pInteractionEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
@@ -746,23 +705,23 @@ void CActorComponent::OnActionInteractionStart()
 			{
 				// There's an interactor component, so this is an interactive entity.
 				// #TODO: We should really only process an 'interact' verb - not simply the first entry.
-				auto verbs = pInteractor->GetVerbs();
+				const auto& verbs = pInteractor->GetVerbs();
 				if (verbs.size() > 0)
 				{
 					// Display the verbs in a cheap manner.
 					CryLogAlways("VERBS");
 					int index { 1 };
-					for (auto& verb : verbs)
+					for (const char* verb : verbs)
 					{
 						CryLogAlways("%d) %s", index, verb);
 						index++;
 					}
 
-					auto verb = verbs [0];
+					const char* verb = verbs [0];
 
 					// #HACK: Another test - just calling the interaction directly instead.
 					m_pInteraction = pInteractor->GetInteraction(verb)._Get();
-					CryLogAlways("Player started interacting with: %s", m_pInteraction->GetVerbUI());
+					CryLogAlways("Player started interacting with: %s", m_pInteraction->GetVerbUI().c_str());
 					m_pInteraction->OnInteractionStart();
 
 					// HACK: Doesn't belong here, test to see if we can queue an interaction action.
@@ -779,7 +738,7 @@ void CActorComponent::OnActionInteraction()
 {
 	if (m_pInteraction)
 	{
-		CryWatch("Interacting with: %s", m_pInteraction->GetVerbUI());
+		CryWatch("Interacting with: @%s", m_pInteraction->GetVerb());
 		m_pInteraction->OnInteractionTick();
 	}
 	else
@@ -793,7 +752,7 @@ void CActorComponent::OnActionInteractionEnd()
 {
 	if (m_pInteraction)
 	{
-		CryLogAlways("Player stopped interacting with: %s", m_pInteraction->GetVerbUI());
+		CryLogAlways("Player stopped interacting with: %s", m_pInteraction->GetVerbUI().c_str());
 		m_pInteraction->OnInteractionComplete();
 	}
 	else
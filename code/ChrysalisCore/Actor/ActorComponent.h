@@ -8,6 +8,7 @@
 #include "DefaultComponents/Physics/CharacterControllerComponent.h"
 #include <Components/Player/Input/PlayerInputComponent.h>
 #include <Actor/ActorControllerComponent.h>
+#include <Actor/ActorSkeletonBindings.h>
 
 
 namespace Chrysalis
@@ -526,6 +527,9 @@ private:
 	/** The pre-determined fate for this actor. */
 	CFate m_fate;
 
+	/** The attachments and joints we need on the character, resolved once for each character instance. */
+	mutable CActorSkeletonBindings m_skeletonBindings;
+
 	
 	// ***
 	// *** AI / Player Control
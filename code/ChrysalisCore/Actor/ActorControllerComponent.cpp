@@ -2,6 +2,9 @@
 
 #include "ActorControllerComponent.h"
 #include "Components/Player/PlayerComponent.h"
+#include "Actor/Movement/ActorPhysicsSnapshot.h"
+#include "Actor/Movement/StateMachine/ActorStateUtility.h"
+#include "Plugin/ChrysalisCorePlugin.h"
 
 
 namespace Chrysalis
@@ -46,6 +49,9 @@ void CActorControllerComponent::Initialize()
 	if (strlen (m_pAdvancedAnimationComponent->GetControllerDefinitionFile()) > 0)
 		m_rotateTagId = m_pAdvancedAnimationComponent->GetTagId("Rotate");
 
+	// Our physics state is gathered along with every other actor's, once per frame.
+	CChrysalisCorePlugin::Get()->GetActorPhysicsSnapshot()->Register(GetEntityId());
+
 	// Initialise the movement state machine.
 	MovementHSMInit();
 
@@ -54,6 +60,15 @@ void CActorControllerComponent::Initialize()
 }
 
 
+CActorControllerComponent::~CActorControllerComponent()
+{
+	MovementHSMRelease();
+
+	if (auto pPhysicsSnapshot = CChrysalisCorePlugin::Get()->GetActorPhysicsSnapshot())
+		pPhysicsSnapshot->Unregister(GetEntityId());
+}
+
+
 void CActorControllerComponent::ProcessEvent(SEntityEvent& event)
 {
 	switch (event.event)
@@ -97,11 +112,10 @@ void CActorControllerComponent::Update(SEntityUpdateContext* pCtx)
 
 void CActorControllerComponent::PrePhysicsUpdate()
 {
-	// TODO: HACK: BROKEN: This stuff was commented out in the character pre-physics. Some of it might belong here now.
+	// Read our physics state from the snapshot, before anything in the state machine needs it.
+	CActorStateUtility::UpdatePhysicsState(*this, m_actorPhysics, gEnv->pTimer->GetFrameTime());
 
-	//	// The routine will need to be rewritten to work with actors only, or we need a new one that does the actor, that
-	//	// is called by a character version of this.
-	//	CActorStateUtility::UpdatePhysicsState(*this, m_actorPhysics, frameTime);
+	// TODO: HACK: BROKEN: This stuff was commented out in the character pre-physics. Some of it might belong here now.
 
 	//	//#ifdef STATE_DEBUG
 	//	//		if (g_pGameCVars->pl_watchPlayerState >= (bIsClient ? 1 : 2))
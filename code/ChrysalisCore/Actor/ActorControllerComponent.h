@@ -28,7 +28,7 @@ struct SActorPhysics
 
 
 	SActorPhysics()
-		/*: angVelocity(ZERO)
+		: angVelocity(ZERO)
 		, velocity(ZERO)
 		, velocityDelta(ZERO)
 		, velocityUnconstrained(ZERO)
@@ -40,14 +40,14 @@ struct SActorPhysics
 		, mass(80.0f)
 		, lastFrameUpdate(0)
 		, groundMaterialIdx(-1)
-		, groundColliderId(0)*/
+		, groundColliderId(0)
 	{}
 
 	void Serialize(TSerialize ser, EEntityAspects aspects) {};
 
 	CCryFlags<uint32> flags;
 
-	/*	Vec3 angVelocity;
+	Vec3 angVelocity;
 	Vec3 velocity;
 	Vec3 velocityDelta;
 	Vec3 velocityUnconstrained;
@@ -62,7 +62,6 @@ struct SActorPhysics
 	int lastFrameUpdate;
 	int groundMaterialIdx;
 	EntityId groundColliderId;
-	*/
 };
 
 
@@ -86,7 +85,9 @@ enum EActorStance
 	eAS_Spellcasting,
 	eAS_SittingChair,
 	eAS_SittingFloor,
-	eAS_Kneeling
+	eAS_Kneeling,
+
+	eAS_COUNT
 };
 
 
@@ -113,6 +114,8 @@ enum EActorPosture
 	eAP_Bored,
 	eAP_Excited,
 	eAP_Depressed,
+
+	eAP_COUNT
 };
 
 
@@ -186,7 +189,7 @@ protected:
 
 public:
 	CActorControllerComponent() {}
-	virtual ~CActorControllerComponent() { MovementHSMRelease(); }
+	virtual ~CActorControllerComponent();
 
 	static void ReflectType(Schematyc::CTypeDesc<CActorControllerComponent>& desc);
 
@@ -246,6 +249,9 @@ public:
 	const Vec3& GetVelocity() const { return m_pCharacterControllerComponent->GetVelocity(); }
 	Vec3 GetMoveDirection() const { return m_pCharacterControllerComponent->GetMoveDirection(); }
 
+	/** The actor's physics state, as of the last pre-physics update. */
+	const SActorPhysics& GetActorPhysics() const { return m_actorPhysics; }
+
 	float virtual GetMovementBaseSpeed(TInputFlags movementDirectionFlags) const;
 
 	/** Should the actor attemp a jump this frame? */
@@ -304,6 +310,9 @@ private:
 	Cry::DefaultComponents::CAdvancedAnimationComponent* m_pAdvancedAnimationComponent { nullptr };
 	Cry::DefaultComponents::CCharacterControllerComponent* m_pCharacterControllerComponent { nullptr };
 
+	/** Our physics state, read from the shared physics snapshot once each frame. */
+	SActorPhysics m_actorPhysics;
+
 	TagID m_rotateTagId { TAG_ID_INVALID };
 
 	/** A vector representing the direction and distance the player has requested this actor to move. */
@@ -0,0 +1,99 @@
+#include <StdAfx.h>
+
+#include "ActorSkeletonBindings.h"
+#include <CryAnimation/ICryAnimation.h>
+
+
+namespace Chrysalis
+{
+namespace
+{
+/** The attachment names, in the same order as EActorAttachment. */
+// #TODO: The hands are from SDK guys. Change these to well defined names for our skeleton attachments.
+const char* const attachmentNames [] = { "#camera", "eye_left", "eye_right", "left_weapon", "weapon" };
+static_assert(CRY_ARRAY_COUNT(attachmentNames) == int(EActorAttachment::Count), "Every attachment needs a name.");
+
+/** The joint names, in the same order as EActorJoint. */
+const char* const jointNames [] = { "Bip01 Head" };
+static_assert(CRY_ARRAY_COUNT(jointNames) == int(EActorJoint::Count), "Every joint needs a name.");
+}
+
+
+CActorSkeletonBindings::CActorSkeletonBindings()
+{
+	Invalidate();
+}
+
+
+bool CActorSkeletonBindings::Bind(ICharacterInstance* pCharacter)
+{
+	if (pCharacter != m_pCharacter)
+	{
+		m_pCharacter = pCharacter;
+		Resolve();
+	}
+
+	return m_pCharacter != nullptr;
+}
+
+
+void CActorSkeletonBindings::Invalidate()
+{
+	m_pCharacter = nullptr;
+	Resolve();
+}
+
+
+IAttachment* CActorSkeletonBindings::GetAttachment(EActorAttachment attachment)
+{
+	if (!m_pCharacter)
+		return nullptr;
+
+	IAttachmentManager* pAttachmentManager = m_pCharacter->GetIAttachmentManager();
+	if (!pAttachmentManager)
+		return nullptr;
+
+	const SAttachmentBinding& binding = m_attachments [int(attachment)];
+	if (binding.index < 0)
+		return nullptr;
+
+	IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(binding.index);
+	if (pAttachment && (pAttachment->GetNameCRC() == binding.nameCRC))
+		return pAttachment;
+
+	// Attachments have been added or removed since we resolved them, shuffling the indices about.
+	Resolve();
+
+	return (binding.index >= 0) ? pAttachmentManager->GetInterfaceByIndex(binding.index) : nullptr;
+}
+
+
+void CActorSkeletonBindings::Resolve()
+{
+	for (auto& binding : m_attachments)
+		binding = SAttachmentBinding();
+
+	for (auto& jointId : m_jointIds)
+		jointId = -1;
+
+	if (!m_pCharacter)
+		return;
+
+	if (const IAttachmentManager* pAttachmentManager = m_pCharacter->GetIAttachmentManager())
+	{
+		for (int i = 0; i < int(EActorAttachment::Count); ++i)
+		{
+			const int32 index = pAttachmentManager->GetIndexByName(attachmentNames [i]);
+			if (const IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(index))
+			{
+				m_attachments [i].index = index;
+				m_attachments [i].nameCRC = pAttachment->GetNameCRC();
+			}
+		}
+	}
+
+	const IDefaultSkeleton& defaultSkeleton = m_pCharacter->GetIDefaultSkeleton();
+	for (int i = 0; i < int(EActorJoint::Count); ++i)
+		m_jointIds [i] = int16(defaultSkeleton.GetJointIDByName(jointNames [i]));
+}
+}
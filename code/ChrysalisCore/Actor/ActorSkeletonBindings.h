@@ -0,0 +1,96 @@
+/**
+\file	Actor\ActorSkeletonBindings.h
+
+Resolves the attachments and joints an actor needs to find on its character, such as the eyes and hands, once per
+character instance. Looking these up by name is far too slow to do each time a camera or awareness query wants to know
+where the eyes are. Lookups after the first are a single index into the attachment manager, plus a CRC check to make sure
+the attachment at that index hasn't changed underneath us.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+/** The character attachments an actor binds to. */
+enum class EActorAttachment
+{
+	Camera,
+	EyeLeft,
+	EyeRight,
+	LeftHand,
+	RightHand,
+
+	Count
+};
+
+
+/** The skeleton joints an actor binds to. */
+enum class EActorJoint
+{
+	Head,
+
+	Count
+};
+
+
+class CActorSkeletonBindings
+{
+public:
+	CActorSkeletonBindings();
+
+
+	/**
+	Binds to a character instance. The names are only resolved when the character is different to the one we are already
+	bound to, so this is cheap to call every time the bindings are needed.
+
+	\param	pCharacter The character instance, which may be null.
+
+	\return True if we are bound to a character.
+	**/
+	bool Bind(ICharacterInstance* pCharacter);
+
+
+	/** Forgets the current character, forcing the names to be resolved again on the next bind. */
+	void Invalidate();
+
+
+	/**
+	Gets an attachment on the bound character.
+
+	\param	attachment The attachment.
+
+	\return Null if the character doesn't have that attachment, else the attachment.
+	**/
+	IAttachment* GetAttachment(EActorAttachment attachment);
+
+
+	/**
+	Gets the identifier for a joint on the bound character.
+
+	\param	joint The joint.
+
+	\return The joint identifier, or -1 if the skeleton doesn't have that joint.
+	**/
+	int16 GetJointId(EActorJoint joint) const { return m_jointIds [int(joint)]; }
+
+
+	/** Gets the character we are bound to. */
+	ICharacterInstance* GetCharacter() const { return m_pCharacter; }
+
+private:
+	/** Clears the bindings, then looks up every attachment and joint by name on the current character. */
+	void Resolve();
+
+	struct SAttachmentBinding
+	{
+		int32 index { -1 };
+		uint32 nameCRC { 0 };
+	};
+
+	/** Held by smart pointer, so the instance can't be freed and another allocated in its place without us noticing. */
+	_smart_ptr<ICharacterInstance> m_pCharacter;
+
+	SAttachmentBinding m_attachments [int(EActorAttachment::Count)];
+	int16 m_jointIds [int(EActorJoint::Count)];
+};
+}
@@ -2,6 +2,7 @@
 
 #include "ICryMannequin.h"
 #include <Actor/Animation/ActorAnimation.h>
+#include <Actor/Animation/Actions/ActorAnimationActionPool.h>
 
 
 namespace Chrysalis
@@ -86,6 +87,7 @@ class CActorAnimationActionEmote : public CAnimationAction
 {
 public:
 	DEFINE_ACTION("Emote");
+	DECLARE_POOLED_ACTION(CActorAnimationActionEmote);
 
 	CActorAnimationActionEmote(TagID emoteTagId);
 
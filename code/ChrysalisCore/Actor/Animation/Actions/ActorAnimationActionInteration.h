@@ -2,6 +2,7 @@
 
 #include "ICryMannequin.h"
 #include <Actor/Animation/ActorAnimation.h>
+#include <Actor/Animation/Actions/ActorAnimationActionPool.h>
 
 
 namespace Chrysalis
@@ -10,6 +11,7 @@ class CActorAnimationActionInteraction : public CAnimationAction
 {
 public:
 	DEFINE_ACTION("Interaction");
+	DECLARE_POOLED_ACTION(CActorAnimationActionInteraction);
 
 	CActorAnimationActionInteraction();
 	virtual ~CActorAnimationActionInteraction() {};
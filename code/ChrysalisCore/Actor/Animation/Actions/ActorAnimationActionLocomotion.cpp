@@ -1,6 +1,7 @@
 #include <StdAfx.h>
 
 #include "ActorAnimationActionLocomotion.h"
+#include <Actor/ActorComponent.h>
 
 
 namespace Chrysalis
@@ -77,6 +78,7 @@ void CActorAnimationActionLocomotion::OnInitialise()
 
 	m_locomotionParams = GetMannequinUserParams<SMannequinLocomotionParams>(*m_context);
 	CRY_ASSERT(m_locomotionParams);
+	BuildTagMap();
 
 	// Idle pose is a reasonable default.
 	m_lastFragmentId = m_locomotionParams->fragmentIDs.Idle;
@@ -124,131 +126,60 @@ IAction::EStatus CActorAnimationActionLocomotion::Update(float timePassed)
 
 	// Grab the actor in the root scope.
 	const IScope& rootScope = GetRootScope();
-	CActorComponent& actor = *CActorComponent::GetActor(rootScope.GetEntityId());
-
-	// Set stance tags if they have changed.
-	const auto newStance = actor.GetStance();
-	if (m_lastStance != newStance)
+	if (!m_pActor)
 	{
-		switch (newStance)
-		{
-			case EActorStance::eAS_Crawling:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Crawling, true);
-				break;
-
-			case EActorStance::eAS_Prone:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Prone, true);
-				break;
-
-			case EActorStance::eAS_Crouching:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Crouching, true);
-				break;
-
-			case EActorStance::eAS_Falling:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Falling, true);
-				break;
-
-			case EActorStance::eAS_Flying:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Flying, true);
-				break;
-
-			case EActorStance::eAS_Kneeling:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Kneeling, true);
-				break;
+		m_pActor = CActorComponent::GetActor(rootScope.GetEntityId());
+		if (!m_pActor)
+			return EStatus();
+	}
 
-			case EActorStance::eAS_Landing:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Landing, true);
-				break;
+	const CActorComponent& actor = *m_pActor;
+	const bool isMoving = actor.GetVelocity().GetLengthSquared() > sqr(FLT_EPSILON);
 
-			case EActorStance::eAS_SittingChair:
-				GetContext().state.Set(m_locomotionParams->tagIDs.SittingChair, true);
-				break;
+	ELocomotionGait gait { eLG_None };
+	if (isMoving)
+		gait = actor.IsSprinting() ? eLG_Sprint : (actor.IsJogging() ? eLG_Run : eLG_Walk);
 
-			case EActorStance::eAS_SittingFloor:
-				GetContext().state.Set(m_locomotionParams->tagIDs.SittingFloor, true);
-				break;
+	// Work out the full set of tags we want, with exactly one tag from each group. Setting a group clears whatever else
+	// was set in that group, so tags from earlier states no longer build up.
+	const TagID groupTags [eLTG_COUNT] = {
+		m_tagMap.stanceTags [actor.GetStance()],
+		m_tagMap.postureTags [actor.GetPosture()],
+		m_tagMap.gaitTags [gait],
+		m_tagMap.directionTags [isMoving ? GetLocalMoveDirection(actor) : eLD_None],
+	};
 
-			case EActorStance::eAS_Spellcasting:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Spellcasting, true);
-				break;
+	CTagState& tagState = GetContext().state;
+	const CTagDefinition& tagDefinition = tagState.GetDef();
+	TagState wantedTags = tagState.GetMask();
 
-			case EActorStance::eAS_Standing:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Standing, true);
-				break;
+	for (int i = 0; i < eLTG_COUNT; ++i)
+	{
+		if (m_tagMap.groupIds [i] == GROUP_ID_NONE)
+			continue;
 
-			case EActorStance::eAS_Swimming:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Swimming, true);
-				break;
-		}
+		if (groupTags [i] != TAG_ID_INVALID)
+			tagDefinition.SetGroup(wantedTags, m_tagMap.groupIds [i], groupTags [i]);
+		else
+			tagDefinition.ClearGroup(wantedTags, m_tagMap.groupIds [i]);
 	}
 
-	// Cycle.
-	m_lastStance = newStance;
-
-	// Set posture tags if they have changed.
-	const auto newPosture = actor.GetPosture();
-	if (m_lastPosture != newPosture)
+	// Most frames nothing changes, and we leave the tag state alone so mannequin has no reason to look at it again.
+	if (wantedTags != tagState.GetMask())
 	{
-		switch (newPosture)
+		for (int i = 0; i < eLTG_COUNT; ++i)
 		{
-			case EActorPosture::eAP_Aggressive:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Aggressive, true);
-				break;
-
-			case EActorPosture::eAP_Alerted:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Alerted, true);
-				break;
-
-			case EActorPosture::eAP_Bored:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Bored, true);
-				break;
-
-			case EActorPosture::eAP_Dazed:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Dazed, true);
-				break;
-
-			case EActorPosture::eAP_Depressed:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Depressed, true);
-				break;
-
-			case EActorPosture::eAP_Distracted:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Distracted, true);
-				break;
+			if (m_tagMap.groupIds [i] == GROUP_ID_NONE)
+				continue;
 
-			case EActorPosture::eAP_Excited:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Excited, true);
-				break;
-
-			case EActorPosture::eAP_Interested:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Interested, true);
-				break;
-
-			case EActorPosture::eAP_Neutral:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Neutral, true);
-				break;
-
-			case EActorPosture::eAP_Passive:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Passive, true);
-				break;
-
-			case EActorPosture::eAP_Suspicious:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Suspicious, true);
-				break;
-
-			case EActorPosture::eAP_Unaware:
-				GetContext().state.Set(m_locomotionParams->tagIDs.Unaware, true);
-				break;
+			if (groupTags [i] != TAG_ID_INVALID)
+				tagState.SetGroup(m_tagMap.groupIds [i], groupTags [i]);
+			else
+				tagState.ClearGroup(m_tagMap.groupIds [i]);
 		}
 	}
 
-	// Cycle.
-	m_lastPosture = newPosture;
-
-	FragmentID newFragmentId;
-	if (actor.GetVelocity().len() > FLT_EPSILON)
-		newFragmentId = m_locomotionParams->fragmentIDs.Move;
-	else
-		newFragmentId = m_locomotionParams->fragmentIDs.Idle;
+	const FragmentID newFragmentId = isMoving ? m_locomotionParams->fragmentIDs.Move : m_locomotionParams->fragmentIDs.Idle;
 
 	// Set the new fragment, if needed.
 	if (m_lastFragmentId != newFragmentId)
@@ -265,4 +196,65 @@ IAction::EStatus CActorAnimationActionLocomotion::Update(float timePassed)
 
 	return EStatus();
 }
+
+
+void CActorAnimationActionLocomotion::BuildTagMap()
+{
+	const auto& tagIDs = m_locomotionParams->tagIDs;
+	const auto& tagGroupIDs = m_locomotionParams->tagGroupIDs;
+
+	m_tagMap.groupIds [eLTG_Stance] = tagGroupIDs.Stance;
+	m_tagMap.groupIds [eLTG_Posture] = tagGroupIDs.Posture;
+	m_tagMap.groupIds [eLTG_Gait] = tagGroupIDs.Gait;
+	m_tagMap.groupIds [eLTG_Direction] = tagGroupIDs.LocalMoveDirection;
+
+	m_tagMap.stanceTags [eAS_Standing] = tagIDs.Standing;
+	m_tagMap.stanceTags [eAS_Crouching] = tagIDs.Crouching;
+	m_tagMap.stanceTags [eAS_Crawling] = tagIDs.Crawling;
+	m_tagMap.stanceTags [eAS_Prone] = tagIDs.Prone;
+	m_tagMap.stanceTags [eAS_Falling] = tagIDs.Falling;
+	m_tagMap.stanceTags [eAS_Landing] = tagIDs.Landing;
+	m_tagMap.stanceTags [eAS_Swimming] = tagIDs.Swimming;
+	m_tagMap.stanceTags [eAS_Flying] = tagIDs.Flying;
+	m_tagMap.stanceTags [eAS_Spellcasting] = tagIDs.Spellcasting;
+	m_tagMap.stanceTags [eAS_SittingChair] = tagIDs.SittingChair;
+	m_tagMap.stanceTags [eAS_SittingFloor] = tagIDs.SittingFloor;
+	m_tagMap.stanceTags [eAS_Kneeling] = tagIDs.Kneeling;
+
+	m_tagMap.postureTags [eAP_Unaware] = tagIDs.Unaware;
+	m_tagMap.postureTags [eAP_Distracted] = tagIDs.Distracted;
+	m_tagMap.postureTags [eAP_Suspicious] = tagIDs.Suspicious;
+	m_tagMap.postureTags [eAP_Alerted] = tagIDs.Alerted;
+	m_tagMap.postureTags [eAP_Dazed] = tagIDs.Dazed;
+	m_tagMap.postureTags [eAP_Neutral] = tagIDs.Neutral;
+	m_tagMap.postureTags [eAP_Passive] = tagIDs.Passive;
+	m_tagMap.postureTags [eAP_Aggressive] = tagIDs.Aggressive;
+	m_tagMap.postureTags [eAP_Interested] = tagIDs.Interested;
+	m_tagMap.postureTags [eAP_Bored] = tagIDs.Bored;
+	m_tagMap.postureTags [eAP_Excited] = tagIDs.Excited;
+	m_tagMap.postureTags [eAP_Depressed] = tagIDs.Depressed;
+
+	m_tagMap.gaitTags [eLG_None] = tagIDs.NoGait;
+	m_tagMap.gaitTags [eLG_Walk] = tagIDs.Walk;
+	m_tagMap.gaitTags [eLG_Run] = tagIDs.Run;
+	m_tagMap.gaitTags [eLG_Sprint] = tagIDs.Sprint;
+
+	m_tagMap.directionTags [eLD_None] = tagIDs.NoMovement;
+	m_tagMap.directionTags [eLD_Forward] = tagIDs.MoveForward;
+	m_tagMap.directionTags [eLD_Backward] = tagIDs.MoveBackward;
+	m_tagMap.directionTags [eLD_Left] = tagIDs.MoveLeft;
+	m_tagMap.directionTags [eLD_Right] = tagIDs.MoveRight;
+}
+
+
+CActorAnimationActionLocomotion::ELocomotionDirection CActorAnimationActionLocomotion::GetLocalMoveDirection(const CActorComponent& actor)
+{
+	// Bring the velocity into the actor's space, and go with whichever axis is dominant.
+	const Vec3 localVelocity = actor.GetEntity()->GetWorldRotation().GetInverted() * actor.GetVelocity();
+
+	if (fabs_tpl(localVelocity.y) >= fabs_tpl(localVelocity.x))
+		return (localVelocity.y >= 0.0f) ? eLD_Forward : eLD_Backward;
+
+	return (localVelocity.x >= 0.0f) ? eLD_Right : eLD_Left;
+}
 }
\ No newline at end of file
@@ -2,15 +2,20 @@
 
 #include "ICryMannequin.h"
 #include <Actor/Animation/ActorAnimation.h>
+#include <Actor/Animation/Actions/ActorAnimationActionPool.h>
 #include "Actor/ActorControllerComponent.h"
 
 
 namespace Chrysalis
 {
+class CActorComponent;
+
+
 class CActorAnimationActionLocomotion : public CAnimationAction
 {
 public:
 	DEFINE_ACTION("Locomotion");
+	DECLARE_POOLED_ACTION(CActorAnimationActionLocomotion);
 
 	CActorAnimationActionLocomotion();
 	virtual ~CActorAnimationActionLocomotion() {};
@@ -26,12 +31,69 @@ public:
 	// ~IAction
 
 private:
+	enum ELocomotionGait
+	{
+		eLG_None,
+		eLG_Walk,
+		eLG_Run,
+		eLG_Sprint,
+
+		eLG_COUNT
+	};
+
+	enum ELocomotionDirection
+	{
+		eLD_None,
+		eLD_Forward,
+		eLD_Backward,
+		eLD_Left,
+		eLD_Right,
+
+		eLD_COUNT
+	};
+
+	enum ELocomotionTagGroup
+	{
+		eLTG_Stance,
+		eLTG_Posture,
+		eLTG_Gait,
+		eLTG_Direction,
+
+		eLTG_COUNT
+	};
+
+	/** Maps each of the actor's locomotion states onto the tag which represents it, within its tag group. */
+	struct SLocomotionTagMap
+	{
+		TagGroupID groupIds [eLTG_COUNT];
+		TagID stanceTags [eAS_COUNT];
+		TagID postureTags [eAP_COUNT];
+		TagID gaitTags [eLG_COUNT];
+		TagID directionTags [eLD_COUNT];
+	};
+
+
+	/** Builds the tag map from the mannequin parameters. */
+	void BuildTagMap();
+
+
+	/**
+	Works out which way the actor is moving, relative to the way they are facing.
+
+	\param	actor The actor.
+
+	\return The direction.
+	**/
+	static ELocomotionDirection GetLocalMoveDirection(const CActorComponent& actor);
+
 	const struct SMannequinLocomotionParams* m_locomotionParams;
 
-	FragmentID m_lastFragmentId { FRAGMENT_ID_INVALID };
+	/** Built once, when the action is initialised. */
+	SLocomotionTagMap m_tagMap;
 
-	EActorStance m_lastStance { EActorStance::eAS_Standing };
+	/** The actor in the root scope. They own the action controller, so they outlive us. */
+	const CActorComponent* m_pActor { nullptr };
 
-	EActorPosture m_lastPosture { EActorPosture::eAP_Neutral };
+	FragmentID m_lastFragmentId { FRAGMENT_ID_INVALID };
 };
 }
\ No newline at end of file
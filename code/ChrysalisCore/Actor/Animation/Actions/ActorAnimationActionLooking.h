@@ -2,6 +2,7 @@
 
 #include "ICryMannequin.h"
 #include <Actor/Animation/ActorAnimation.h>
+#include <Actor/Animation/Actions/ActorAnimationActionPool.h>
 
 
 namespace Chrysalis
@@ -10,6 +11,7 @@ class CActorAnimationActionLooking : public CAnimationAction
 {
 public:
 	DEFINE_ACTION("Looking");
+	DECLARE_POOLED_ACTION(CActorAnimationActionLooking);
 
 	CActorAnimationActionLooking();
 
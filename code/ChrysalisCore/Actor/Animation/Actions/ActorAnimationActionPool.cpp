@@ -0,0 +1,18 @@
+#include <StdAfx.h>
+
+#include "ActorAnimationActionPool.h"
+
+
+namespace Chrysalis
+{
+void LogActionPoolStats()
+{
+	CryLogAlways("Action pools: %-40s %8s %8s %8s %8s", "class", "live", "peak", "allocs", "reuses");
+
+	for (const SActionPoolStats* pStats = GetActionPoolStatsList(); pStats; pStats = pStats->pNext)
+	{
+		CryLogAlways("Action pools: %-40s %8d %8d %8d %8d", pStats->name, pStats->live, pStats->highWaterMark,
+			pStats->allocations, pStats->reuses);
+	}
+}
+}
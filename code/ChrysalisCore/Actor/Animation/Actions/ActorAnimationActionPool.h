@@ -0,0 +1,130 @@
+/**
+\file	Actor\Animation\Actions\ActorAnimationActionPool.h
+
+Pooled storage for mannequin actions. Actions are reference counted by mannequin and deleted once the last reference is
+released, which for emotes and interactions can be many times a second in a crowd. Classes which add
+DECLARE_POOLED_ACTION get their own operator new and delete, so that storage goes back to a free list for that class
+instead of the heap, and the existing "new CMyAction(...)" call sites don't need to change.
+
+Actions are created and released on the main thread, so the pools are not locked.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+/** Counters for a single action pool. The pools link themselves into a list, so they can all be reported on. */
+struct SActionPoolStats
+{
+	const char* name { nullptr };
+	int allocations { 0 };
+	int reuses { 0 };
+	int live { 0 };
+
+	/** The most actions of this type which have been alive at once. This is how many the pool holds onto. */
+	int highWaterMark { 0 };
+
+	SActionPoolStats* pNext { nullptr };
+};
+
+
+/** The head of the list of every action pool which has been used. */
+inline SActionPoolStats*& GetActionPoolStatsList()
+{
+	static SActionPoolStats* pHead { nullptr };
+	return pHead;
+}
+
+
+/** Logs the counters for every action pool which has been used. */
+void LogActionPoolStats();
+
+
+template<typename TYPE>
+class CActionPool
+{
+public:
+	/**
+	Provides storage for an action, recycling the storage from a previously released action if there is one.
+
+	\param	size The size requested by operator new. Classes deriving from TYPE will ask for more, and are passed
+				 through to the heap.
+	\param	name The name of the class, for the stats.
+
+	\return Storage for an action.
+	**/
+	static void* Allocate(const size_t size, const char* name)
+	{
+		if (size != sizeof(TYPE))
+			return CryModuleMemalign(size, alignof(std::max_align_t));
+
+		CActionPool& pool = Get(name);
+		pool.m_stats.live++;
+		pool.m_stats.highWaterMark = max(pool.m_stats.highWaterMark, pool.m_stats.live);
+
+		if (void* pBlock = pool.m_pFreeList)
+		{
+			pool.m_pFreeList = *static_cast<void**>(pBlock);
+			pool.m_stats.reuses++;
+
+			return pBlock;
+		}
+
+		pool.m_stats.allocations++;
+
+		return CryModuleMemalign(max(sizeof(TYPE), sizeof(void*)), alignof(std::max_align_t));
+	}
+
+
+	/**
+	Returns the storage for a destructed action to the pool.
+
+	\param	pBlock The storage.
+	\param	size   The size passed to operator delete, which is the size of the most derived class.
+	\param	name   The name of the class, for the stats.
+	**/
+	static void Free(void* pBlock, const size_t size, const char* name)
+	{
+		if (!pBlock)
+			return;
+
+		if (size != sizeof(TYPE))
+		{
+			CryModuleMemalignFree(pBlock);
+			return;
+		}
+
+		CActionPool& pool = Get(name);
+		pool.m_stats.live--;
+
+		*static_cast<void**>(pBlock) = pool.m_pFreeList;
+		pool.m_pFreeList = pBlock;
+	}
+
+private:
+	explicit CActionPool(const char* name)
+	{
+		m_stats.name = name;
+		m_stats.pNext = GetActionPoolStatsList();
+		GetActionPoolStatsList() = &m_stats;
+	}
+
+
+	static CActionPool& Get(const char* name)
+	{
+		static CActionPool pool(name);
+		return pool;
+	}
+
+	/** Released actions are kept on an intrusive free list, ready to be constructed into again. */
+	void* m_pFreeList { nullptr };
+
+	SActionPoolStats m_stats;
+};
+
+
+/** Add to the declaration of a concrete action class to allocate it from a pool. */
+#define DECLARE_POOLED_ACTION(CLASS) \
+	static void* operator new(size_t size) { return CActionPool<CLASS>::Allocate(size, #CLASS); } \
+	static void operator delete(void* pBlock, size_t size) { CActionPool<CLASS>::Free(pBlock, size, #CLASS); }
+}
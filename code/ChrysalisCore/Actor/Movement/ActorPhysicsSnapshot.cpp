@@ -0,0 +1,208 @@
+#include <StdAfx.h>
+
+#include "ActorPhysicsSnapshot.h"
+#include <CryPhysics/physinterface.h>
+#include <Actor/ActorControllerComponent.h>
+
+
+namespace Chrysalis
+{
+CActorPhysicsSnapshot::CActorPhysicsSnapshot()
+{
+}
+
+
+CActorPhysicsSnapshot::~CActorPhysicsSnapshot()
+{
+}
+
+
+void CActorPhysicsSnapshot::Register(EntityId entityId)
+{
+	if ((entityId == INVALID_ENTITYID) || (m_entryLookup.find(entityId) != m_entryLookup.end()))
+		return;
+
+	m_entryLookup [entityId] = uint32(m_entityIds.size());
+
+	m_entityIds.push_back(entityId);
+	m_flags.push_back(0);
+	m_velocity.push_back(ZERO);
+	m_velocityUnconstrained.push_back(ZERO);
+	m_angVelocity.push_back(ZERO);
+	m_gravity.push_back(ZERO);
+	m_groundNormal.push_back(Vec3(0.0f, 0.0f, 1.0f));
+	m_groundHeight.push_back(0.0f);
+	m_mass.push_back(0.0f);
+	m_groundMaterialIdx.push_back(-1);
+	m_groundColliderId.push_back(INVALID_ENTITYID);
+
+	// Anyone asking about this actor later this frame should see real values, not the defaults.
+	if (m_frameId == gEnv->nMainFrameID)
+		GatherEntry(uint32(m_entityIds.size() - 1));
+}
+
+
+void CActorPhysicsSnapshot::Unregister(EntityId entityId)
+{
+	auto it = m_entryLookup.find(entityId);
+	if (it == m_entryLookup.end())
+		return;
+
+	const uint32 entryIndex = it->second;
+	m_entryLookup.erase(it);
+	RemoveEntry(entryIndex);
+}
+
+
+bool CActorPhysicsSnapshot::GetActorPhysics(EntityId entityId, SActorPhysics& actorPhysics)
+{
+	auto it = m_entryLookup.find(entityId);
+	if (it == m_entryLookup.end())
+		return false;
+
+	Gather();
+
+	const uint32 i = it->second;
+	if (!(m_flags [i] & eSF_Valid))
+		return false;
+
+	actorPhysics.velocity = m_velocity [i];
+	actorPhysics.velocityUnconstrained = m_velocityUnconstrained [i];
+	actorPhysics.angVelocity = m_angVelocity [i];
+	actorPhysics.gravity = m_gravity [i];
+	actorPhysics.groundNormal = m_groundNormal [i];
+	actorPhysics.groundHeight = m_groundHeight [i];
+	actorPhysics.mass = m_mass [i];
+	actorPhysics.groundMaterialIdx = m_groundMaterialIdx [i];
+	actorPhysics.groundColliderId = m_groundColliderId [i];
+	actorPhysics.flags.SetFlags(SActorPhysics::EActorPhysicsFlags::Flying, (m_flags [i] & eSF_Flying) != 0);
+	actorPhysics.flags.SetFlags(SActorPhysics::EActorPhysicsFlags::Stuck, (m_flags [i] & eSF_Stuck) != 0);
+
+	return true;
+}
+
+
+void CActorPhysicsSnapshot::Gather()
+{
+	if (m_frameId == gEnv->nMainFrameID)
+		return;
+
+	m_frameId = gEnv->nMainFrameID;
+
+	for (uint32 i = 0, count = uint32(m_entityIds.size()); i < count; ++i)
+		GatherEntry(i);
+}
+
+
+void CActorPhysicsSnapshot::Reset()
+{
+	m_entryLookup.clear();
+	m_entityIds.clear();
+	m_flags.clear();
+	m_velocity.clear();
+	m_velocityUnconstrained.clear();
+	m_angVelocity.clear();
+	m_gravity.clear();
+	m_groundNormal.clear();
+	m_groundHeight.clear();
+	m_mass.clear();
+	m_groundMaterialIdx.clear();
+	m_groundColliderId.clear();
+	m_frameId = -1;
+}
+
+
+void CActorPhysicsSnapshot::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddObject(m_entryLookup);
+	pSizer->AddContainer(m_entityIds);
+	pSizer->AddContainer(m_flags);
+	pSizer->AddContainer(m_velocity);
+	pSizer->AddContainer(m_velocityUnconstrained);
+	pSizer->AddContainer(m_angVelocity);
+	pSizer->AddContainer(m_gravity);
+	pSizer->AddContainer(m_groundNormal);
+	pSizer->AddContainer(m_groundHeight);
+	pSizer->AddContainer(m_mass);
+	pSizer->AddContainer(m_groundMaterialIdx);
+	pSizer->AddContainer(m_groundColliderId);
+}
+
+
+void CActorPhysicsSnapshot::GatherEntry(uint32 entryIndex)
+{
+	m_flags [entryIndex] = 0;
+
+	IEntity* pEntity = gEnv->pEntitySystem->GetEntity(m_entityIds [entryIndex]);
+	IPhysicalEntity* pPhysEnt = pEntity ? pEntity->GetPhysics() : nullptr;
+	if (!pPhysEnt)
+		return;
+
+	pe_status_living livStat;
+	if (pPhysEnt->GetStatus(&livStat) == 0)
+		return;
+
+	uint32 flags = eSF_Valid;
+	if (livStat.bFlying)
+		flags |= eSF_Flying;
+	if (livStat.bStuck)
+		flags |= eSF_Stuck;
+	m_flags [entryIndex] = flags;
+
+	m_velocity [entryIndex] = livStat.vel - livStat.velGround;
+	m_velocityUnconstrained [entryIndex] = livStat.velUnconstrained;
+	m_groundNormal [entryIndex] = livStat.groundSlope;
+	m_groundHeight [entryIndex] = livStat.groundHeight;
+	m_groundMaterialIdx [entryIndex] = (livStat.groundSurfaceIdxAux > 0) ? livStat.groundSurfaceIdxAux : livStat.groundSurfaceIdx;
+
+	IEntity* pGroundEntity = livStat.pGroundCollider ? gEnv->pEntitySystem->GetEntityFromPhysics(livStat.pGroundCollider) : nullptr;
+	m_groundColliderId [entryIndex] = pGroundEntity ? pGroundEntity->GetId() : INVALID_ENTITYID;
+
+	pe_status_dynamics dynStat;
+	if (pPhysEnt->GetStatus(&dynStat) != 0)
+	{
+		m_angVelocity [entryIndex] = dynStat.w;
+		m_mass [entryIndex] = dynStat.mass;
+	}
+
+	pe_player_dynamics simPar;
+	if (pPhysEnt->GetParams(&simPar) != 0)
+		m_gravity [entryIndex] = simPar.gravity;
+}
+
+
+void CActorPhysicsSnapshot::RemoveEntry(uint32 entryIndex)
+{
+	const uint32 lastIndex = uint32(m_entityIds.size() - 1);
+
+	if (entryIndex != lastIndex)
+	{
+		m_entityIds [entryIndex] = m_entityIds [lastIndex];
+		m_flags [entryIndex] = m_flags [lastIndex];
+		m_velocity [entryIndex] = m_velocity [lastIndex];
+		m_velocityUnconstrained [entryIndex] = m_velocityUnconstrained [lastIndex];
+		m_angVelocity [entryIndex] = m_angVelocity [lastIndex];
+		m_gravity [entryIndex] = m_gravity [lastIndex];
+		m_groundNormal [entryIndex] = m_groundNormal [lastIndex];
+		m_groundHeight [entryIndex] = m_groundHeight [lastIndex];
+		m_mass [entryIndex] = m_mass [lastIndex];
+		m_groundMaterialIdx [entryIndex] = m_groundMaterialIdx [lastIndex];
+		m_groundColliderId [entryIndex] = m_groundColliderId [lastIndex];
+
+		m_entryLookup [m_entityIds [entryIndex]] = entryIndex;
+	}
+
+	m_entityIds.pop_back();
+	m_flags.pop_back();
+	m_velocity.pop_back();
+	m_velocityUnconstrained.pop_back();
+	m_angVelocity.pop_back();
+	m_gravity.pop_back();
+	m_groundNormal.pop_back();
+	m_groundHeight.pop_back();
+	m_mass.pop_back();
+	m_groundMaterialIdx.pop_back();
+	m_groundColliderId.pop_back();
+}
+}
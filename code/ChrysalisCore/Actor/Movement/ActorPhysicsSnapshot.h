@@ -0,0 +1,100 @@
+/**
+\file	Actor\Movement\ActorPhysicsSnapshot.h
+
+A once per frame snapshot of the physics state for every actor controller. The movement states used to query the living
+entity for its status whenever they wanted to know something, which meant several calls into the physics system for each
+actor, each frame, and each state saw the physics at a slightly different point in the frame.
+
+Now the first request in a frame gathers the living status, dynamics status and player dynamics for every registered actor
+in a single pass. The results are stored as a structure of arrays, so the pass only ever writes sequentially, and every
+state reads the same values for the rest of the frame.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+struct SActorPhysics;
+
+
+class CActorPhysicsSnapshot
+{
+public:
+	CActorPhysicsSnapshot();
+	virtual ~CActorPhysicsSnapshot();
+
+
+	/**
+	Adds an actor to the snapshot. It will be gathered along with the others from the next frame on.
+
+	\param	entityId Identifier for the actor's entity.
+	**/
+	void Register(EntityId entityId);
+
+
+	/**
+	Removes an actor from the snapshot.
+
+	\param	entityId Identifier for the actor's entity.
+	**/
+	void Unregister(EntityId entityId);
+
+
+	/**
+	Gets the physics state of an actor for the current frame, gathering the state for every actor if this is the first
+	request this frame. Only the values which come straight from physics are written. Values which are accumulated over
+	several frames, such as the velocity delta, are left to the caller.
+
+	\param 		   	entityId	 Identifier for the actor's entity.
+	\param [in,out]	actorPhysics The physics state for the actor.
+
+	\return False if the actor isn't registered or has no living physics, in which case actorPhysics is left untouched.
+	**/
+	bool GetActorPhysics(EntityId entityId, SActorPhysics& actorPhysics);
+
+
+	/** Gathers the physics state for every actor, unless that has already been done this frame. */
+	void Gather();
+
+
+	/** Removes every actor. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+private:
+	enum ESnapshotFlags
+	{
+		/** Physics returned a living status for the actor. Nothing else in the snapshot is meaningful without this. */
+		eSF_Valid = BIT(0),
+		eSF_Flying = BIT(1),
+		eSF_Stuck = BIT(2)
+	};
+
+	/** Gathers the physics state for a single actor. */
+	void GatherEntry(uint32 entryIndex);
+
+	/** Swaps the last entry into the place of an entry which is being removed, keeping all the arrays packed. */
+	void RemoveEntry(uint32 entryIndex);
+
+	/** Frame on which the snapshot was last gathered. */
+	int m_frameId { -1 };
+
+	/** Index of each actor into the arrays. */
+	std::unordered_map<EntityId, uint32> m_entryLookup;
+
+	// The snapshot for each actor, one array for each value. Every array has the same length.
+	std::vector<EntityId> m_entityIds;
+	std::vector<uint32> m_flags;
+	std::vector<Vec3> m_velocity;
+	std::vector<Vec3> m_velocityUnconstrained;
+	std::vector<Vec3> m_angVelocity;
+	std::vector<Vec3> m_gravity;
+	std::vector<Vec3> m_groundNormal;
+	std::vector<float> m_groundHeight;
+	std::vector<float> m_mass;
+	std::vector<int> m_groundMaterialIdx;
+	std::vector<EntityId> m_groundColliderId;
+};
+}
@@ -6,6 +6,8 @@
 #include "ActorStateFly.h"
 #include <Actor/ActorControllerComponent.h>
 #include <Actor/Movement/StateMachine/ActorStateUtility.h>
+#include <Actor/Movement/ActorPhysicsSnapshot.h>
+#include "Plugin/ChrysalisCorePlugin.h"
 //#include "CharacterInput.h"
 
 
@@ -90,15 +92,13 @@ void CActorStateFly::OnExit(CActorControllerComponent& actorControllerComponent)
 {
 	//	actorControllerComponent.CreateScriptEvent("printhud", 0, "FlyMode/NoClip OFF");
 
-	pe_player_dynamics simPar;
-
-	IPhysicalEntity* piPhysics = actorControllerComponent.GetEntity()->GetPhysics();
-	if (!piPhysics || piPhysics->GetParams(&simPar) == 0)
+	SActorPhysics actorPhysics;
+	if (!CChrysalisCorePlugin::Get()->GetActorPhysicsSnapshot()->GetActorPhysics(actorControllerComponent.GetEntityId(), actorPhysics))
 	{
 		return;
 	}
 
-	CActorStateUtility::PhySetNoFly(actorControllerComponent, simPar.gravity);
+	CActorStateUtility::PhySetNoFly(actorControllerComponent, actorPhysics.gravity);
 }
 
 
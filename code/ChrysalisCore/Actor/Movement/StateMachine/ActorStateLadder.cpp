@@ -2,8 +2,11 @@
 
 #include "ActorStateLadder.h"
 #include <Actor/Animation/ActorAnimation.h>
+#include <Actor/Animation/Actions/ActorAnimationActionPool.h>
 #include <Actor/ActorControllerComponent.h>
 #include <Actor/Movement/StateMachine/ActorStateUtility.h>
+#include <Actor/Movement/ActorPhysicsSnapshot.h>
+#include "Plugin/ChrysalisCorePlugin.h"
 #include <Entities/EntityScriptCalls.h>
 #include "ActorStateEvents.h"
 #include <Console/CVars.h>
@@ -163,6 +166,7 @@ class CActionLadderGetOn : public CLadderAction
 {
 public:
 	DEFINE_ACTION("LadderGetOn");
+	DECLARE_POOLED_ACTION(CActionLadderGetOn);
 
 	CActionLadderGetOn(CActorStateLadder * ladderState, CActorControllerComponent& actorControllerComponent, CActorStateLadder::ELadderAnimType animType) :
 		CLadderAction(ladderState, actorControllerComponent, g_actorMannequinParams.fragmentIDs.LadderGetOn, animType, "cameraAnimFraction_getOn", "cameraAnimFraction_onLadder")
@@ -208,6 +212,7 @@ class CActionLadderGetOff : public CLadderAction
 {
 public:
 	DEFINE_ACTION("LadderGetOff");
+	DECLARE_POOLED_ACTION(CActionLadderGetOff);
 
 	CActionLadderGetOff(CActorStateLadder * ladderState, CActorControllerComponent& actorControllerComponent, CActorStateLadder::ELadderAnimType animType) :
 		CLadderAction(ladderState, actorControllerComponent, g_actorMannequinParams.fragmentIDs.LadderGetOff, animType, "cameraAnimFraction_onLadder", "cameraAnimFraction_getOff")
@@ -259,6 +264,7 @@ class CActionLadderClimbUpDown : public CLadderAction
 {
 public:
 	DEFINE_ACTION("LadderClimbUpDown");
+	DECLARE_POOLED_ACTION(CActionLadderClimbUpDown);
 
 	CActionLadderClimbUpDown(CActorStateLadder* ladderState, CActorControllerComponent& actorControllerComponent) :
 		CLadderAction(ladderState, actorControllerComponent, g_actorMannequinParams.fragmentIDs.LadderClimb, CActorStateLadder::kLadderAnimType_upLoop, "cameraAnimFraction_onLadder", "cameraAnimFraction_onLadder")
@@ -498,16 +504,14 @@ void CActorStateLadder::OnExit(CActorControllerComponent& actorControllerCompone
 
 	actorControllerComponent.GetActorParams ().viewLimits.ClearViewLimit (SViewLimitParams::eVLS_Ladder);
 
-	pe_player_dynamics simPar;
-
-	IPhysicalEntity* piPhysics = actorControllerComponent.GetEntity ()->GetPhysics ();
-	if (!piPhysics || piPhysics->GetParams (&simPar) == 0)
+	SActorPhysics actorPhysics;
+	if (!CChrysalisCorePlugin::Get ()->GetActorPhysicsSnapshot ()->GetActorPhysics (actorControllerComponent.GetEntityId (), actorPhysics))
 	{
 	return;
 	}
 
 	IAnimatedCharacter* pAnimChar = actorControllerComponent.GetAnimatedCharacter ();
-	CActorStateUtility::PhySetNoFly (actorControllerComponent, simPar.gravity);
+	CActorStateUtility::PhySetNoFly (actorControllerComponent, actorPhysics.gravity);
 	CActorStateUtility::CancelCrouchAndProneInputs (actorControllerComponent);
 
 	InterruptCurrentAnimation ();
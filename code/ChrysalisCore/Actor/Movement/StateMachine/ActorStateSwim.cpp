@@ -3,6 +3,8 @@
 #include "ActorStateSwim.h"
 #include <Actor/ActorControllerComponent.h>
 #include <Actor/Movement/StateMachine/ActorStateUtility.h>
+#include <Actor/Movement/ActorPhysicsSnapshot.h>
+#include "Plugin/ChrysalisCorePlugin.h"
 #include "ActorStateEvents.h"
 #include "ActorStateJump.h"
 /*#include "LocalCharacterComponent.h"
@@ -276,10 +278,10 @@ void CActorStateSwim::OnEnter(CActorControllerComponent& actorControllerComponen
 	if (pPhysEnt != NULL)
 	{
 	// get current gravity before setting to zero.
-	pe_player_dynamics simPar;
-	if (pPhysEnt->GetParams (&simPar) != 0)
+	SActorPhysics actorPhysics;
+	if (CChrysalisCorePlugin::Get ()->GetActorPhysicsSnapshot ()->GetActorPhysics (actorControllerComponent.GetEntityId (), actorPhysics))
 	{
-	m_gravity = simPar.gravity;
+	m_gravity = actorPhysics.gravity;
 	}
 	CActorStateUtility::PhySetFly (Character);
 	}
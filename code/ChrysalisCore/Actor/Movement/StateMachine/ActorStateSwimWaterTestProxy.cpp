@@ -2,8 +2,8 @@
 
 #include "ActorStateSwimWaterTestProxy.h"
 #include <Actor/ActorControllerComponent.h>
-#include <CryAction.h>
-#include <CryActionPhysicQueues.h>
+#include "Game/Physics/WaterLevelService.h"
+#include "Plugin/ChrysalisCorePlugin.h"
 
 
 namespace Chrysalis
@@ -18,7 +18,9 @@ CActorStateSwimWaterTestProxy::CActorStateSwimWaterTestProxy()
 	, m_bottomLevel(BOTTOM_LEVEL_UNKNOWN)
 	, m_relativeBottomLevel(0.0f)
 	, m_actorWaterLevel(-WATER_LEVEL_UNKNOWN)
-	, m_bottomLevelRayID(0)
+	, m_isWaitingForBottomLevel(false)
+	, m_bottomLevelProbePosition(ZERO)
+	, m_bottomLevelProbeDepth(0.0f)
 	, m_swimmingTimer(-1000.0f)
 	, m_timeWaterLevelLastUpdated(0.0f)
 	, m_headUnderwater(false)
@@ -40,7 +42,6 @@ void CActorStateSwimWaterTestProxy::Reset(bool bCancelRays)
 	if (bCancelRays)
 	{
 		CancelPendingRays();
-		m_bottomLevelRayID = (0);
 	}
 
 	m_lastInternalState = m_internalState = eProxyInternalState_OutOfWater;
@@ -66,7 +67,7 @@ void CActorStateSwimWaterTestProxy::OnEnterWater(const CActorControllerComponent
 	const Vec3 localReferencePos = GetLocalReferencePosition(actorControllerComponent);
 	const Vec3 worldReferencePos = CharacterWorldPos + (Quat(CharacterWorldTM) * localReferencePos);
 
-	m_waterLevel = gEnv->p3DEngine->GetWaterLevel(&worldReferencePos);
+	m_waterLevel = CChrysalisCorePlugin::Get()->GetWaterLevelService()->GetWaterLevel(worldReferencePos).level;
 	m_internalState = eProxyInternalState_Swimming;
 	m_swimmingTimer = 0.0f;
 
@@ -91,6 +92,9 @@ void CActorStateSwimWaterTestProxy::Update(const CActorControllerComponent& acto
 		m_shouldSwim = false;
 	}
 
+	// Pick up the bottom level, if the probe we asked for has come back.
+	PollBottomLevel();
+
 	float newSwimmingTimer = 0.0f;
 	switch (m_internalState)
 	{
@@ -165,9 +169,8 @@ void CActorStateSwimWaterTestProxy::UpdateOutOfWater(const CActorControllerCompo
 	if (lastCheckFarAwayEnough)
 	{
 		const Vec3 worldReferencePos = CharacterWorldPos + (Quat(CharacterWorldTM) * localReferencePos);
-		IPhysicalEntity* piPhysEntity = actorControllerComponent.GetEntity()->GetPhysics();
 
-		UpdateWaterLevel(worldReferencePos, CharacterWorldPos, piPhysEntity);
+		UpdateWaterLevel(worldReferencePos, CharacterWorldPos);
 	}
 
 	// Update submerged fraction.
@@ -190,13 +193,14 @@ void CActorStateSwimWaterTestProxy::UpdateInWater(const CActorControllerComponen
 		((m_lastWaterLevelCheckPosition - CharacterWorldPos).len2() >= sqr(0.35f)) ||
 		(m_lastInternalState != m_internalState && m_internalState == eProxyInternalState_PartiallySubmerged); //Just entered partially emerged state
 
-	if (shouldUpdate && !IsWaitingForBottomLevelResults())
+	if (shouldUpdate)
 	{
-		RayTestBottomLevel(actorControllerComponent, worldReferencePos, s_rayLength);
-
-		IPhysicalEntity* piPhysEntity = actorControllerComponent.GetEntity()->GetPhysics();
+		// The bottom probe can take a while to come back, or be lost and asked for again, but the water level is a cheap
+		// lookup, so don't let one hold up the other.
+		if (!IsWaitingForBottomLevelResults())
+			RayTestBottomLevel(actorControllerComponent, worldReferencePos, s_rayLength);
 
-		UpdateWaterLevel(worldReferencePos, CharacterWorldPos, piPhysEntity);
+		UpdateWaterLevel(worldReferencePos, CharacterWorldPos);
 
 		if (m_waterLevel > WATER_LEVEL_UNKNOWN)
 		{
@@ -303,64 +307,49 @@ Vec3 CActorStateSwimWaterTestProxy::GetLocalReferencePosition(const CActorContro
 }
 
 
-void CActorStateSwimWaterTestProxy::OnRayCastBottomLevelDataReceived(const QueuedRayID& rayID, const RayCastResult& result)
+void CActorStateSwimWaterTestProxy::RayTestBottomLevel(const CActorControllerComponent& actorControllerComponent, const Vec3& referencePosition, float maxRelevantDepth)
 {
-	CRY_ASSERT(m_bottomLevelRayID == rayID);
+	FUNCTION_PROFILER(gEnv->pSystem, PROFILE_GAME);
 
-	m_bottomLevelRayID = 0;
+	// We should not have entered this function if still waiting for the last result.
+	CRY_ASSERT(!m_isWaitingForBottomLevel);
 
-	if (result.hitCount > 0)
-	{
-		m_bottomLevel = m_lastRayCastResult = result.hits [0].pt.z;
-	}
-	else
-	{
-		m_bottomLevel = BOTTOM_LEVEL_UNKNOWN;
-	}
+	m_bottomLevelProbePosition = referencePosition;
+	m_bottomLevelProbeDepth = maxRelevantDepth;
+	m_isWaitingForBottomLevel = true;
+
+	// Someone may have already probed near here, in which case we have the answer straight away.
+	PollBottomLevel();
 }
 
 
-void CActorStateSwimWaterTestProxy::RayTestBottomLevel(const CActorControllerComponent& actorControllerComponent, const Vec3& referencePosition, float maxRelevantDepth)
+void CActorStateSwimWaterTestProxy::PollBottomLevel()
 {
-	/*	FUNCTION_PROFILER (gEnv->pSystem, PROFILE_GAME);
-
-		const float terrainWorldZ = gEnv->p3DEngine->GetTerrainElevation (referencePosition.x, referencePosition.y);
-
-		int rayFlags = geom_colltype_Character << rwi_colltype_bit | rwi_stop_at_pierceable;
-		int entityFlags = ent_terrain | ent_static | ent_sleeping_rigid | ent_rigid;
-		const float padding = 0.2f;
-
-		// NOTE: Terrain is above m_referencePos, so m_referencePos is probably inside a voxel or something.
-		const float fPosWorldDiff = referencePosition.z - terrainWorldZ;
-		float rayLength = (float) __fsel (fPosWorldDiff, min (maxRelevantDepth, fPosWorldDiff), maxRelevantDepth) + (padding * 2.0f);
+	if (!m_isWaitingForBottomLevel)
+		return;
 
-		// We should not have entered this function if still waiting for the last result
-		CRY_ASSERT (m_bottomLevelRayID == 0);
+	float bottomLevel = BOTTOM_LEVEL_UNKNOWN;
+	if (CChrysalisCorePlugin::Get()->GetWaterLevelService()->GetBottomLevel(m_bottomLevelProbePosition, m_bottomLevelProbeDepth, bottomLevel))
+	{
+		m_isWaitingForBottomLevel = false;
+		m_bottomLevel = bottomLevel;
 
-		m_bottomLevelRayID = CCryAction::GetCryAction()->GetPhysicQueues().GetRayCaster().Queue (
-		actorControllerComponent.IsClient () ? RayCastRequest::HighPriority : RayCastRequest::MediumPriority,
-		RayCastRequest (referencePosition + Vec3 (0, 0, padding), Vec3 (0, 0, -rayLength),
-		entityFlags,
-		rayFlags,
-		0,
-		0),
-		functor (*this, &CActorStateSwimWaterTestProxy::OnRayCastBottomLevelDataReceived));*/
+		if (bottomLevel > BOTTOM_LEVEL_UNKNOWN)
+			m_lastRayCastResult = bottomLevel;
+	}
 }
 
 
 void CActorStateSwimWaterTestProxy::CancelPendingRays()
 {
-	/*	if (m_bottomLevelRayID != 0)
-		{
-			CCryAction::GetCryAction()->GetPhysicQueues().GetRayCaster().Cancel (m_bottomLevelRayID);
-		}
-		m_bottomLevelRayID = 0;*/
+	// The probe is owned by the water level service, and will still be cached for whoever asks next.
+	m_isWaitingForBottomLevel = false;
 }
 
 
-void CActorStateSwimWaterTestProxy::UpdateWaterLevel(const Vec3& worldReferencePos, const Vec3& CharacterWorldPos, IPhysicalEntity* piPhysEntity)
+void CActorStateSwimWaterTestProxy::UpdateWaterLevel(const Vec3& worldReferencePos, const Vec3& CharacterWorldPos)
 {
-	m_waterLevel = gEnv->p3DEngine->GetWaterLevel(&worldReferencePos, piPhysEntity);
+	m_waterLevel = CChrysalisCorePlugin::Get()->GetWaterLevelService()->GetWaterLevel(worldReferencePos).level;
 	m_timeWaterLevelLastUpdated = gEnv->pTimer->GetCurrTime();
 	m_lastWaterLevelCheckPosition = CharacterWorldPos;
 }
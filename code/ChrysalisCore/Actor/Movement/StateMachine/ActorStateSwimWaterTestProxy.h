@@ -1,7 +1,5 @@
 #pragma once
 
-#include <CryPhysics/RayCastQueue.h>
-
 
 namespace Chrysalis
 {
@@ -48,7 +46,7 @@ public:
 	ILINE static float GetRayLength() { return s_rayLength; }
 
 private:
-	void UpdateWaterLevel(const Vec3& worldReferencePos, const Vec3& CharacterWorldPos, IPhysicalEntity* piPhysEntity);
+	void UpdateWaterLevel(const Vec3& worldReferencePos, const Vec3& CharacterWorldPos);
 	void UpdateOutOfWater(const CActorControllerComponent& actorControllerComponent, const float frameTime);
 	void UpdateInWater(const CActorControllerComponent& actorControllerComponent, const float frameTime);
 	void UpdateSubmergedFraction(const float referenceHeight, const float CharacterHeight, const float waterLevel);
@@ -56,10 +54,10 @@ private:
 	static Vec3 GetLocalReferencePosition(const CActorControllerComponent& actorControllerComponent);
 	bool ShouldSwim(const float referenceHeight) const;
 
-	// Deferred raycast functions.
-	void OnRayCastBottomLevelDataReceived(const QueuedRayID& rayID, const RayCastResult& result);
-	ILINE bool IsWaitingForBottomLevelResults() const { return (m_bottomLevelRayID != 0); }
+	// Deferred bottom level probes, which are queued and cached by the water level service.
+	ILINE bool IsWaitingForBottomLevelResults() const { return m_isWaitingForBottomLevel; }
 	void RayTestBottomLevel(const CActorControllerComponent& actorControllerComponent, const Vec3& referencePosition, float maxRelevantDepth);
+	void PollBottomLevel();
 	void CancelPendingRays();
 
 	// Debug
@@ -81,7 +79,9 @@ private:
 	bool m_headUnderwater;
 	bool m_headComingOutOfWater;
 	bool m_shouldSwim;
-	QueuedRayID m_bottomLevelRayID;
+	bool m_isWaitingForBottomLevel;
+	Vec3 m_bottomLevelProbePosition;
+	float m_bottomLevelProbeDepth;
 	static float s_rayLength;
 };
 }
\ No newline at end of file
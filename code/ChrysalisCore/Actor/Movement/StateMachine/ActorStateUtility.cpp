@@ -3,6 +3,8 @@
 #include <Actor/Movement/StateMachine/ActorStateUtility.h>
 #include <Actor/Movement/StateMachine/ActorStateJump.h>
 #include <Actor/ActorControllerComponent.h>
+#include <Actor/Movement/ActorPhysicsSnapshot.h>
+#include "Plugin/ChrysalisCorePlugin.h"
 /*
 #include <IItem.h>
 #include <IAnimatedCharacter.h>
@@ -89,16 +91,6 @@ bool CActorStateUtility::IsOnGround(CActorControllerComponent& actorControllerCo
 }
 
 
-bool CActorStateUtility::GetPhysicsLivingStatus(const CActorControllerComponent& actorControllerComponent, pe_status_living* physicsStatus)
-{
-	IPhysicalEntity *pPhysEnt = actorControllerComponent.GetEntity()->GetPhysics();
-	if (pPhysEnt)
-		return(pPhysEnt->GetStatus(physicsStatus) > 0);
-
-	return false;
-}
-
-
 void CActorStateUtility::AdjustMovementForEnvironment(const CActorControllerComponent& actorControllerComponent, Vec3& move, const bool bigWeaponRestrict, const bool crouching)
 {
 	/*	float mult = (bigWeaponRestrict)
@@ -252,123 +244,31 @@ void CActorStateUtility::RestorePhysics(CActorControllerComponent& actorControll
 
 void CActorStateUtility::UpdatePhysicsState(CActorControllerComponent& actorControllerComponent, SActorPhysics& actorPhysics, float frameTime)
 {
-	/*const int currentFrameID = gEnv->pRenderer->GetFrameID();
+	const int currentFrameID = gEnv->nMainFrameID;
 
 	if (actorPhysics.lastFrameUpdate < currentFrameID)
 	{
-		pe_status_living livStat;
-		if (!CActorStateUtility::GetPhysicsLivingStatus(actorControllerComponent, &livStat))
-		{
-			return;
-		}
-
-		SActorStats& stats = *actorControllerComponent.GetActorState();
-
-		const Vec3 newVelocity = livStat.vel - livStat.velGround;
-		actorPhysics.velocityDelta = newVelocity - actorPhysics.velocity;
-		actorPhysics.velocity = newVelocity;
-		actorPhysics.velocityUnconstrainedLast = actorPhysics.velocityUnconstrained;
-		actorPhysics.velocityUnconstrained = livStat.velUnconstrained;
-		actorPhysics.flags.SetFlags(SActorPhysics:WasFlying, actorPhysics.flags.AreAnyFlagsActive(SActorPhysics::EActorPhysicsFlags::Flying));
-		actorPhysics.flags.SetFlags(SActorPhysics::EActorPhysicsFlags::Flying, livStat.bFlying > 0);
-		actorPhysics.flags.SetFlags(SActorPhysics::EActorPhysicsFlags::Stuck, livStat.bStuck > 0);
-
-		Vec3 flatVel(actorControllerComponent.m_pCharacterRotation->GetBaseQuat().GetInverted()*newVelocity);
-		flatVel.z = 0;
-		stats.speedFlat = flatVel.len();
+		// The snapshot only holds this frame's values, so keep what we need from the last frame before they are overwritten.
+		const Vec3 lastVelocity = actorPhysics.velocity;
+		const Vec3 lastVelocityUnconstrained = actorPhysics.velocityUnconstrained;
+		const Vec3 lastGroundNormal = actorPhysics.groundNormal;
+		const bool wasFlying = actorPhysics.flags.AreAnyFlagsActive(SActorPhysics::EActorPhysicsFlags::Flying);
 
-		if (actorControllerComponent.IsInAir())
+		if (!CChrysalisCorePlugin::Get()->GetActorPhysicsSnapshot()->GetActorPhysics(actorControllerComponent.GetEntityId(), actorPhysics))
 		{
-			stats.maxAirSpeed = max(stats.maxAirSpeed, newVelocity.GetLengthFast());
-		}
-		else
-		{
-			stats.maxAirSpeed = 0.f;
+			return;
 		}
-		float fSpeedFlatSelector = stats.speedFlat - 0.1f;
 
+		actorPhysics.velocityDelta = actorPhysics.velocity - lastVelocity;
+		actorPhysics.velocityUnconstrainedLast = lastVelocityUnconstrained;
+		actorPhysics.flags.SetFlags(SActorPhysics::EActorPhysicsFlags::WasFlying, wasFlying);
+		actorPhysics.speed = actorPhysics.velocity.GetLength();
 
 		const float groundNormalBlend = clamp_tpl(frameTime * 6.666f, 0.0f, 1.0f);
-		actorPhysics.groundNormal = LERP(actorPhysics.groundNormal, livStat.groundSlope, groundNormalBlend);
-
-		if (livStat.groundSurfaceIdxAux > 0)
-			actorPhysics.groundMaterialIdx = livStat.groundSurfaceIdxAux;
-		else
-			actorPhysics.groundMaterialIdx = livStat.groundSurfaceIdx;
-
-		actorPhysics.groundHeight = livStat.groundHeight;
-
-		EntityId newGroundColliderId = 0;
-		if (livStat.pGroundCollider)
-		{
-			IEntity* pEntity = gEnv->pEntitySystem->GetEntityFromPhysics(livStat.pGroundCollider);
-			newGroundColliderId = pEntity ? pEntity->GetId() : 0;
-		}
-
-		if (newGroundColliderId != actorPhysics.groundColliderId)
-		{
-			if (actorPhysics.groundColliderId)
-			{
-				if (IGameObject* pGameObject = gEnv->pGameFramework->GetGameObject(actorPhysics.groundColliderId))
-				{
-					SGameObjectEvent event(eGFE_StoodOnChange, eGOEF_ToExtensions);
-					event.ptr = &actorControllerComponent;
-					event.paramAsBool = false;
-					pGameObject->SendEvent(event);
-				}
-			}
-
-			if (newGroundColliderId)
-			{
-				if (IGameObject* pGameObject = gEnv->pGameFramework->GetGameObject(newGroundColliderId))
-				{
-					SGameObjectEvent event(eGFE_StoodOnChange, eGOEF_ToExtensions);
-					event.ptr = &actorControllerComponent;
-					event.paramAsBool = true;
-					pGameObject->SendEvent(event);
-				}
-			}
-
-			actorPhysics.groundColliderId = newGroundColliderId;
-		}
-
-		IPhysicalEntity *pPhysEnt = actorControllerComponent.GetEntity()->GetPhysics();
-		if (pPhysEnt)
-		{
-			pe_status_dynamics dynStat;
-			pPhysEnt->GetStatus(&dynStat);
-
-			actorPhysics.angVelocity = dynStat.w;
-			actorPhysics.mass = dynStat.mass;
-
-			pe_player_dynamics simPar;
-			if (pPhysEnt->GetParams(&simPar) != 0)
-			{
-				actorPhysics.gravity = simPar.gravity;
-			}
-		}
+		actorPhysics.groundNormal = LERP(lastGroundNormal, actorPhysics.groundNormal, groundNormalBlend);
 
 		actorPhysics.lastFrameUpdate = currentFrameID;
-
-#ifdef CHARACTER_MOVEMENT_DEBUG_ENABLED
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVelo", livStat.vel.GetLength());
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloX", livStat.vel.x);
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloY", livStat.vel.y);
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloZ", livStat.vel.z);
-
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloUn", livStat.velUnconstrained.GetLength());
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloUnX", livStat.velUnconstrained.x);
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloUnY", livStat.velUnconstrained.y);
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVeloUnZ", livStat.velUnconstrained.z);
-
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVelReq", livStat.velRequested.GetLength());
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVelReqX", livStat.velRequested.x);
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVelReqY", livStat.velRequested.y);
-		actorControllerComponent.GetMovementDebug().DebugGraph_AddValue("PhysVelReqZ", livStat.velRequested.z);
-
-		actorControllerComponent.GetMovementDebug().LogVelocityStats(actorControllerComponent.GetEntity(), livStat, stats.downwardsImpactVelocity, stats.fallSpeed);
-#endif
-	}*/
+	}
 }
 
 
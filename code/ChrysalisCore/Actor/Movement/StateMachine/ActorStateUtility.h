@@ -1,7 +1,5 @@
 #pragma once
 
-struct pe_status_living;
-
 
 namespace Chrysalis
 {
@@ -49,7 +47,7 @@ public:
 	// #TODO: only used in actorControllerComponent state ground machine.
 	static void RestorePhysics(CActorControllerComponent& actorControllerComponent);
 
-	// #TODO: only used in character.cpp and function unknown at present.
+	// Brings the actor's physics state up to date from this frame's physics snapshot.
 	static void UpdatePhysicsState(CActorControllerComponent& actorControllerComponent, SActorPhysics& actorPhysics, float frameTime);
 
 	// #TODO: Move this to the ladder state machine.
@@ -62,17 +60,6 @@ private:
 	CActorStateUtility(const CActorStateUtility&);
 
 
-	/**
-	Queries the physics engine for the actorControllerComponent's physics state.
-	
-	\param 		   	actorControllerComponent The actorControllerComponent.
-	\param [in,out]	physicsStatus  If non-null, the physics state for this living entity.
-	
-	\return true if it succeeds, false if it fails.
-	**/
-	static bool GetPhysicsLivingStatus(const CActorControllerComponent& actorControllerComponent, pe_status_living* physicsStatus);
-
-
 	/**
 	Player movement is subjected to restrictions, based on the current environmental factors, such as terrain, game
 	modes, heavy weapons, items being carried.
@@ -121,13 +121,10 @@ void CProceduralContextAim::UpdatePolarCoordinatesSmoothingParameters()
 	Vec2 polarCoordinatesMaxSmoothRateRadiansPerSecond = m_defaultPolarCoordinatesMaxSmoothRateRadiansPerSecond;
 	float polarCoordinatesSmoothTimeSeconds = m_defaultPolarCoordinatesSmoothTimeSeconds;
 
-	const size_t requestCount = m_polarCoordinatesSmoothingParametersRequestList.GetCount();
-	if (0 < requestCount)
+	if (const SPolarCoordinatesSmoothingParametersRequest* pRequest = m_polarCoordinatesSmoothingParametersRequestList.GetMostRecentRequest())
 	{
-		const SPolarCoordinatesSmoothingParametersRequest& request = m_polarCoordinatesSmoothingParametersRequestList.GetRequest(requestCount - 1);
-
-		polarCoordinatesMaxSmoothRateRadiansPerSecond = request.maxSmoothRateRadiansPerSecond;
-		polarCoordinatesSmoothTimeSeconds = request.smoothTimeSeconds;
+		polarCoordinatesMaxSmoothRateRadiansPerSecond = pRequest->maxSmoothRateRadiansPerSecond;
+		polarCoordinatesSmoothTimeSeconds = pRequest->smoothTimeSeconds;
 	}
 
 	m_pPoseBlenderAim->SetPolarCoordinatesMaxRadiansPerSecond(polarCoordinatesMaxSmoothRateRadiansPerSecond);
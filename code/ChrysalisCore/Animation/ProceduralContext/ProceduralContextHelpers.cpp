@@ -0,0 +1,157 @@
+#include <StdAfx.h>
+
+#include "ProceduralContextHelpers.h"
+
+
+namespace Chrysalis
+{
+namespace ProceduralContextHelpers
+{
+namespace
+{
+struct STestRequest
+{
+	uint32 id;
+	int value;
+};
+
+
+typedef CRequestList<STestRequest> TTestRequestList;
+
+
+uint32 AddTestRequest(TTestRequestList& requestList, int value)
+{
+	STestRequest request;
+	request.value = value;
+
+	return requestList.AddRequest(request);
+}
+
+
+/** The value of the most recent request, or -1 if there isn't one. */
+int GetMostRecentValue(const TTestRequestList& requestList)
+{
+	const STestRequest* pRequest = requestList.GetMostRecentRequest();
+	return pRequest ? pRequest->value : -1;
+}
+
+
+bool Check(bool condition, const char* description, int& failures)
+{
+	if (!condition)
+	{
+		CryLogAlways("Request list self test FAILED: %s", description);
+		failures++;
+	}
+
+	return condition;
+}
+}
+
+
+bool RunRequestListSelfTest()
+{
+	int failures = 0;
+
+	// The most recent request wins, and falls back to the one before it once removed.
+	{
+		TTestRequestList requestList;
+		Check(requestList.GetMostRecentRequest() == nullptr, "an empty list has no most recent request", failures);
+
+		const uint32 first = AddTestRequest(requestList, 1);
+		const uint32 second = AddTestRequest(requestList, 2);
+		Check((first != TTestRequestList::InvalidRequestId) && (second != TTestRequestList::InvalidRequestId), "identifiers are never invalid", failures);
+		Check(GetMostRecentValue(requestList) == 2, "the newest request wins", failures);
+
+		requestList.RemoveRequest(second);
+		Check(GetMostRecentValue(requestList) == 1, "removing the newest request falls back to the one before", failures);
+
+		requestList.RemoveRequest(first);
+		Check(requestList.GetCount() == 0, "the list is empty once every request is removed", failures);
+		Check(requestList.GetMostRecentRequest() == nullptr, "an emptied list has no most recent request", failures);
+	}
+
+	// A stale identifier must not remove the request which has since reused its slot.
+	{
+		TTestRequestList requestList;
+		const uint32 stale = AddTestRequest(requestList, 1);
+		requestList.RemoveRequest(stale);
+
+		const uint32 reused = AddTestRequest(requestList, 2);
+		Check(reused != stale, "a reused slot gets a new identifier", failures);
+
+		requestList.RemoveRequest(stale);
+		Check(requestList.GetCount() == 1, "a stale identifier doesn't remove the new request", failures);
+		Check(GetMostRecentValue(requestList) == 2, "the new request survives a stale removal", failures);
+
+		requestList.RemoveRequest(reused);
+		requestList.RemoveRequest(reused);
+		Check(requestList.GetCount() == 0, "removing a request twice is harmless", failures);
+	}
+
+	// Removing from the middle keeps the order of the rest.
+	{
+		TTestRequestList requestList;
+		uint32 ids [5];
+		for (int i = 0; i < 5; ++i)
+			ids [i] = AddTestRequest(requestList, i);
+
+		requestList.RemoveRequest(ids [1]);
+		requestList.RemoveRequest(ids [3]);
+
+		int expected [] = { 0, 2, 4 };
+		int index = 0;
+		bool isInOrder = true;
+		requestList.ForEachRequest([&](const STestRequest& request)
+		{
+			isInOrder &= (index < int(CRY_ARRAY_COUNT(expected))) && (request.value == expected [index]);
+			index++;
+		});
+		Check(isInOrder && (index == 3), "the remaining requests keep the order they were added in", failures);
+	}
+
+	// Churn through the slots the way proc clips do, pushing and popping a few requests each frame, and make sure no
+	// identifier is handed out while an earlier request with the same identifier is still live.
+	{
+		TTestRequestList requestList;
+		std::vector<uint32> live;
+		uint32 seed = 12345;
+		bool isUnique = true;
+		bool isCountCorrect = true;
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			if (live.empty() || ((seed >> 16) & 1) || (live.size() < 4))
+			{
+				const uint32 id = AddTestRequest(requestList, i);
+				isUnique &= std::find(live.begin(), live.end(), id) == live.end();
+				live.push_back(id);
+			}
+			else
+			{
+				const size_t index = (seed >> 8) % live.size();
+				requestList.RemoveRequest(live [index]);
+				live [index] = live.back();
+				live.pop_back();
+			}
+
+			if (live.size() > 32)
+			{
+				requestList.RemoveRequest(live.front());
+				live.erase(live.begin());
+			}
+
+			isCountCorrect &= requestList.GetCount() == live.size();
+		}
+
+		Check(isUnique, "live identifiers are unique through heavy reuse", failures);
+		Check(isCountCorrect, "the count matches the live requests through heavy reuse", failures);
+	}
+
+	CryLogAlways("Request list self test %s with %d failures.", (failures == 0) ? "passed" : "FAILED", failures);
+
+	return failures == 0;
+}
+}
+}
@@ -4,50 +4,173 @@ namespace Chrysalis
 {
 namespace ProceduralContextHelpers
 {
+/**
+A list of requests made to a procedural context, where the most recent request usually wins.
+
+Requests live in slots which are recycled through a free list, so adding and removing a request never searches or moves
+the other requests. The slots in use are also threaded onto a list in the order they were added, which makes the most
+recent request available without a scan.
+
+Each request is identified by a handle which combines the slot index with a generation count for the slot. The
+generation is bumped each time a slot is freed, so a handle to a request which has already been removed will never
+match the next request to use that slot, and removing it a second time is harmless.
+**/
 template< typename TRequestType >
 class CRequestList
 {
-	typedef std::vector< TRequestType > TRequestsVector;
-
 public:
+	/** Never handed out as a request identifier. */
+	static const uint32 InvalidRequestId { 0 };
+
+
+	/**
+	Adds a request, making it the most recent.
+
+	\param [in,out]	request The request. Its id is set to the identifier for the request.
+
+	\return An identifier for the request, used to remove it later.
+	**/
 	uint32 AddRequest(TRequestType& request)
 	{
-		request.id = m_nextId;
-		m_requests.push_back(request);
+		uint32 slotIndex = m_freeHead;
+		if (slotIndex != InvalidIndex)
+		{
+			m_freeHead = m_slots [slotIndex].next;
+		}
+		else
+		{
+			// Handles keep the slot index in their lower bits, which limits how many requests can be in flight at once.
+			CRY_ASSERT(m_slots.size() < slotIndexMask);
+			slotIndex = uint32(m_slots.size());
+			m_slots.emplace_back();
+		}
+
+		SSlot& slot = m_slots [slotIndex];
+		slot.isInUse = true;
+		request.id = MakeHandle(slotIndex, slot.generation);
+		slot.request = request;
 
-		// It is extremely unlikely that we'll wrap around and get a clash with a current request, since requests will usually have a short life span.
-		++m_nextId;
+		// Link it in as the most recent request.
+		slot.prev = m_orderTail;
+		slot.next = InvalidIndex;
+		if (m_orderTail != InvalidIndex)
+			m_slots [m_orderTail].next = slotIndex;
+		else
+			m_orderHead = slotIndex;
+		m_orderTail = slotIndex;
+
+		m_count++;
 
 		return request.id;
 	}
 
+
+	/**
+	Removes a request. Identifiers for requests which have already been removed are ignored.
+
+	\param	cancelRequestId Identifier for the request.
+	**/
 	void RemoveRequest(const uint32 cancelRequestId)
 	{
-		typename TRequestsVector::iterator itEnd = m_requests.end();
-		for (typename TRequestsVector::iterator it = m_requests.begin(); it != itEnd; ++it)
-		{
-			const TRequestType& request = *it;
-			if (cancelRequestId == request.id)
-			{
-				m_requests.erase(it);
-				return;
-			}
-		}
+		const uint32 slotIndex = (cancelRequestId & slotIndexMask) - 1;
+		if (slotIndex >= m_slots.size())
+			return;
+
+		SSlot& slot = m_slots [slotIndex];
+		if (!slot.isInUse || (MakeHandle(slotIndex, slot.generation) != cancelRequestId))
+			return;
+
+		// Unlink it from the order.
+		if (slot.prev != InvalidIndex)
+			m_slots [slot.prev].next = slot.next;
+		else
+			m_orderHead = slot.next;
+
+		if (slot.next != InvalidIndex)
+			m_slots [slot.next].prev = slot.prev;
+		else
+			m_orderTail = slot.prev;
+
+		// Any handles still out there for this slot are now stale.
+		slot.generation = (slot.generation + 1) & generationMask;
+		slot.isInUse = false;
+		slot.prev = InvalidIndex;
+		slot.next = m_freeHead;
+		m_freeHead = slotIndex;
+
+		m_count--;
 	}
 
-	const TRequestType& GetRequest(const size_t index) const
+
+	/** Gets the most recently added request which hasn't been removed, or null if there are none. */
+	const TRequestType* GetMostRecentRequest() const
 	{
-		return m_requests [index];
+		return (m_orderTail != InvalidIndex) ? &m_slots [m_orderTail].request : nullptr;
 	}
 
+
+	/**
+	Visits each request, from the oldest to the most recent.
+
+	\param	visitor Called with each request.
+	**/
+	template<typename VISITOR>
+	void ForEachRequest(VISITOR visitor) const
+	{
+		for (uint32 slotIndex = m_orderHead; slotIndex != InvalidIndex; slotIndex = m_slots [slotIndex].next)
+			visitor(m_slots [slotIndex].request);
+	}
+
+
 	const size_t GetCount() const
 	{
-		return m_requests.size();
+		return m_count;
 	}
 
 private:
-	uint32 m_nextId;
-	TRequestsVector m_requests;
+	static const uint32 InvalidIndex { ~0u };
+
+	/** The lower bits of a handle hold the slot index plus one, so that a handle is never zero. */
+	static const uint32 slotIndexBits { 16 };
+	static const uint32 slotIndexMask { (1u << slotIndexBits) - 1 };
+	static const uint32 generationMask { ~0u >> slotIndexBits };
+
+	static uint32 MakeHandle(const uint32 slotIndex, const uint32 generation)
+	{
+		return (generation << slotIndexBits) | (slotIndex + 1);
+	}
+
+	struct SSlot
+	{
+		TRequestType request;
+		uint32 generation { 0 };
+
+		/** The neighbouring slots in the request order while in use, or the next free slot while free. */
+		uint32 prev { InvalidIndex };
+		uint32 next { InvalidIndex };
+
+		bool isInUse { false };
+	};
+
+	std::vector<SSlot> m_slots;
+
+	/** The oldest and most recent requests. */
+	uint32 m_orderHead { InvalidIndex };
+	uint32 m_orderTail { InvalidIndex };
+
+	/** The first slot on the free list. */
+	uint32 m_freeHead { InvalidIndex };
+
+	size_t m_count { 0 };
 };
+
+
+/**
+Checks that request identifiers behave when their slots are reused. This runs from the console, as there is nowhere
+else to run it from.
+
+\return True if every check passed. Failures are logged.
+**/
+bool RunRequestListSelfTest();
+}
 }
-}
\ No newline at end of file
@@ -5,6 +5,14 @@
 
 namespace Chrysalis
 {
+namespace
+{
+/** The attachment for the needle. */
+// TODO: switch this to needle or have a widget to pick it out of a list
+const char* const handNames [] = { "hours" };
+}
+
+
 void CGaugeComponent::Register(Schematyc::CEnvRegistrationScope& componentScope)
 {
 	{
@@ -51,6 +59,13 @@ void CGaugeComponent::Initialize()
 }
 
 
+CGaugeComponent::~CGaugeComponent()
+{
+	if (auto pDisplaySystem = CChrysalisCorePlugin::Get()->GetMechanicalDisplaySystem())
+		pDisplaySystem->Unregister(m_displayId);
+}
+
+
 void CGaugeComponent::ProcessEvent(SEntityEvent& event)
 {
 	switch (event.event)
@@ -62,13 +77,6 @@ void CGaugeComponent::ProcessEvent(SEntityEvent& event)
 			ResetObject();
 		}
 		break;
-
-		case ENTITY_EVENT_UPDATE:
-		{
-			SEntityUpdateContext* pCtx = (SEntityUpdateContext*)event.nParam [0];
-			Update(pCtx);
-		}
-		break;
 	}
 
 	CBaseMeshComponent::ProcessEvent(event);
@@ -90,6 +98,14 @@ void CGaugeComponent::LoadFromDisk()
 
 void CGaugeComponent::ResetObject()
 {
+	// The character or axis may have changed, so any attachments we resolved are no longer valid.
+	auto pDisplaySystem = CChrysalisCorePlugin::Get()->GetMechanicalDisplaySystem();
+	if (pDisplaySystem)
+	{
+		pDisplaySystem->Unregister(m_displayId);
+		m_displayId = InvalidMechanicalDisplayId;
+	}
+
 	if (m_pCachedCharacter == nullptr)
 	{
 		FreeEntitySlot();
@@ -97,27 +113,21 @@ void CGaugeComponent::ResetObject()
 	}
 
 	m_pEntity->SetCharacter(m_pCachedCharacter, GetOrMakeEntitySlotId() | ENTITY_SLOT_ACTUAL, false);
+
+	if (pDisplaySystem)
+	{
+		m_displayId = pDisplaySystem->Register(GetEntityId(), m_pCachedCharacter, m_gaugeProperties.axis, handNames, CRY_ARRAY_COUNT(handNames));
+		UpdateDisplay();
+	}
 }
 
 
-void CGaugeComponent::Update(SEntityUpdateContext* pCtx)
+void CGaugeComponent::UpdateDisplay()
 {
-	if (m_pCachedCharacter)
+	if (auto pDisplaySystem = CChrysalisCorePlugin::Get()->GetMechanicalDisplaySystem())
 	{
-		// If we can access the attachments, we can try and find the rotation for each hand.
-		const IAttachmentManager* pAttachmentManager = m_pCachedCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
-		{
-			// Is there a needle joint?
-			const auto needleIndex = pAttachmentManager->GetIndexByName("hours"); // TODO: switch this to needle or have a widget to pick it out of a list
-			if (IAttachment* pNeedleAttachment = pAttachmentManager->GetInterfaceByIndex(needleIndex))
-			{
-				QuatT trans = pNeedleAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_gaugeProperties.needleValue);
-				trans.q = Quat::CreateRotationXYZ(m_gaugeProperties.axis * radians);
-				pNeedleAttachment->SetAttAbsoluteDefault(trans);
-			}
-		}
+		const float degrees [] = { m_gaugeProperties.needleValue };
+		pDisplaySystem->SetHandAngles(m_displayId, degrees, CRY_ARRAY_COUNT(degrees));
 	}
 }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Entities/Interaction/IEntityInteraction.h"
 #include <DefaultComponents/Geometry/BaseMeshComponent.h>
+#include <Game/Display/MechanicalDisplaySystem.h>
 
 
 namespace Chrysalis
@@ -20,12 +21,12 @@ protected:
 	// IEntityComponent
 	void Initialize() override;
 	void ProcessEvent(SEntityEvent& event) override;
-	uint64 GetEventMask() const { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask() | BIT64(ENTITY_EVENT_UPDATE); }
+	uint64 GetEventMask() const { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask(); }
 	// ~IEntityComponent
 
 public:
 	CGaugeComponent() {}
-	virtual ~CGaugeComponent() {}
+	virtual ~CGaugeComponent();
 
 	static void ReflectType(Schematyc::CTypeDesc<CGaugeComponent>& desc);
 
@@ -43,8 +44,6 @@ public:
 		Schematyc::Range<0, 360> needleValue = 0.0f;
 	};
 
-	virtual void Update(SEntityUpdateContext* pCtx);
-
 	virtual void SetCharacterFile(const char* szPath) { m_filePath = szPath; };
 	const char* GetCharacterFile() const { return m_filePath.value.c_str(); }
 
@@ -60,12 +59,19 @@ public:
 	void SetNeedle(const float needleValue)
 	{
 		m_gaugeProperties.needleValue = needleValue;
+		UpdateDisplay();
 	}
 
 protected:
+	/** Tells the mechanical display system where the needle should be pointing. */
+	void UpdateDisplay();
+
 	Schematyc::CharacterFileName m_filePath;
 	_smart_ptr<ICharacterInstance> m_pCachedCharacter = nullptr;
 	SGaugeProperties m_gaugeProperties;
+
+	/** Our registration with the mechanical display system. */
+	TMechanicalDisplayId m_displayId { InvalidMechanicalDisplayId };
 };
 
 
@@ -71,20 +71,28 @@ void CDRSInteractionComponent::OnInteractionDRS()
 		// Make sure the target entity has a DRS proxy.
 		auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
 
-		// Create a context variable collection and populate it based on information from the target entity.
-		DRS::IVariableCollectionSharedPtr pContextVariableCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+		// The properties can be edited, so only reuse a context variable collection which was filled with the same keys.
+		uint32 layoutKey { 0 };
+		for (const auto& it : m_drsProperties)
+		{
+			layoutKey = (layoutKey * 31) + CHashedString(it.key).GetHash();
+		}
+
+		// Reuse a context variable collection and populate it based on information from the target entity.
+		DRS::IVariableCollectionSharedPtr pContextVariableCollection = m_contextCollections.Acquire(layoutKey);
 
-		// It might be useful to know which verb triggered the interaction.
-		pContextVariableCollection->CreateVariable("Verb", CHashedString(m_drsResponse));
+		// It might be useful to know which verb triggered the interaction. It's also the signal, so we only hash it once.
+		const CHashedString response(m_drsResponse);
+		pContextVariableCollection->SetVariableValue(DRSKeys::kVerb, response);
 
 		// Add each key, value to the DRS variable collection.
-		for (auto it : m_drsProperties)
+		for (const auto& it : m_drsProperties)
 		{
-			pContextVariableCollection->CreateVariable(CHashedString(it.key), CHashedString(it.value));
+			pContextVariableCollection->SetVariableValue(CHashedString(it.key), CHashedString(it.value));
 		}
 
 		// Queue it and let the DRS handle it now.
-		pDrsProxy->GetResponseActor()->QueueSignal(m_drsResponse, pContextVariableCollection);
+		pDrsProxy->GetResponseActor()->QueueSignal(response, pContextVariableCollection);
 	}
 }
 }
\ No newline at end of file
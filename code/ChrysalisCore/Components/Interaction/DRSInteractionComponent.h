@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Entities/Interaction/IEntityInteraction.h"
+#include "Utility/DRS.h"
 
 
 namespace Chrysalis
@@ -72,5 +73,8 @@ private:
 
 	/** Properties. */
 	std::vector<SDRSProperties> m_drsProperties;
+
+	/** Context collections for the signals we send, reused once the DRS is done with them. */
+	DRSUtility::CContextCollectionPool m_contextCollections;
 };
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <Components/Player/Camera/ICameraComponent.h>
 #include <Components/Interaction/EntityInteractionComponent.h>
 #include <Console/CVars.h>
+#include <Plugin/ChrysalisCorePlugin.h>
 
 
 namespace Chrysalis
@@ -20,8 +21,9 @@ static const float forwardCastDistance = 300.0f;
 /** Scales the proximity distance for what is considered 'close by' queries. */
 static const float proximityCloseByFactor = 0.5f;
 
-/** Allow previous ray-cast results to still be used for up to this long, in seconds. */
-static const float maxRaycastStaleness = 0.05f;
+/** Allow previous ray-cast results to still be used for up to this long, in seconds. Deferred results arrive a frame
+or two after they are requested, so this needs to cover a couple of frames at low frame rates. */
+static const float maxRaycastStaleness = 0.1f;
 
 #define PIERCE_GLASS (13)
 
@@ -111,6 +113,8 @@ void CEntityAwarenessComponent::GetMemoryUsage(ICrySizer *pSizer) const
 {
 	pSizer->AddObject(this, sizeof(*this));
 	pSizer->AddObject(m_entitiesInProximity);
+	pSizer->AddContainer(m_proximalBounds);
+	pSizer->AddContainer(m_nearBoundsIndices);
 	pSizer->AddObject(m_entitiesInFrontOf);
 }
 
@@ -137,10 +141,9 @@ CEntityAwarenessComponent::CEntityAwarenessComponent()
 
 CEntityAwarenessComponent::~CEntityAwarenessComponent()
 {
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		m_queuedRays [i].Reset();
-	}
+	// Make sure no deferred results are delivered to us after we're gone.
+	if (auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService())
+		pRaycastService->Cancel(this);
 }
 
 
@@ -152,40 +155,17 @@ void CEntityAwarenessComponent::UpdateRaycastQuery()
 	if (m_eyeDirection.IsValid())
 	{
 		IEntity * pEntity = m_pActor->GetEntity();
-		IPhysicalEntity * pPhysEnt = pEntity ? pEntity->GetPhysics() : nullptr;
-		IPhysicalEntity *skipEntities [1];
-		skipEntities [0] = pPhysEnt;
-
-		int raySlot = RequestRaySlotId();
-		CRY_ASSERT(raySlot != -1);
-
-		ray_hit rayHit;
-
-		// Use a synchronous ray-cast.
-		auto hits = gEnv->pPhysicalWorld->RayWorldIntersection(
-			m_eyePosition, m_eyeDirection * FORWARD_DIRECTION * forwardCastDistance,
-			ent_all, rwi_pierceability(PIERCE_GLASS) | rwi_colltype_any,
-			&rayHit, 1,
-			skipEntities, pPhysEnt ? 1 : 0);
-		if (hits > 0)
-		{
-			OnRayCast(rayHit);
-		}
 
-		// HACK: Removed asynchronous raycasts because they were using CryAction and that had link problems with 5.3 and
-		// will be removed when 5.4 releases. 
-		// Use an asynchronous ray-cast.
-//		m_queuedRays [raySlot].rayId = static_cast<CCryAction*>(gEnv->pGameFramework)->GetPhysicQueues().GetRayCaster().Queue(
-//			RayCastRequest::HighPriority,
-//			RayCastRequest(m_eyePosition, m_eyeDirection * FORWARD_DIRECTION * forwardCastDistance,
-//				ent_all,
-//				rwi_pierceability(PIERCE_GLASS) | rwi_colltype_any,
-//				skipEntities,
-//				pPhysEnt ? 1 : 0,
-//				2),
-//			functor(*this, &CEntityAwarenessComponent::OnRayCastDataReceived));
-//
-//		m_queuedRays [raySlot].counter = ++m_requestCounter;
+		// Use an asynchronous ray-cast. The service batches these up with the rays from every other actor.
+		SRaycastRequest request;
+		request.origin = m_eyePosition;
+		request.direction = m_eyeDirection * FORWARD_DIRECTION * forwardCastDistance;
+		request.objectTypes = ent_all;
+		request.flags = rwi_pierceability(PIERCE_GLASS) | rwi_colltype_any;
+		request.pSkipEntity = pEntity ? pEntity->GetPhysics() : nullptr;
+
+		if (auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService())
+			pRaycastService->Queue(request, this);
 
 #if defined(_DEBUG)
 		if (g_cvars.m_componentAwarenessDebug & eDB_RayCast)
@@ -208,14 +188,13 @@ void CEntityAwarenessComponent::UpdateRaycastQuery()
 }
 
 
-void CEntityAwarenessComponent::OnRayCastDataReceived(const QueuedRayID& rayID, const RayCastResult& result)
+void CEntityAwarenessComponent::OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result)
 {
-	int raySlot = QueryRaySlotId(rayID);
-	CRY_ASSERT(raySlot != -1);
+	// Results can arrive out of order. Never let an older result replace a newer one.
+	if (ticket < m_lastRayTicketReceived)
+		return;
 
-	// Clear out the raycast slot if we used one.
-	if (raySlot != -1)
-		m_queuedRays [raySlot].Reset();
+	m_lastRayTicketReceived = ticket;
 
 	// Force the distance to a negative value to invalidate the last result.
 	m_rayHitPierceable.dist = -1.0f;
@@ -303,49 +282,6 @@ void CEntityAwarenessComponent::OnRayCast(const ray_hit & rayHit)
 }
 
 
-int CEntityAwarenessComponent::RequestRaySlotId()
-{
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		if (m_queuedRays [i].rayId == 0)
-		{
-			return i;
-		}
-	}
-
-	// Find the oldest request and remove it.
-	// HACK: This will lead to wrap-around issues, do a better job of getting a slot.
-	uint32 oldestCounter = m_requestCounter + 1;
-	int oldestSlot = 0;
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		if (m_queuedRays [i].counter < oldestCounter)
-		{
-			oldestCounter = m_queuedRays [i].counter;
-			oldestSlot = i;
-		}
-	}
-
-	m_queuedRays [oldestSlot].Reset();
-
-	return oldestSlot;
-}
-
-
-int CEntityAwarenessComponent::QueryRaySlotId(const QueuedRayID& rayId) const
-{
-	for (int i = 0; i < maxQueuedRays; ++i)
-	{
-		if (m_queuedRays [i].rayId == rayId)
-		{
-			return i;
-		}
-	}
-
-	return -1;
-}
-
-
 void CEntityAwarenessComponent::UpdateProximityQuery()
 {
 	// The bounding box is created by offseting m_proximityRadius in each direction.
@@ -357,50 +293,46 @@ void CEntityAwarenessComponent::UpdateProximityQuery()
 	// Clear previous results. We could resize(0) at this point, but rather than thrash memory, I'll see how well
 	// it works just growing when needing and remaining at that size.
 	m_entitiesInProximity.clear();
+	m_proximalBounds.clear();
 
 	// Set up the bounding box query.
-	SEntityProximityQuery qry;
-	qry.box.min = m_eyePosition - positionOffset;
-	qry.box.max = m_eyePosition + positionOffset;
+	AABB queryBox(m_eyePosition - positionOffset, m_eyePosition + positionOffset);
 
 #if defined(_DEBUG)
 	if (g_cvars.m_componentAwarenessDebug & eDB_ProximalEntities)
 	{
 		// DEBUG: Render the grid for debug purposes.
-		gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(qry.box, false, ColorB(255, 0, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
+		gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(queryBox, false, ColorB(255, 0, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 	}
 #endif
 
-	// Run the query and prepare to populate a list of the results, if they pass muster.
-	gEnv->pEntitySystem->QueryProximity(qry);
-	m_entitiesInProximity.reserve(qry.nCount);
+	// Run the query against the shared index of interactable entities. The results come with their bounds already
+	// cached, so none of the following queries need to look up the entities.
+	if (auto pSpatialHash = CChrysalisCorePlugin::Get()->GetInteractableSpatialHash())
+		pSpatialHash->Query(queryBox, m_proximalBounds);
 
-	// Check each result.
-	for (int i = 0; i < qry.nCount; ++i)
-	{
-		IEntity* pEntity = qry.pEntities [i];
-		EntityId entityId = pEntity ? pEntity->GetId() : INVALID_ENTITYID;
+	// Remove ourselves from the results, if we were found.
+	m_proximalBounds.erase(std::remove_if(m_proximalBounds.begin(), m_proximalBounds.end(),
+		[ownerActorId](const SInteractableBounds& bounds) { return bounds.entityId == ownerActorId; }),
+		m_proximalBounds.end());
 
-		// Skip this entity.
-		if ((entityId == INVALID_ENTITYID) || (entityId == ownerActorId))
-			continue;
+	m_entitiesInProximity.reserve(m_proximalBounds.size());
 
+	// Check each result.
+	for (const auto& bounds : m_proximalBounds)
+	{
 #if defined(_DEBUG)
 		if (g_cvars.m_componentAwarenessDebug & eDB_ProximalEntities)
 		{
-			if (strcmp(pEntity->GetName(), "TestMe") == 0)
-				int a = 1;
-
 			// DEBUG: Highlight each entity within the range.
-			AABB bbox;
-			pEntity->GetWorldBounds(bbox);
+			AABB bbox = bounds.worldBounds;
 			bbox.Expand(Vec3(0.01f, 0.01f, 0.01f));
 			gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 64, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 		}
 #endif
 
 		// Add to the collection.
-		m_entitiesInProximity.push_back(entityId);
+		m_entitiesInProximity.push_back(bounds.entityId);
 	}
 }
 
@@ -422,26 +354,20 @@ void CEntityAwarenessComponent::UpdateNearQuery()
 #endif
 
 	// Clear previous results.
-	m_entitiesNear.reserve(m_entitiesInProximity.size());
+	m_entitiesNear.reserve(m_proximalBounds.size());
 	m_entitiesNear.clear();
-
-	// Retrieve the actor EntityId so we can exclude ourselves from the results.
-	EntityId ownerActorId = m_pActor ? m_pActor->GetEntityId() : INVALID_ENTITYID;
+	m_nearBoundsIndices.reserve(m_proximalBounds.size());
+	m_nearBoundsIndices.clear();
 
 	// We parse the results of the latest proximity query, just selecting the ones that match our strict criteria.
-	for (auto& entityId : m_entitiesInProximity)
+	for (uint32 i = 0; i < m_proximalBounds.size(); ++i)
 	{
-		// Skip this entity.
-		if ((entityId == INVALID_ENTITYID) || (entityId == ownerActorId))
-			continue;
-
-		IEntity* pEntity = gEnv->pEntitySystem->GetEntity(entityId);
+		const auto& bounds = m_proximalBounds [i];
 
 		// #TODO: The near query should really be based off distance from the actor, eye position is currently the camera in TP modes.
 
 		// Seems to discard anything too far based on radius, turning the cube into a flat circle.
-		AABB aabb;
-		pEntity->GetWorldBounds(aabb);
+		AABB aabb = bounds.worldBounds;
 		aabb.min.z = aabb.max.z = m_eyePosition.z;
 		if (aabb.GetDistanceSqr(m_eyePosition) > flatDistanceSqr)
 			continue;
@@ -450,15 +376,15 @@ void CEntityAwarenessComponent::UpdateNearQuery()
 		if (g_cvars.m_componentAwarenessDebug & eDB_NearEntities)
 		{
 			// DEBUG: Highlight the entity.
-			AABB bbox;
-			pEntity->GetWorldBounds(bbox);
+			AABB bbox = bounds.worldBounds;
 			bbox.Expand(Vec3(0.02f, 0.02f, 0.02f));
 			gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 196, 0), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 		}
 #endif
 
 		// Acceptable result, add to the collection.
-		m_entitiesNear.push_back(entityId);
+		m_entitiesNear.push_back(bounds.entityId);
+		m_nearBoundsIndices.push_back(i);
 	}
 }
 
@@ -466,7 +392,7 @@ void CEntityAwarenessComponent::UpdateNearQuery()
 void CEntityAwarenessComponent::UpdateInFrontOfQuery()
 {
 	// Clear previous results.
-	m_entitiesInFrontOf.reserve(m_entitiesInProximity.size());
+	m_entitiesInFrontOf.reserve(m_proximalBounds.size());
 	m_entitiesInFrontOf.clear();
 
 	// A line segment to represent where the actor is looking.
@@ -482,44 +408,23 @@ void CEntityAwarenessComponent::UpdateInFrontOfQuery()
 	}
 #endif
 
-	// Retrieve the actor EntityId so we can exclude ourselves from the results.
-	EntityId ownerActorId = m_pActor ? m_pActor->GetEntityId() : INVALID_ENTITYID;
-
 	// We parse the results of the latest proximity query, just selecting the ones that match our strict criteria.
-	for (auto& entityId : m_entitiesInProximity)
+	for (const auto& bounds : m_proximalBounds)
 	{
-		// Skip this entity.
-		if ((entityId == INVALID_ENTITYID) || (entityId == ownerActorId))
-			continue;
-
-		IEntity* pEntity = gEnv->pEntitySystem->GetEntity(entityId);
-
-		AABB bbox;
-		pEntity->GetLocalBounds(bbox);
-		if (!bbox.IsEmpty())
+		if (bounds.hasLocalBounds)
 		{
-			OBB obb(OBB::CreateOBBfromAABB(Matrix33(pEntity->GetWorldTM()), bbox));
-
-			if (Overlap::Lineseg_OBB(lineseg, pEntity->GetWorldPos(), obb))
+			if (Overlap::Lineseg_OBB(lineseg, bounds.worldPos, bounds.worldOBB))
 			{
 #if defined(_DEBUG)
 				if (g_cvars.m_componentAwarenessDebug & eDB_InFront)
 				{
 					// DEBUG: let's see those boxes.
-					gEnv->pRenderer->GetIRenderAuxGeom()->DrawOBB(obb, pEntity->GetWorldTM(), true, ColorB(0, 0, 196), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
+					gEnv->pRenderer->GetIRenderAuxGeom()->DrawOBB(bounds.worldOBB, bounds.worldPos, true, ColorB(0, 0, 196), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 				}
 #endif
 
-				// #HACK: TEST: wrong place for this test - move it to somewhere i can see it try all the entities near us.
-				auto pInteractor = pEntity->GetComponent<CEntityInteractionComponent>();
-				if (pInteractor)
-				{
-					// There's an interactor component, so this is an interactive entity.
-					// 
-					auto verbs = pInteractor->GetVerbs();
-				}
-
-				m_entitiesInFrontOf.push_back(pEntity->GetId());
+				// The spatial hash already holds everything we need, so there's no need to go back to the entity system.
+				m_entitiesInFrontOf.push_back(bounds.entityId);
 			}
 		}
 	}
@@ -533,41 +438,33 @@ const Entities& CEntityAwarenessComponent::GetNearDotFiltered(float minDot, floa
 	float bestScore = 10000.0f;
 
 	// Clear previous results.
-	m_entitiesNearDotFiltered.reserve(m_entitiesInProximity.size());
+	m_entitiesNearDotFiltered.reserve(m_proximalBounds.size());
 	m_entitiesNearDotFiltered.clear();
 
 	// Refresh the list of near entities.
-	auto entities = NearQuery();
+	NearQuery();
+
+	// The look direction is the same for every entity.
+	const Vec3 dirLooking = (m_eyeDirection * FORWARD_DIRECTION).normalized();
 
 	// Check each entity to see which is the best fit.
-	for (auto& entityId : entities)
+	for (auto boundsIndex : m_nearBoundsIndices)
 	{
-		IEntity *pEntity = gEnv->pEntitySystem->GetEntity(entityId);
-		if (!pEntity)
-			continue;
-
-		AABB bbox;
-		pEntity->GetWorldBounds(bbox);
-
-		Vec3 itemPos = bbox.GetCenter();
-		Vec3 dirToItem = (itemPos - m_eyePosition).normalized();
-		Vec3 dirLooking = (m_eyeDirection * FORWARD_DIRECTION).normalized();
-		float dotToItem = dirToItem.dot(dirLooking);
+		const auto& bounds = m_proximalBounds [boundsIndex];
 
-		if ((dotToItem >= minDot) && (dotToItem <= maxDot))
+		float score;
+		if (ScoreDotFiltered(m_eyePosition, dirLooking, bounds.worldBounds.GetCenter(), minDot, maxDot, score))
 		{
 #if defined(_DEBUG)
 			if (g_cvars.m_componentAwarenessDebug & eDB_DotFiltered)
 			{
 				// DEBUG: Highlight the entity.
+				AABB bbox = bounds.worldBounds;
 				bbox.Expand(Vec3(0.03f, 0.03f, 0.03f));
 				gEnv->pRenderer->GetIRenderAuxGeom()->DrawAABB(bbox, true, ColorB(0, 0, 64), EBoundingBoxDrawStyle::eBBD_Extremes_Color_Encoded);
 			}
 #endif
 
-			// Provide a score for this result to qualify how good a match it is.
-			float distance = (itemPos - m_eyePosition).len();
-			float score = (1.0f - dotToItem) * distance;
 			if (score < bestScore)
 			{
 				bestResultIndex = resultIndex;
@@ -575,7 +472,7 @@ const Entities& CEntityAwarenessComponent::GetNearDotFiltered(float minDot, floa
 			}
 
 			// Acceptable result, add to the collection.
-			m_entitiesNearDotFiltered.push_back(entityId);
+			m_entitiesNearDotFiltered.push_back(bounds.entityId);
 			resultIndex++;
 		}
 	}
@@ -600,4 +497,20 @@ const Entities& CEntityAwarenessComponent::GetNearDotFiltered(float minDot, floa
 
 	return m_entitiesNearDotFiltered;
 }
-}
\ No newline at end of file
+
+
+bool CEntityAwarenessComponent::ScoreDotFiltered(const Vec3& eyePosition, const Vec3& dirLooking, const Vec3& itemPos, float minDot, float maxDot, float& score)
+{
+	const Vec3 toItem = itemPos - eyePosition;
+	const Vec3 dirToItem = toItem.normalized();
+	const float dotToItem = dirToItem.dot(dirLooking);
+
+	if ((dotToItem < minDot) || (dotToItem > maxDot))
+		return false;
+
+	// Provide a score for this result to qualify how good a match it is.
+	score = (1.0f - dotToItem) * toItem.len();
+
+	return true;
+}
+}
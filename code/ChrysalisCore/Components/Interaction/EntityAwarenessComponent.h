@@ -4,13 +4,16 @@
 Declares the entity awareness class. Refactored from CryEngine\CryAction\GameObjects\WorldQuery.h.
 
 This adds spatial awareness of other entities to the actor it extends. It uses raycasts and AABB queries to track entities
-with which the actor might wish to or need to interact.
+with which the actor might wish to or need to interact. Ray-casts are deferred through the plugin's ray-cast service, so
+look-at results lag one frame behind.
+
+The proximity, near and in-front queries only return entities with an interaction component, since they are answered
+from the plugin's spatial index of interactables. Every caller goes on to look for that component in any case.
 **/
 #pragma once
 
-#include <CryPhysics/RayCastQueue.h>
-#include <CryAction.h>
-#include <CryActionPhysicQueues.h>
+#include <Game/Physics/RaycastService.h>
+#include <Game/Spatial/InteractableSpatialHash.h>
 
 struct ray_hit;
 
@@ -23,6 +26,7 @@ typedef std::vector<EntityId> Entities;
 
 class CEntityAwarenessComponent
 	: public IEntityComponent
+	, public IRaycastReceiver
 {
 protected:
 	friend CChrysalisCorePlugin;
@@ -66,13 +70,9 @@ public:
 	void Update();
 
 
-	/**
-	Functor that receives the results of deferred ray-cast operations.
-
-	\param	rayID  Identifier for the ray.
-	\param	result The result.
-	**/
-	void OnRayCastDataReceived(const QueuedRayID& rayID, const RayCastResult& result);
+	// IRaycastReceiver
+	void OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result) override;
+	// ~IRaycastReceiver
 
 
 	/**
@@ -206,6 +206,22 @@ public:
 	const Entities& GetNearDotFiltered(float minDot = 0.9f, float maxDot = 1.0f);
 
 
+	/**
+	Scores how well an item fits the direction we are looking in. A lower score is a better match, favouring items which
+	are both close and near the centre of view.
+
+	\param 		   	eyePosition The eye position.
+	\param 		   	dirLooking  The normalised direction we are looking.
+	\param 		   	itemPos	    The item position.
+	\param 		   	minDot	    The minimum dot product.
+	\param 		   	maxDot	    The maximum dot product.
+	\param [out]	score	    The score for the item. Only valid if the item is within the dot range.
+
+	\return True if the item is within the range of dot product results.
+	**/
+	static bool ScoreDotFiltered(const Vec3& eyePosition, const Vec3& dirLooking, const Vec3& itemPos, float minDot, float maxDot, float& score);
+
+
 private:
 	// Keep in sync with m_updateQueryFunctions.
 	enum EWorldQuery
@@ -217,26 +233,6 @@ private:
 	};
 
 
-	struct SRayInfo
-	{
-		void Reset()
-		{
-			if (rayId != 0)
-			{
-				// #HACK: Massive issue, removed due to problems linking to CryAction in 5.3. It's hard to tell why this is even
-				// here now. Reseting the whole queue seems like a terrible idea in a function like this.
-				// static_cast<CCryAction*>(gEnv->pGameFramework)->GetPhysicQueues().GetRayCaster().Reset(); 
-			}
-
-			rayId = 0;
-			counter = 0;
-		}
-
-		QueuedRayID rayId = 0;
-		uint32 counter = 0;
-	};
-
-
 	/**
 	Checks to see if we have a query result that is still valid for this FrameId. If no fresh query result is found
 	it will run a query update and mark the new result as being useable within this FrameId. This works like a simple
@@ -276,9 +272,6 @@ private:
 	// Ensure all update query routines conform to this definition.
 	typedef void (CEntityAwarenessComponent::*UpdateQueryFunction)();
 
-	// Limit the size of the array used to track the raycasts.
-	static const int maxQueuedRays { 6 };
-
 	/** The proximity radius defines the maximum distance we will search for entities that are considered
 	"in-proximity". It is used to restrict both proximity queries and ray-cast queries. */
 	float m_proximityRadius { 6.0f };
@@ -303,12 +296,8 @@ private:
 	// An array of functors which run the update queries.
 	static UpdateQueryFunction m_updateQueryFunctions [];
 
-	// #TODO: Maybe use a vector for this?
-	SRayInfo m_queuedRays [maxQueuedRays];
-
-	// Keep a track of how many rays we have queued.
-	// #TODO: Is there a safer way to handle all of this?
-	uint32 m_requestCounter { 0 };
+	/** The ticket for the freshest ray-cast result we have accepted. Any result with an older ticket is stale. */
+	TRaycastTicket m_lastRayTicketReceived { kInvalidRaycastTicket };
 
 	/** Track the time of the last deferred ray-cast. */
 	float m_timeLastDeferredResult { 0.0f };
@@ -329,6 +318,13 @@ private:
 	// interactive for the player.
 	Entities m_entitiesInProximity;
 
+	// The cached bounds for each of the entities in m_entitiesInProximity. The other queries work from these instead
+	// of looking up each entity.
+	std::vector<SInteractableBounds> m_proximalBounds;
+
+	// Indices into m_proximalBounds for each of the entities in m_entitiesNear.
+	std::vector<uint32> m_nearBoundsIndices;
+
 	// The entities which are close enough to the actor to be interactable or worth highlighting.
 	Entities m_entitiesNear;
 
@@ -341,15 +337,16 @@ private:
 
 	/**
 	Performs a deferred raycast from the actors eye in the direction the actor is facing for forwardCastDistance
-	metres. OnRayCastDataReceived is called asynchronously with the result.
+	metres. OnRayCastDataReceived is called with the result, usually on the next frame.
 	**/
 	void UpdateRaycastQuery();
 
 
 	/**
-	Creates an AABB around the actor and performs a query on entities within that box. The size of the box is based
-	on m_proximityRadius. Any entities which are within the box will be made available in the m_entitiesInProximity
-	container as a side effect of running this query. No culling is performed on the entities returned from the query.
+	Creates an AABB around the actor and performs a query on the shared interactable spatial index within that box.
+	The size of the box is based on m_proximityRadius. Any entities which are within the box will be made available in
+	the m_entitiesInProximity container as a side effect of running this query. No culling is performed on the entities
+	returned from the query.
 
 	You can use this as a base on which to build more nuanced and precise queries.
 	**/
@@ -393,24 +390,5 @@ private:
 	\param	rayHit The ray hit.
 	**/
 	void OnRayCast(const ray_hit& rayHit);
-
-
-	/**
-	Runs through the raycast queue and finds a free slot, if available. If none is available it will kill the oldest
-	slot.
-
-	\return The ray slot Id.
-	**/
-	int RequestRaySlotId();
-
-
-	/**
-	Queries the queue to find the slot Id for a queued raycast.
-
-	\param	rayId Identifier for the ray.
-
-	\return The ray slot identifier.
-	**/
-	int QueryRaySlotId(const QueuedRayID& rayId) const;
 };
 }
\ No newline at end of file
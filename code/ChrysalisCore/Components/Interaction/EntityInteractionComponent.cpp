@@ -1,7 +1,7 @@
 #include <StdAfx.h>
 
 #include "EntityInteractionComponent.h"
-#include "Components/Player/PlayerComponent.h"
+#include "Game/Spatial/InteractableSpatialHash.h"
 
 
 namespace Chrysalis
@@ -31,6 +31,16 @@ void CEntityInteractionComponent::ReflectType(Schematyc::CTypeDesc<CEntityIntera
 
 void CEntityInteractionComponent::Initialize()
 {
+	// Make ourselves known to the awareness queries.
+	if (auto pSpatialHash = CChrysalisCorePlugin::Get()->GetInteractableSpatialHash())
+		pSpatialHash->Register(GetEntityId());
+}
+
+
+CEntityInteractionComponent::~CEntityInteractionComponent()
+{
+	if (auto pSpatialHash = CChrysalisCorePlugin::Get()->GetInteractableSpatialHash())
+		pSpatialHash->Unregister(GetEntityId());
 }
 
 
@@ -38,33 +48,18 @@ void CEntityInteractionComponent::ProcessEvent(SEntityEvent& event)
 {
 	switch (event.event)
 	{
-		case ENTITY_EVENT_UPDATE:
-			Update();
+		case ENTITY_EVENT_XFORM:
+		case ENTITY_EVENT_PHYSICS_CHANGE:
+		case ENTITY_EVENT_SLOT_CHANGED:
+		case ENTITY_EVENT_RESET:
+			// Our cached bounds in the spatial index are now out of date.
+			if (auto pSpatialHash = CChrysalisCorePlugin::Get()->GetInteractableSpatialHash())
+				pSpatialHash->MarkDirty(GetEntityId());
 			break;
 	}
 }
 
 
-void CEntityInteractionComponent::Update()
-{
-	// #TODO: Remove this if it's not actually needed.
-	const auto pEntity = GetEntity();
-	if (!pEntity)
-		return;
-
-	// NOTE: the thinking now is to just use the update on the extension instead.
-	//if (m_selectedInteraction)
-	//{
-	//	auto pPlayer = CPlayerComponent::GetLocalPlayer();
-	//	if (pPlayer)
-	//	{
-	//		auto pPlayerInput = pPlayer->GetPlayerInput();
-	//		m_selectedInteraction->OnUpdate(pPlayerInput->GetYawDelta(), pPlayerInput->GetPitchDelta());
-	//	}
-	//}
-}
-
-
 // ***
 // *** CEntityInteractionComponent
 // ***
@@ -72,60 +67,77 @@ void CEntityInteractionComponent::Update()
 
 void CEntityInteractionComponent::AddInteraction(IInteractionPtr interaction)
 {
-	m_Interactions.push_back(interaction);
+	m_interactions.push_back({ GetVerbId(interaction->GetVerb()), interaction });
+	m_areVerbsDirty = true;
 }
 
 
-void CEntityInteractionComponent::RemoveInteraction(string verb)
+void CEntityInteractionComponent::RemoveInteraction(CryHash verbId)
 {
-	m_Interactions.erase(std::remove_if(m_Interactions.begin(), m_Interactions.end(),
-		[&](IInteractionPtr i) { return i->GetVerb().compare(verb) == 0; }),
-		m_Interactions.end());
+	m_interactions.erase(std::remove_if(m_interactions.begin(), m_interactions.end(),
+		[verbId](const SInteractionEntry& entry) { return entry.verbId == verbId; }),
+		m_interactions.end());
+	m_areVerbsDirty = true;
 }
 
 
-std::vector<string> CEntityInteractionComponent::GetVerbs(bool includeHidden)
+const std::vector<const char*>& CEntityInteractionComponent::GetVerbs(bool includeHidden)
 {
-	std::vector<string> verbs;
-
-	for (auto& it : m_Interactions)
+	// Interactions can be enabled or hidden behind our back, so the lists are also refreshed each frame.
+	const int frameId = gEnv->nMainFrameID;
+	if (m_areVerbsDirty || (m_verbsFrameId != frameId))
 	{
-		if (it->IsEnabled())
+		m_verbs [0].clear();
+		m_verbs [1].clear();
+
+		for (auto& entry : m_interactions)
 		{
-			if ((!it->IsHidden()) || ((it->IsHidden()) && includeHidden))
+			if (entry.interaction->IsEnabled())
 			{
-				verbs.push_back(it->GetVerb());
+				const char* verb = entry.interaction->GetVerb();
+				if (!entry.interaction->IsHidden())
+					m_verbs [0].push_back(verb);
+				m_verbs [1].push_back(verb);
 			}
 		}
+
+		m_areVerbsDirty = false;
+		m_verbsFrameId = frameId;
 	}
 
-	return verbs;
+	return m_verbs [includeHidden ? 1 : 0];
 }
 
 
-IInteractionWeakPtr CEntityInteractionComponent::GetInteraction(string verb)
+const IInteractionPtr* CEntityInteractionComponent::FindInteraction(CryHash verbId) const
 {
-	for (auto& it : m_Interactions)
+	for (auto& entry : m_interactions)
 	{
-		if ((it->GetVerb().compare(verb) == 0) && (it->IsEnabled()))
+		if ((entry.verbId == verbId) && (entry.interaction->IsEnabled()))
 		{
-			return it;
+			return &entry.interaction;
 		}
 	}
 
+	return nullptr;
+}
+
+
+IInteractionWeakPtr CEntityInteractionComponent::GetInteraction(CryHash verbId)
+{
+	if (auto pInteraction = FindInteraction(verbId))
+		return *pInteraction;
+
 	return std::weak_ptr<IInteraction>();
 }
 
 
-IInteractionWeakPtr CEntityInteractionComponent::SelectInteractionVerb(string verb)
+IInteractionWeakPtr CEntityInteractionComponent::SelectInteractionVerb(CryHash verbId)
 {
-	for (auto& it : m_Interactions)
+	if (auto pInteraction = FindInteraction(verbId))
 	{
-		if ((it->GetVerb().compare(verb) == 0) && (it->IsEnabled()))
-		{
-			m_selectedInteraction = it;
-			return it;
-		}
+		m_selectedInteraction = *pInteraction;
+		return m_selectedInteraction;
 	}
 
 	return std::weak_ptr<IInteraction>();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Entities/Interaction/IEntityInteraction.h>
+#include <Utility/CryHash.h>
 
 
 namespace Chrysalis
@@ -22,12 +23,12 @@ protected:
 	// IEntityComponent
 	void Initialize() override;
 	void ProcessEvent(SEntityEvent& event) override;
-	uint64 GetEventMask() const { return BIT64(ENTITY_EVENT_UPDATE); }
+	uint64 GetEventMask() const { return BIT64(ENTITY_EVENT_XFORM) | BIT64(ENTITY_EVENT_PHYSICS_CHANGE) | BIT64(ENTITY_EVENT_SLOT_CHANGED) | BIT64(ENTITY_EVENT_RESET); }
 	// ~IEntityComponent
 
 public:
 	CEntityInteractionComponent() {}
-	virtual ~CEntityInteractionComponent() {}
+	virtual ~CEntityInteractionComponent();
 
 	static void ReflectType(Schematyc::CTypeDesc<CEntityInteractionComponent>& desc);
 
@@ -37,15 +38,26 @@ public:
 		return id;
 	}
 
-	/** Updates this instance. */
-	void Update();
+	/** Hashes a verb into the id used to look up interactions. Hash any verbs you use often once, and keep the id. */
+	static CryHash GetVerbId(const char* verb) { return CryHashStringId(verb).id; }
 
-	std::vector<string> GetVerbs(bool includeHidden = false);
+	/**
+	Gets the verbs for the enabled interactions, in the order they were added. The list is cached, and only rebuilt
+	after an interaction is added or removed, or once per frame in case an interaction was enabled or hidden.
+
+	\param	includeHidden True to include the hidden interactions.
+
+	\return The verbs. The reference is only valid until the interactions next change.
+	**/
+	const std::vector<const char*>& GetVerbs(bool includeHidden = false);
 
 	void AddInteraction(IInteractionPtr interaction);
-	void RemoveInteraction(string verb);
-	IInteractionWeakPtr GetInteraction(string verb);
-	IInteractionWeakPtr SelectInteractionVerb(string verb);
+	void RemoveInteraction(CryHash verbId);
+	void RemoveInteraction(const char* verb) { RemoveInteraction(GetVerbId(verb)); }
+	IInteractionWeakPtr GetInteraction(CryHash verbId);
+	IInteractionWeakPtr GetInteraction(const char* verb) { return GetInteraction(GetVerbId(verb)); }
+	IInteractionWeakPtr SelectInteractionVerb(CryHash verbId);
+	IInteractionWeakPtr SelectInteractionVerb(const char* verb) { return SelectInteractionVerb(GetVerbId(verb)); }
 	void ClearInteractionVerb();
 
 	void OnInteractionStart();
@@ -54,7 +66,28 @@ public:
 	void OnInteractionCancel();
 
 private:
-	std::vector<IInteractionPtr> m_Interactions;
+	/** Finds the first enabled interaction for a verb. */
+	const IInteractionPtr* FindInteraction(CryHash verbId) const;
+
+	struct SInteractionEntry
+	{
+		CryHash verbId;
+		IInteractionPtr interaction;
+	};
+
+	/** A flat map from the verb ids to their interactions, kept in the order they were added. Entities only have a
+	handful of interactions, so a scan over the ids is cheaper than anything cleverer. */
+	std::vector<SInteractionEntry> m_interactions;
+
 	IInteractionPtr m_selectedInteraction { IInteractionPtr() };
+
+	/** The cached verb lists, without and with the hidden interactions. */
+	std::vector<const char*> m_verbs [2];
+
+	/** Set when the interactions change, forcing the verb lists to be rebuilt. */
+	bool m_areVerbsDirty { true };
+
+	/** The frame the verb lists were last built on. */
+	int m_verbsFrameId { -1 };
 };
 }
\ No newline at end of file
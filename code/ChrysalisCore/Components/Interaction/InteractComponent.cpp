@@ -2,6 +2,8 @@
 
 #include "InteractComponent.h"
 #include <CryDynamicResponseSystem/IDynamicResponseSystem.h>
+#include "Plugin/ChrysalisCorePlugin.h"
+#include "Utility/GameplayTrace.h"
 #include <Components/Player/Input/PlayerInputComponent.h>
 
 
@@ -73,6 +75,20 @@ void CInteractComponent::Initialize()
 }
 
 
+void CInteractComponent::ProcessEvent(SEntityEvent& event)
+{
+	switch (event.event)
+	{
+		case ENTITY_EVENT_LINK:
+		case ENTITY_EVENT_DELINK:
+		case ENTITY_EVENT_RESET:
+			// Our links have changed, or might have, so the linked entities need to be found again.
+			m_linkedActors.Invalidate();
+			break;
+	}
+}
+
+
 void CInteractComponent::OnResetState()
 {
 	m_interactPtr->SetEnabled(m_isEnabled);
@@ -83,8 +99,8 @@ void CInteractComponent::OnInteractionInteractStart()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("OnInteractionInteractStart fired.");
-		InformAllLinkedEntities(kInteractStartVerb, true);
+		GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractStart, GetEntityId());
+		InformAllLinkedEntities(DRSKeys::kInteractionInteractStart, true);
 
 		// Push the signal out using schematyc.
 		if (auto const pSchematycObject = GetEntity()->GetSchematycObject())
@@ -101,8 +117,8 @@ void CInteractComponent::OnInteractionInteractTick()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("OnInteractionInteractTick fired.");
-		InformAllLinkedEntities(kInteractTickVerb, true);
+		GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractTick, GetEntityId());
+		InformAllLinkedEntities(DRSKeys::kInteractionInteractTick, true);
 
 		SInteractTickSignal interactTickSignal;
 
@@ -124,8 +140,8 @@ void CInteractComponent::OnInteractionInteractComplete()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("OnInteractionInteractComplete fired.");
-		InformAllLinkedEntities(kInteractCompleteVerb, true);
+		GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractComplete, GetEntityId());
+		InformAllLinkedEntities(DRSKeys::kInteractionInteractComplete, true);
 
 		// Push the signal out using schematyc.
 		if (auto const pSchematycObject = GetEntity()->GetSchematycObject())
@@ -138,8 +154,8 @@ void CInteractComponent::OnInteractionInteractCancel()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("OnInteractionInteractCancel fired.");
-		InformAllLinkedEntities(kInteractCancelVerb, true);
+		GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractCancel, GetEntityId());
+		InformAllLinkedEntities(DRSKeys::kInteractionInteractCancel, true);
 
 		// Push the signal out using schematyc.
 		if (auto const pSchematycObject = GetEntity()->GetSchematycObject())
@@ -148,30 +164,28 @@ void CInteractComponent::OnInteractionInteractCancel()
 }
 
 
-void CInteractComponent::InformAllLinkedEntities(string verb, bool isInteractedOn)
+void CInteractComponent::InformAllLinkedEntities(const CHashedString& verb, bool isInteractedOn)
 {
-	// Notify every linked entity.
-	auto* entityLinks = GetEntity()->GetEntityLinks();
-	while (entityLinks)
-	{
-		auto pTargetEntity = gEnv->pEntitySystem->GetEntity(entityLinks->entityId);
-		auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
+	auto pSignalBus = CChrysalisCorePlugin::Get()->GetDRSSignalBus();
+	const auto& linkedEntityIds = m_linkedActors.Get(GetEntity());
+	if (!pSignalBus || linkedEntityIds.empty())
+		return;
 
-		// Create a context variable collection and populate it based on information from the target entity.
-		DRS::IVariableCollectionSharedPtr pContextVariableCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+	// The signal is the same for every link, so there's no need to hash an override more than once.
+	const CHashedString queueSignal = m_queueSignal.empty() ? DRSKeys::kInteractionInteract : CHashedString(m_queueSignal.c_str());
 
-		// It might be useful to know which verb triggered the interaction.
-		pContextVariableCollection->CreateVariable("Verb", CHashedString(verb));
+	// Every linked entity is sent the same context, so we only need to populate one collection.
+	DRS::IVariableCollectionSharedPtr pContextVariableCollection = m_contextCollections.Acquire();
 
-		// The Interact value is always set, regardless of which verb was triggered.
-		pContextVariableCollection->CreateVariable("IsInteractedOn", isInteractedOn);
+	// It might be useful to know which verb triggered the interaction.
+	pContextVariableCollection->SetVariableValue(DRSKeys::kVerb, verb);
 
-		// Queue it and let the DRS handle it now.
-		const string queueSignalVerb = m_queueSignal.empty() ? kQueueSignal : m_queueSignal.c_str();
-		pDrsProxy->GetResponseActor()->QueueSignal(queueSignalVerb, pContextVariableCollection);
+	// The Interact value is always set, regardless of which verb was triggered.
+	pContextVariableCollection->SetVariableValue(DRSKeys::kIsInteractedOn, isInteractedOn);
 
-		// Next please.
-		entityLinks = entityLinks->next;
-	}
+	// Queue it for every linked entity and let the signal bus hand them all to the DRS together. Repeats of
+	// the same verb within a frame are merged.
+	for (const EntityId linkedEntityId : linkedEntityIds)
+		pSignalBus->Queue(linkedEntityId, queueSignal, verb.GetHash(), pContextVariableCollection);
 }
 }
\ No newline at end of file
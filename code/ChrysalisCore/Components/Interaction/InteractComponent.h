@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Components/Interaction/EntityInteractionComponent.h>
+#include "Utility/DRS.h"
+#include "DynamicResponseSystem/DRSSignalBus.h"
 
 
 namespace Chrysalis
@@ -15,6 +17,8 @@ protected:
 
 	// IEntityComponent
 	virtual void Initialize() final;
+	virtual void ProcessEvent(SEntityEvent& event) override;
+	uint64 GetEventMask() const { return BIT64(ENTITY_EVENT_LINK) | BIT64(ENTITY_EVENT_DELINK) | BIT64(ENTITY_EVENT_RESET); }
 	// ~IEntityComponent
 
 public:
@@ -29,13 +33,6 @@ public:
 		return id;
 	}
 
-	const string kQueueSignal { "interaction_interact" };
-	const string kInteractStartVerb { "interaction_interact_start" };
-	const string kInteractTickVerb { "interaction_interact_tick" };
-	const string kInteractCompleteVerb { "interaction_interact_complete" };
-	const string kInteractCancelVerb { "interaction_interact_cancel" };
-
-
 	struct SInteractStartSignal
 	{
 		SInteractStartSignal() = default;
@@ -72,7 +69,7 @@ public:
 	// ~IInteractionInteract
 
 protected:
-	void InformAllLinkedEntities(string verb, bool isInteractedOn);
+	void InformAllLinkedEntities(const CHashedString& verb, bool isInteractedOn);
 
 	virtual void OnResetState();
 
@@ -90,5 +87,11 @@ protected:
 
 	/** Send an alternative queue signal to DRS if the string is not empty. */
 	Schematyc::CSharedString m_queueSignal;
+
+	/** Context collections for the signals we send to linked entities, reused once the DRS is done with them. */
+	DRSUtility::CContextCollectionPool m_contextCollections;
+
+	/** Our linked entities which have response actors, kept until the links change. */
+	CLinkedResponseActors m_linkedActors;
 };
 }
\ No newline at end of file
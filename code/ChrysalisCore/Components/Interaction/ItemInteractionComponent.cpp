@@ -5,6 +5,7 @@
 #include "Components/Player/PlayerComponent.h"
 #include <Components/Player/Input/PlayerInputComponent.h>
 #include <Actor/Character/CharacterComponent.h>
+#include "Utility/GameplayTrace.h"
 
 
 namespace Chrysalis
@@ -67,7 +68,7 @@ void CItemInteractionComponent::OnInteractionItemInspect()
 		return;
 	}
 
-	gEnv->pLog->LogAlways("OnInteractionItemInspect fired.");
+	GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemInspect, GetEntityId());
 	m_inspectionState = InspectionState::eInspecting;
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
@@ -97,7 +98,7 @@ void CItemInteractionComponent::OnInteractionItemPickup()
 		return;
 	}
 
-	gEnv->pLog->LogAlways("OnInteractionItemPickup fired.");
+	GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemPickup, GetEntityId());
 	m_inspectionState = InspectionState::ePickingUp;
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
@@ -118,7 +119,7 @@ void CItemInteractionComponent::OnInteractionItemPickup()
 
 void CItemInteractionComponent::OnInteractionItemDrop()
 {
-	gEnv->pLog->LogAlways("OnInteractionItemDrop fired.");
+	GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemDrop, GetEntityId());
 	m_inspectionState = InspectionState::eDroping;
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
@@ -143,7 +144,7 @@ void CItemInteractionComponent::OnInteractionItemDrop()
 
 void CItemInteractionComponent::OnInteractionItemToss()
 {
-	gEnv->pLog->LogAlways("OnInteractionItemToss fired.");
+	GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemToss, GetEntityId());
 	m_inspectionState = InspectionState::eTossing;
 
 	if (auto pActorComponent = CPlayerComponent::GetLocalActor())
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Entities/Interaction/IEntityInteraction.h"
+#include "Utility/GameplayTrace.h"
 #include <DefaultComponents/Geometry/StaticMeshComponent.h>
 
 class Cry::DefaultComponents::CStaticMeshComponent;
@@ -41,13 +42,13 @@ public:
 	}
 
 	// IInteractionOpenable
-	void OnInteractionOpenableOpen() override { gEnv->pLog->LogAlways("OnInteractionOpenableOpen fired."); };
-	void OnInteractionOpenableClose() override { gEnv->pLog->LogAlways("OnInteractionOpenableClose fired."); };
+	void OnInteractionOpenableOpen() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::OpenableOpen, GetEntityId()); };
+	void OnInteractionOpenableClose() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::OpenableClose, GetEntityId()); };
 	// ~IInteractionOpenable
 
 	// IInteractionLockable
-	void OnInteractionLockableLock() override { gEnv->pLog->LogAlways("OnInteractionLockableLock fired."); };
-	void OnInteractionLockableUnlock() override { gEnv->pLog->LogAlways("OnInteractionLockableUnlock fired."); };
+	void OnInteractionLockableLock() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::LockableLock, GetEntityId()); };
+	void OnInteractionLockableUnlock() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::LockableUnlock, GetEntityId()); };
 	// ~IInteractionLockable
 
 	// Called on entity spawn, or when the state of the entity changes in Editor
@@ -3,10 +3,10 @@
 #include "ActionRPGCameraComponent.h"
 #include "Components/Player/PlayerComponent.h"
 #include <Components/Player/Input/PlayerInputComponent.h>
-#include <Utility/StringConversions.h>
 #include <Console/CVars.h>
 #include <Actor/ActorComponent.h>
 #include <CryGame/GameUtils.h>
+#include <Plugin/ChrysalisCorePlugin.h>
 
 
 namespace Chrysalis
@@ -27,10 +27,21 @@ void CActionRPGCameraComponent::ReflectType(Schematyc::CTypeDesc<CActionRPGCamer
 }
 
 
+CActionRPGCameraComponent::~CActionRPGCameraComponent()
+{
+	// Make sure no deferred results are delivered to us after we're gone.
+	if (auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService())
+		pRaycastService->Cancel(this);
+
+	ListenToTarget(m_targetEntityID, INVALID_ENTITYID);
+}
+
+
 void CActionRPGCameraComponent::Initialize()
 {
 	// It's a good idea to use the entity as a default for our target entity.
 	m_targetEntityID = GetEntityId();
+	ListenToTarget(INVALID_ENTITYID, m_targetEntityID);
 
 	// We are usually hosted in the same entity as a camera manager. Use it if you can find one.
 	m_pCameraManager = GetEntity()->GetComponent<CCameraManagerComponent>();
@@ -211,7 +222,7 @@ void CActionRPGCameraComponent::UpdateThirdPerson()
 
 				// Work out where to place the new initial position. We will be using a unit vector facing forward Y
 				// as the starting place and applying rotations from the target bone and player camera movements.
-				Vec3 viewPositionOffset = Vec3FromString(g_cvars.m_actionRPGCameraViewPositionOffset->GetString());
+				const Vec3& viewPositionOffset = g_cvars.m_actionRPGCameraViewPositionOffset.Get();
 				Vec3 vecViewPosition = vecTargetAimPosition + (quatTargetRotation * (FORWARD_DIRECTION * zoomDistance)) + quatTargetRotation * viewPositionOffset;
 
 				// By default, we try and aim the camera at the target, taking into account the current mouse yaw and pitch values.
@@ -233,13 +244,13 @@ void CActionRPGCameraComponent::UpdateThirdPerson()
 				}
 
 				// Apply a final translation to both the view position and the aim position.
-				Vec3 aimPositionOffset = Vec3FromString(g_cvars.m_actionRPGCameraAimPositionOffset->GetString());
+				const Vec3& aimPositionOffset = g_cvars.m_actionRPGCameraAimPositionOffset.Get();
 				vecViewPosition += quatViewRotation * aimPositionOffset;
 
 				// Gimbal style rotation after it's moved into it's initial position.
 				Quat quatOrbitRotation = quatViewRotation * quatPostTransYP;
 
-				// Perform a collision detection. Note, any collisions will disallow use of interpolated camera movement.
+				// Perform a collision detection. The camera pulls in immediately on a collision and eases back out afterwards.
 				CollisionDetection(vecTargetAimPosition, vecViewPosition);
 
 #if defined(_DEBUG)
@@ -299,6 +310,7 @@ void CActionRPGCameraComponent::ToggleFirstPerson()
 void CActionRPGCameraComponent::AttachToEntity(EntityId entityId)
 {
 	// Store the target entity.
+	ListenToTarget(m_targetEntityID, entityId);
 	m_targetEntityID = entityId;
 
 	// No interpolation, since the camera needs to jump into position.
@@ -319,6 +331,11 @@ void CActionRPGCameraComponent::AttachToEntity(EntityId entityId)
 
 	// Reset this.
 	m_quatLastTargetRotation = m_quatTargetRotation;
+
+	// The collision distance has to start over for the new target.
+	RefreshCollisionSkipEntities();
+	m_collisionDistance = -1.0f;
+	m_isCollisionPulledIn = false;
 }
 
 
@@ -327,6 +344,9 @@ void CActionRPGCameraComponent::OnActivate()
 	m_EventMask |= BIT64(ENTITY_EVENT_UPDATE);
 	GetEntity()->UpdateComponentEventMask(this);
 	ResetCamera();
+	RefreshCollisionSkipEntities();
+	m_collisionDistance = -1.0f;
+	m_isCollisionPulledIn = false;
 
 	// Avoid interpolation after activating the camera, there is no-where to interpolate from.
 	m_skipInterpolation = true;
@@ -402,27 +422,217 @@ Vec3 CActionRPGCameraComponent::GetTargetAimPosition(IEntity* const pEntity)
 
 bool CActionRPGCameraComponent::CollisionDetection(const Vec3& Goal, Vec3& CameraPosition)
 {
-	bool updatedCameraPosition = false;
-
-	// Skip the target actor for this.
-	ray_hit rayhit;
-	static IPhysicalEntity* pSkipEnts [10];
-	pSkipEnts [0] = gEnv->pEntitySystem->GetEntity(m_targetEntityID)->GetPhysics();
-
-	// Perform the ray cast.
-	int hits = gEnv->pPhysicalWorld->RayWorldIntersection(Goal,
-		CameraPosition - Goal,
-		ent_static | ent_sleeping_rigid | ent_rigid | ent_independent | ent_terrain,
-		rwi_stop_at_pierceable | rwi_colltype_any,
-		&rayhit,
-		1, pSkipEnts, 2);
-
-	if (hits)
+	const Vec3 toCamera = CameraPosition - Goal;
+	const float desiredDistance = toCamera.GetLength();
+	if (desiredDistance < FLT_EPSILON)
+		return false;
+
+	// The target may not have been physicalised when we attached to it, or may have been re-physicalised since.
+	if (m_isCollisionSkipListStale || (m_collisionSkipEntityCount == 0))
+		RefreshCollisionSkipEntities();
+
+	// Sweep a sphere rather than cast a ray, so we don't slip past the edges of geometry.
+	primitives::sphere sphere;
+	sphere.center = Goal;
+	sphere.r = g_cvars.m_actionRPGCameraCollisionRadius;
+
+	geom_contact* pContact = nullptr;
+	IPhysicalWorld::SPWIParams params;
+	params.itype = primitives::sphere::type;
+	params.pprim = &sphere;
+	params.sweepDir = toCamera;
+	params.entTypes = ent_static | ent_sleeping_rigid | ent_rigid | ent_independent | ent_terrain;
+	params.geomFlagsAny = geom_colltype0;
+	params.ppcontact = &pContact;
+	params.pSkipEnts = m_collisionSkipEntities;
+	params.nSkipEnts = m_collisionSkipEntityCount;
+
+	float targetDistance = desiredDistance;
+	bool hasHit = false;
+	{
+		WriteLockCond lockContacts;
+		if ((gEnv->pPhysicalWorld->PrimitiveWorldIntersection(params, &lockContacts) > 0.0f) && pContact)
+		{
+			targetDistance = clamp_tpl(pContact->t, 0.0f, desiredDistance);
+			hasHit = true;
+		}
+	}
+
+	if (g_cvars.m_actionRPGCameraCollisionProbes)
+		QueueCollisionProbes(Goal, CameraPosition);
+	else
+		m_isProbeBlocked = false;
+
+	// Tracked every frame, even when no probes were queued, so the prediction is always based on one frame's movement.
+	m_vecLastUnobstructedPosition = CameraPosition;
+
+	if ((m_collisionDistance < 0.0f) || m_skipInterpolation)
+	{
+		// No history to smooth from.
+		m_collisionDistance = targetDistance;
+	}
+	else if (targetDistance <= m_collisionDistance)
+	{
+		// Always pull in straight away, seeing through walls is far worse than a sudden move.
+		m_collisionDistance = targetDistance;
+	}
+	else if (!m_isCollisionPulledIn)
+	{
+		// Nothing is in the way, so follow the zoom exactly.
+		m_collisionDistance = targetDistance;
+	}
+	else if (!m_isProbeBlocked && (!hasHit || (targetDistance - m_collisionDistance > g_cvars.m_actionRPGCameraCollisionHysteresis)))
+	{
+		// Ease back out, but only once there's a worthwhile amount of room, to keep from hunting back and forth.
+		Interpolate(m_collisionDistance, targetDistance, g_cvars.m_actionRPGCameraCollisionEaseOutSpeed, gEnv->pTimer->GetFrameTime());
+		if (targetDistance - m_collisionDistance < 0.01f)
+			m_collisionDistance = targetDistance;
+	}
+
+	m_isCollisionPulledIn = m_collisionDistance < desiredDistance;
+
+#if defined(_DEBUG)
+	if (g_cvars.m_actionRPGCameraDebug)
+	{
+		gEnv->pRenderer->GetIRenderAuxGeom()->DrawSphere(Goal + toCamera * (targetDistance / desiredDistance), sphere.r, hasHit ? ColorB(255, 0, 0, 64) : ColorB(0, 255, 0, 64));
+		CryWatch("Camera collision: target %.2f, current %.2f, desired %.2f, probes %s", targetDistance, m_collisionDistance, desiredDistance, m_isProbeBlocked ? "blocked" : "clear");
+	}
+#endif
+
+	if (m_isCollisionPulledIn)
+	{
+		CameraPosition = Goal + toCamera * (m_collisionDistance / desiredDistance);
+		return true;
+	}
+
+	return false;
+}
+
+
+void CActionRPGCameraComponent::RefreshCollisionSkipEntities()
+{
+	m_collisionSkipEntityCount = 0;
+	m_isCollisionSkipListStale = false;
+
+	auto pTargetEntity = gEnv->pEntitySystem->GetEntity(m_targetEntityID);
+	if (!pTargetEntity)
+		return;
+
+	if (auto pPhysics = pTargetEntity->GetPhysics())
+		m_collisionSkipEntities [m_collisionSkipEntityCount++] = pPhysics;
+
+	// Anything the target is carrying shouldn't block the view either.
+	for (int i = 0; (i < pTargetEntity->GetChildCount()) && (m_collisionSkipEntityCount < maxCollisionSkipEntities); ++i)
+	{
+		if (auto pChildPhysics = pTargetEntity->GetChild(i)->GetPhysics())
+			m_collisionSkipEntities [m_collisionSkipEntityCount++] = pChildPhysics;
+	}
+}
+
+
+void CActionRPGCameraComponent::ListenToTarget(EntityId oldTargetEntityId, EntityId newTargetEntityId)
+{
+	if (oldTargetEntityId == newTargetEntityId)
+		return;
+
+	if (oldTargetEntityId != INVALID_ENTITYID)
 	{
-		CameraPosition = rayhit.pt;
-		updatedCameraPosition = true;
+		gEnv->pEntitySystem->RemoveEntityEventListener(oldTargetEntityId, ENTITY_EVENT_PHYSICS_CHANGE, this);
+		gEnv->pEntitySystem->RemoveEntityEventListener(oldTargetEntityId, ENTITY_EVENT_ATTACH, this);
+		gEnv->pEntitySystem->RemoveEntityEventListener(oldTargetEntityId, ENTITY_EVENT_DETACH, this);
 	}
 
-	return updatedCameraPosition;
+	if (newTargetEntityId != INVALID_ENTITYID)
+	{
+		gEnv->pEntitySystem->AddEntityEventListener(newTargetEntityId, ENTITY_EVENT_PHYSICS_CHANGE, this);
+		gEnv->pEntitySystem->AddEntityEventListener(newTargetEntityId, ENTITY_EVENT_ATTACH, this);
+		gEnv->pEntitySystem->AddEntityEventListener(newTargetEntityId, ENTITY_EVENT_DETACH, this);
+	}
+}
+
+
+void CActionRPGCameraComponent::QueueCollisionProbes(const Vec3& goal, const Vec3& cameraPosition)
+{
+	const int frameId = gEnv->nMainFrameID;
+
+	// Wait for the last batch to complete. Probes over the quota are dropped by the service, so give up eventually.
+	if ((m_probesOutstanding > 0) && (frameId - m_probeBatchFrameId < 4))
+		return;
+
+	auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService();
+	if (!pRaycastService)
+		return;
+
+	// Aim the probes where the camera will be in a few frames, if it keeps moving the way it is. This has to work from
+	// where the camera wanted to be last frame, not where the collision put it, or being pulled in looks like movement
+	// and throws the probes into whatever pulled us in.
+	// There's nothing to predict from until the collision has a frame of history.
+	const bool hasHistory = (m_collisionDistance >= 0.0f) && !m_skipInterpolation;
+	const Vec3 predictedPosition = hasHistory ? cameraPosition + (cameraPosition - m_vecLastUnobstructedPosition) * 4.0f : cameraPosition;
+
+	// The camera never goes further out than it wants to be, so there's no point probing beyond that.
+	Vec3 toCamera = predictedPosition - goal;
+	if (toCamera.IsZero())
+		return;
+
+	const float desiredDistance = (cameraPosition - goal).GetLength();
+	if (toCamera.GetLengthSquared() > sqr(desiredDistance))
+		toCamera.SetLength(desiredDistance);
+
+	// A ring of probes, spaced out a little wider than the collision sphere.
+	const Vec3 forward = toCamera.GetNormalized();
+	const Vec3 right = forward.GetOrthogonal().GetNormalized();
+	const Vec3 up = forward.Cross(right);
+	const float spread = g_cvars.m_actionRPGCameraCollisionRadius * 2.0f;
+	const Vec3 offsets [collisionProbeCount] = { right * spread, -right * spread, up * spread, -up * spread };
+
+	SRaycastRequest request;
+	request.origin = goal;
+	request.objectTypes = ent_static | ent_sleeping_rigid | ent_rigid | ent_independent | ent_terrain;
+	// Probe against the same collision class and skip the same entities as the sweep, or the two will disagree.
+	request.flags = rwi_stop_at_pierceable | rwi_colltype_any | (geom_colltype0 << rwi_colltype_bit);
+	request.pSkipEntities = m_collisionSkipEntities;
+	request.skipEntityCount = m_collisionSkipEntityCount;
+
+	m_probeBatchTicket = kInvalidRaycastTicket;
+	m_probesOutstanding = 0;
+	m_isProbeBatchBlocked = false;
+	m_probeBatchFrameId = frameId;
+
+	for (const auto& offset : offsets)
+	{
+		request.direction = toCamera + offset;
+
+		const TRaycastTicket ticket = pRaycastService->Queue(request, this);
+		if (ticket != kInvalidRaycastTicket)
+		{
+			if (m_probeBatchTicket == kInvalidRaycastTicket)
+				m_probeBatchTicket = ticket;
+
+			m_probesOutstanding++;
+		}
+	}
+}
+
+
+void CActionRPGCameraComponent::OnEntityEvent(IEntity* pEntity, SEntityEvent& event)
+{
+	// The skip list holds physical entity pointers, which go bad when the target or anything attached to it is
+	// re-physicalised, so rebuild it before the next sweep.
+	m_isCollisionSkipListStale = true;
+}
+
+
+void CActionRPGCameraComponent::OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result)
+{
+	// Ignore anything left over from a batch we've given up on.
+	if ((m_probeBatchTicket == kInvalidRaycastTicket) || (ticket < m_probeBatchTicket) || (m_probesOutstanding == 0))
+		return;
+
+	if ((result.hitCount > 0) && (result.hits [0].dist >= 0.0f))
+		m_isProbeBatchBlocked = true;
+
+	if (--m_probesOutstanding == 0)
+		m_isProbeBlocked = m_isProbeBatchBlocked;
+}
 }
-}
\ No newline at end of file
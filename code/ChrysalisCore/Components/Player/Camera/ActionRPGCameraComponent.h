@@ -4,6 +4,7 @@
 #include <CrySystem/VR/IHMDDevice.h>
 #include <CrySystem/VR/IHMDManager.h>
 #include "../Camera/CameraManagerComponent.h"
+#include <Game/Physics/RaycastService.h>
 
 
 namespace Chrysalis
@@ -11,6 +12,8 @@ namespace Chrysalis
 /** A camera suitable for use with action RPG style games. */
 class CActionRPGCameraComponent
 	: public ICameraComponent
+	, public IRaycastReceiver
+	, public IEntityEventListener
 {
 protected:
 	friend CChrysalisCorePlugin;
@@ -25,7 +28,7 @@ protected:
 
 public:
 	CActionRPGCameraComponent() {}
-	virtual ~CActionRPGCameraComponent() {}
+	virtual ~CActionRPGCameraComponent();
 
 	static void ReflectType(Schematyc::CTypeDesc<CActionRPGCameraComponent>& desc);
 
@@ -58,6 +61,16 @@ public:
 	bool IsViewFirstPerson() const override { return m_isFirstPerson; };
 
 
+	// IRaycastReceiver
+	void OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result) override;
+	// ~IRaycastReceiver
+
+
+	// IEntityEventListener
+	void OnEntityEvent(IEntity* pEntity, SEntityEvent& event) override;
+	// ~IEntityEventListener
+
+
 	// ***
 	// *** CActionRPGCameraComponent
 	// ***
@@ -79,17 +92,45 @@ public:
 
 
 	/**
-	Performs a very simple collision detection. The camera view position is updated to the best viewing location
-	based on the results of the raycasting.
-	
+	Sweeps a sphere from the goal to the camera, pulling the camera in towards the goal if it hits anything. The camera
+	pulls in immediately, but eases back out, and only once there's enough room and the predictive probes are clear.
+
 	\param 		   	Goal		   The goal.
 	\param [in,out]	CameraPosition The camera position.
-	
-	\return true if it succeeds, false if it fails.
+
+	\return true if the camera position was changed.
 	**/
 	bool CollisionDetection(const Vec3& Goal, Vec3& CameraPosition);
 
 private:
+	/** The number of probes we cast around the position the camera is heading towards. */
+	static const int collisionProbeCount { 4 };
+
+	/** The most physical entities we skip when checking for collisions. */
+	static const int maxCollisionSkipEntities { SRaycastRequest::maxSkipEntities };
+
+
+	/** Rebuilds the list of physical entities, the target and anything attached to it, which the camera ignores. */
+	void RefreshCollisionSkipEntities();
+
+
+	/**
+	Moves our entity event listener from one target to another, so we hear when the target's physics changes.
+
+	\param	oldTargetEntityId Identifier for the old target entity, or INVALID_ENTITYID.
+	\param	newTargetEntityId Identifier for the new target entity, or INVALID_ENTITYID.
+	**/
+	void ListenToTarget(EntityId oldTargetEntityId, EntityId newTargetEntityId);
+
+
+	/**
+	Queues a ring of deferred ray-casts towards where the camera is heading, if the previous batch has completed.
+
+	\param	goal		   The goal.
+	\param	cameraPosition The unobstructed camera position.
+	**/
+	void QueueCollisionProbes(const Vec3& goal, const Vec3& cameraPosition);
+
 
 	void Update();
 	void UpdateZoom();
@@ -108,6 +149,9 @@ private:
 	/** Position of the camera during the last update. */
 	Vec3 m_vecLastPosition { ZERO };
 
+	/** Position the camera wanted to be at during the last update, before collisions pulled it in. */
+	Vec3 m_vecLastUnobstructedPosition { ZERO };
+
 	/** Rotation of the camera during the last update. */
 	Quat m_quatLastTargetRotation { IDENTITY };
 
@@ -156,5 +200,33 @@ private:
 
 	/** Is the camera view in first person mode? **/
 	bool m_isFirstPerson { true };
+
+	/** Physical entities which are ignored by the collision sweep. Built when we attach to a target. */
+	IPhysicalEntity* m_collisionSkipEntities [maxCollisionSkipEntities];
+	int m_collisionSkipEntityCount { 0 };
+
+	/** Set when the target's physics, or what is attached to it, has changed since the skip list was built. */
+	bool m_isCollisionSkipListStale { false };
+
+	/** The current distance from the goal to the camera, after collisions. Negative when there is no distance yet. */
+	float m_collisionDistance { -1.0f };
+
+	/** True while the camera is being held closer to the goal than it wants to be. */
+	bool m_isCollisionPulledIn { false };
+
+	/** The first ticket in the current batch of probes. Results from earlier batches are ignored. */
+	TRaycastTicket m_probeBatchTicket { kInvalidRaycastTicket };
+
+	/** The number of probes from the current batch which have yet to report. */
+	int m_probesOutstanding { 0 };
+
+	/** The frame the current batch of probes was queued on. Probes can be dropped, so we don't wait forever. */
+	int m_probeBatchFrameId { 0 };
+
+	/** True if any probe in the current batch has hit something. */
+	bool m_isProbeBatchBlocked { false };
+
+	/** True if any probe in the last completed batch hit something. */
+	bool m_isProbeBlocked { false };
 };
 }
\ No newline at end of file
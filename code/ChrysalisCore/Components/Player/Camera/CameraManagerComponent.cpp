@@ -6,7 +6,6 @@
 #include "FirstPersonCameraComponent.h"
 #include <Actor/Character/CharacterComponent.h>
 #include "Components/Player/PlayerComponent.h"
-#include <Utility/StringConversions.h>
 #include <Console/CVars.h>
 
 
@@ -154,7 +153,7 @@ bool CCameraManagerComponent::IsViewFirstPerson() const
 CCameraManagerComponent::CCameraManagerComponent()
 {
 	// We'll take an initial value for the debug view offset from cvars.
-	m_interactiveViewOffset = Vec3FromString(g_cvars.m_actionRPGCameraViewPositionOffset->GetString());
+	m_interactiveViewOffset = g_cvars.m_actionRPGCameraViewPositionOffset.Get();
 
 	// Start with a known clean state.
 	memset(m_cameraModes, 0, sizeof(m_cameraModes));
@@ -190,7 +189,7 @@ void CCameraManagerComponent::RegisterActionMaps()
 
 Vec3 CCameraManagerComponent::GetViewOffset()
 {
-	return Vec3FromString(g_cvars.m_actionRPGCameraViewPositionOffset->GetString()) + m_interactiveViewOffset;
+	return g_cvars.m_actionRPGCameraViewPositionOffset.Get() + m_interactiveViewOffset;
 }
 
 
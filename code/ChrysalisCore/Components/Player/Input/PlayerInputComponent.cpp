@@ -8,6 +8,7 @@
 #include "../Camera/CameraManagerComponent.h"
 #include "../Camera/ICameraComponent.h"
 #include <Console/CVars.h>
+#include <array>
 
 
 namespace Chrysalis
@@ -15,6 +16,53 @@ namespace Chrysalis
 
 #define IF_ACTOR_DO(run_action) if (auto pActorComponent = CPlayerComponent::GetLocalActor()) { pActorComponent->run_action(); }
 
+namespace
+{
+/** Input rates and filters were tuned at this frame rate. They are scaled to suit the actual frame time. */
+static const float inputReferenceRate = 60.0f;
+
+/** Never accumulate more than this much time (seconds) in one go e.g. after a long hitch. */
+static const float maxInputAccumulationTime = 0.25f;
+
+/** One entry for each combination of the four movement flags. */
+static const int movementDirectionCount = 16;
+
+/** A movement direction relative to the base rotation. */
+struct SMovementDirection
+{
+	Quat rotation { IDENTITY };
+	bool isValid { false };
+};
+
+
+std::array<SMovementDirection, movementDirectionCount> BuildMovementDirections()
+{
+	std::array<SMovementDirection, movementDirectionCount> directions;
+
+	auto setDirection = [&directions](TInputFlags flags, float degrees)
+	{
+		directions [flags].rotation = Quat::CreateRotationZ(DEG2RAD(degrees));
+		directions [flags].isValid = true;
+	};
+
+	// Any other combination, such as forward and backward together, cancels out to no movement.
+	setDirection((TInputFlags)EInputFlag::Forward, 0.0f);
+	setDirection((TInputFlags)EInputFlag::Forward | (TInputFlags)EInputFlag::Right, 45.0f);
+	setDirection((TInputFlags)EInputFlag::Right, 90.0f);
+	setDirection((TInputFlags)EInputFlag::Backward | (TInputFlags)EInputFlag::Right, 135.0f);
+	setDirection((TInputFlags)EInputFlag::Backward, 180.0f);
+	setDirection((TInputFlags)EInputFlag::Backward | (TInputFlags)EInputFlag::Left, 225.0f);
+	setDirection((TInputFlags)EInputFlag::Left, 270.0f);
+	setDirection((TInputFlags)EInputFlag::Forward | (TInputFlags)EInputFlag::Left, 315.0f);
+
+	return directions;
+}
+
+
+static const std::array<SMovementDirection, movementDirectionCount> movementDirections = BuildMovementDirections();
+}
+
+
 
 void CPlayerInputComponent::Register(Schematyc::CEnvRegistrationScope& componentScope)
 {
@@ -211,81 +259,101 @@ high priority.
 **/
 void CPlayerInputComponent::Update()
 {
-	static float frameTime = gEnv->pTimer->GetFrameTime();
+	const float frameTime = gEnv->pTimer->GetFrameTime();
+
+	// Apply every sample captured since the last update, in the order they arrived. Thumb stick rotation is integrated
+	// between the samples, so it turns at the same speed regardless of the frame rate.
+	SInputSample sample;
+	while (m_inputSamples.Pop(sample))
+	{
+		switch (sample.type)
+		{
+			case EInputSampleType::MouseYaw:
+				m_mouseYawDelta += sample.value;
+				break;
+
+			case EInputSampleType::MousePitch:
+				m_mousePitchDelta += sample.value;
+				break;
+
+			case EInputSampleType::XiYaw:
+				AccumulateXiRotation(sample.timestamp);
+				m_xiYawRate = sample.value;
+				break;
+
+			case EInputSampleType::XiPitch:
+				AccumulateXiRotation(sample.timestamp);
+				m_xiPitchRate = sample.value;
+				break;
+		}
+	}
+
+	AccumulateXiRotation(gEnv->pTimer->GetAsyncTime());
+
+	// The filters are for a reference frame. Scale them to the actual frame time, or high frame rates would filter out
+	// slow movements altogether.
+	const float filterScale = frameTime * inputReferenceRate;
+	const float pitchFilter = m_pitchFilter * filterScale;
+	const float yawFilter = m_yawFilter * filterScale;
 
 	// We can just add up all the acculmated requests to find out how much pitch / yaw is being requested.
 	// It's also a good time to filter out any small movement requests to stabilise the camera / etc.
 	m_lastPitchDelta = m_mousePitchDelta + m_xiPitchDelta;
-	if (std::abs(m_lastPitchDelta) < m_pitchFilter)
+	if (std::abs(m_lastPitchDelta) < pitchFilter)
 		m_lastPitchDelta = 0.0f;
 	m_lastYawDelta = m_mouseYawDelta + m_xiYawDelta;
-	if (std::abs(m_lastYawDelta) < m_yawFilter)
+	if (std::abs(m_lastYawDelta) < yawFilter)
 		m_lastYawDelta = 0.0f;
 
 	// Track the last values for mouse and xbox inputs. They're filtered individually for low level noise.
-	m_lastMousePitchDelta = std::abs(m_mousePitchDelta) >= m_pitchFilter ? m_mousePitchDelta : 0.0f;
-	m_lastMouseYawDelta = std::abs(m_mouseYawDelta) >= m_yawFilter ? m_mouseYawDelta : 0.0f;
-	m_lastXiPitchDelta = std::abs(m_xiPitchDelta) >= m_pitchFilter ? m_xiPitchDelta : 0.0f;
-	m_lastXiYawDelta = std::abs(m_xiYawDelta) >= m_yawFilter ? m_xiYawDelta : 0.0f;
+	m_lastMousePitchDelta = std::abs(m_mousePitchDelta) >= pitchFilter ? m_mousePitchDelta : 0.0f;
+	m_lastMouseYawDelta = std::abs(m_mouseYawDelta) >= yawFilter ? m_mouseYawDelta : 0.0f;
+	m_lastXiPitchDelta = std::abs(m_xiPitchDelta) >= pitchFilter ? m_xiPitchDelta : 0.0f;
+	m_lastXiYawDelta = std::abs(m_xiYawDelta) >= yawFilter ? m_xiYawDelta : 0.0f;
 
 	// Circle of life!
 	m_mousePitchDelta = m_mouseYawDelta = 0.0f;
+	m_xiPitchDelta = m_xiYawDelta = 0.0f;
 }
 
 
-Vec3 CPlayerInputComponent::GetMovement(const Quat& baseRotation)
+void CPlayerInputComponent::PushInputSample(EInputSampleType type, float value)
 {
-	bool allowMovement = true;
-	Quat quatRelativeDirection;
-	Vec3 vecMovement = Vec3(ZERO);
+	SInputSample sample;
+	sample.timestamp = gEnv->pTimer->GetAsyncTime();
+	sample.value = value;
+	sample.type = type;
 
-	// Take the mask and turn it into a vector to indicate the direction we need to pan independent of the present
-	// camera direction. 
-	switch (m_inputFlags)
+	if (!m_inputSamples.Push(sample))
 	{
-		case (TInputFlags)EInputFlag::Forward:
-			quatRelativeDirection = Quat::CreateIdentity();
-			break;
-
-		case ((TInputFlags)EInputFlag::Forward | (TInputFlags)EInputFlag::Right):
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(45.0f));
-			break;
-
-		case (TInputFlags)EInputFlag::Right:
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(90.0f));
-			break;
+		CRY_ASSERT_MESSAGE(false, "PlayerInput: The input sample queue is full, dropping a sample.");
+	}
+}
 
-		case ((TInputFlags)EInputFlag::Backward | (TInputFlags)EInputFlag::Right):
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(135.0f));
-			break;
 
-		case (TInputFlags)EInputFlag::Backward:
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(180.0f));
-			break;
+void CPlayerInputComponent::AccumulateXiRotation(const CTimeValue& time)
+{
+	const float elapsed = clamp_tpl((time - m_xiAccumulatedTime).GetSeconds(), 0.0f, maxInputAccumulationTime);
+	const float referenceFrames = elapsed * inputReferenceRate;
 
-		case ((TInputFlags)EInputFlag::Backward | (TInputFlags)EInputFlag::Left):
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(225.0f));
-			break;
+	m_xiPitchDelta += m_xiPitchRate * referenceFrames;
+	m_xiYawDelta += m_xiYawRate * referenceFrames;
 
-		case (TInputFlags)EInputFlag::Left:
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(270.0f));
-			break;
+	if (time > m_xiAccumulatedTime)
+		m_xiAccumulatedTime = time;
+}
 
-		case ((TInputFlags)EInputFlag::Forward | (TInputFlags)EInputFlag::Left):
-			quatRelativeDirection = Quat::CreateRotationZ(DEG2RAD(315.0f));
-			break;
 
-		default:
-			quatRelativeDirection = Quat::CreateIdentity();
-			allowMovement = false;
-			break;
-	}
+Vec3 CPlayerInputComponent::GetMovement(const Quat& baseRotation)
+{
+	// Take the mask and turn it into a rotation to indicate the direction we need to pan independent of the present
+	// camera direction.
+	const SMovementDirection& direction = movementDirections [m_inputFlags & (movementDirectionCount - 1)];
+	if (!direction.isValid)
+		return Vec3(ZERO);
 
 	// Create a vector based on key direction. This is computed in local space for the base rotation.
-	if (allowMovement)
-		vecMovement = Vec3(baseRotation.GetFwdX(), baseRotation.GetFwdY(), 0.0f).GetNormalized() * quatRelativeDirection;
-
-	return vecMovement;
+	return Vec3(baseRotation.GetFwdX(), baseRotation.GetFwdY(), 0.0f).GetNormalized() * direction.rotation;
 }
 
 
@@ -353,7 +421,7 @@ void CPlayerInputComponent::OnActionRotateYaw(int activationMode, float value)
 	float mouseSensitivity = 0.00032f * max(0.01f, cl_mouseSensitivity * m_mousePitchYawSensitivity);
 
 	// Add the yaw delta.
-	m_mouseYawDelta -= value * mouseSensitivity;
+	PushInputSample(EInputSampleType::MouseYaw, -value * mouseSensitivity);
 }
 
 
@@ -370,33 +438,27 @@ void CPlayerInputComponent::OnActionRotatePitch(int activationMode, float value)
 
 	// Add the delta, taking into account mouse inversion.  Clamp the result.
 	float invertYAxis = m_mouseInvertPitch ? -1.0f : 1.0f;
-	m_mousePitchDelta += value * mouseSensitivity * invertYAxis;
+	PushInputSample(EInputSampleType::MousePitch, value * mouseSensitivity * invertYAxis);
 }
 
 
-// XBox controller rotation is handled differently. Movements on the thumb stick set a value for
-// rotation that should be applied every frame update.
+// XBox controller rotation is handled differently. Movements on the thumb stick set a rate of rotation, which is
+// applied over time until the stick moves again.
 void CPlayerInputComponent::OnActionXIRotateYaw(int activationMode, float value)
 {
 	float radians = DEG2RAD(value);
 
-	if (std::abs(radians) < m_xiYawFilter)
-		m_xiYawDelta = 0.0f;
-	else
-		m_xiYawDelta = radians;
+	PushInputSample(EInputSampleType::XiYaw, (std::abs(radians) < m_xiYawFilter) ? 0.0f : radians);
 }
 
 
-// Xbox controller pitch is handled differently. Movements on the thumb stick set a value for
-// pitch that should be applied every frame update.
+// Xbox controller pitch is handled differently. Movements on the thumb stick set a rate of pitch, which is
+// applied over time until the stick moves again.
 void CPlayerInputComponent::OnActionXIRotatePitch(int activationMode, float value)
 {
 	float radians = DEG2RAD(value);
 
-	if (std::abs(radians) < m_xiPitchFilter)
-		m_xiPitchDelta = 0.0f;
-	else
-		m_xiPitchDelta = radians;
+	PushInputSample(EInputSampleType::XiPitch, (std::abs(radians) < m_xiPitchFilter) ? 0.0f : radians);
 }
 
 
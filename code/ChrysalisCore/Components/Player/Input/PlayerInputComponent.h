@@ -4,6 +4,7 @@
 #include <IActionMapManager.h>
 #include "Components/Player/PlayerComponent.h"
 #include <DefaultComponents/Input/InputComponent.h>
+#include <Utility/SpscQueue.h>
 
 
 namespace Chrysalis
@@ -258,9 +259,48 @@ private:
 
 	void HandleInputFlagChange(TInputFlags flags, int activationMode, EInputFlagType type = EInputFlagType::Hold);
 
+
+	/** The analogue inputs which are sampled. */
+	enum class EInputSampleType : uint8
+	{
+		MouseYaw,
+		MousePitch,
+		XiYaw,
+		XiPitch
+	};
+
+
+	/** A single timestamped reading from an analogue input. */
+	struct SInputSample
+	{
+		CTimeValue timestamp;
+		float value { 0.0f };
+		EInputSampleType type { EInputSampleType::MouseYaw };
+	};
+
+
+	/**
+	Queues a sample for the next update. Samples are captured as the input arrives, which may be many times per frame.
+
+	\param	type  The type of input.
+	\param	value The value.
+	**/
+	void PushInputSample(EInputSampleType type, float value);
+
+
+	/**
+	Accumulates the rotation from the XBox controller thumb stick up until the given time, at the rates it was last set to.
+
+	\param	time The time to accumulate up until.
+	**/
+	void AccumulateXiRotation(const CTimeValue& time);
+
 	/** The input component */
 	Cry::DefaultComponents::CInputComponent* m_pInputComponent { nullptr };
 
+	/** Input samples captured since the last update. The action handlers produce them and Update consumes them. */
+	CSpscQueue<SInputSample, 1024> m_inputSamples;
+
 	/** The movement mask. */
 	TInputFlags m_inputFlags { (TInputFlags) EInputFlag::None };
 
@@ -288,20 +328,32 @@ private:
 	float m_lastMouseYawDelta { 0.0f };
 
 	/**
-	This tracks the delta pitch (radians) from the XBox controller, if one is present.
+	This tracks the delta pitch (radians) from the XBox controller, if one is present. It's accumulated from the stick
+	rate over the time since the last update.
 	*/
 	float m_xiPitchDelta { 0.0f };
 	float m_lastXiPitchDelta { 0.0f };
 
 	/**
-	This tracks the delta yaw (radians) from the XBox controller, if one is present.
+	This tracks the delta yaw (radians) from the XBox controller, if one is present. It's accumulated from the stick
+	rate over the time since the last update.
 	*/
 	float m_xiYawDelta { 0.0f };
 	float m_lastXiYawDelta { 0.0f };
 
+	/** The current rate of pitch from the XBox controller, in radians per reference frame. */
+	float m_xiPitchRate { 0.0f };
+
+	/** The current rate of yaw from the XBox controller, in radians per reference frame. */
+	float m_xiYawRate { 0.0f };
+
+	/** The time up until which the XBox controller rotation has been accumulated. */
+	CTimeValue m_xiAccumulatedTime;
+
 	/**
 	Filter pitch adjustments below this threshold (radians). This is useful for removing slight amounts of jitter on
-	mouse movements and XBox controllers, making it easier to perform precise movements in only one axis.
+	mouse movements and XBox controllers, making it easier to perform precise movements in only one axis. The filters
+	are for a reference frame, and are scaled to suit the actual frame time.
 	*/
 	float m_pitchFilter { 0.0001f };
 
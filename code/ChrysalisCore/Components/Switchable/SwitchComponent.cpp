@@ -2,6 +2,8 @@
 
 #include "SwitchComponent.h"
 #include <CryDynamicResponseSystem/IDynamicResponseSystem.h>
+#include "Plugin/ChrysalisCorePlugin.h"
+#include "Utility/GameplayTrace.h"
 
 
 namespace Chrysalis
@@ -69,6 +71,20 @@ void CSwitchComponent::Initialize()
 }
 
 
+void CSwitchComponent::ProcessEvent(SEntityEvent& event)
+{
+	switch (event.event)
+	{
+		case ENTITY_EVENT_LINK:
+		case ENTITY_EVENT_DELINK:
+		case ENTITY_EVENT_RESET:
+			// Our links have changed, or might have, so the linked entities need to be found again.
+			m_linkedActors.Invalidate();
+			break;
+	}
+}
+
+
 void CSwitchComponent::OnResetState()
 {
 	m_switchTogglePtr->SetEnabled(m_isEnabled);
@@ -81,7 +97,7 @@ void CSwitchComponent::OnInteractionSwitchToggle()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("SwitchToggle fired.");
+		GameplayTrace(eGTC_Switch, EGameplayTraceEvent::SwitchToggle, GetEntityId());
 		if (m_isSwitchedOn)
 			OnInteractionSwitchOff();
 		else
@@ -98,9 +114,9 @@ void CSwitchComponent::OnInteractionSwitchOn()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("SwitchOn fired.");
+		GameplayTrace(eGTC_Switch, EGameplayTraceEvent::SwitchOn, GetEntityId());
 		m_isSwitchedOn = true;
-		InformAllLinkedEntities(kSwitchOnVerb, true);
+		InformAllLinkedEntities(DRSKeys::kInteractionSwitchOn, true);
 
 		// Push the signal out using schematyc.
 		if (auto const pSchematycObject = GetEntity()->GetSchematycObject())
@@ -117,9 +133,9 @@ void CSwitchComponent::OnInteractionSwitchOff()
 {
 	if (m_isEnabled)
 	{
-		gEnv->pLog->LogAlways("SwitchOff fired.");
+		GameplayTrace(eGTC_Switch, EGameplayTraceEvent::SwitchOff, GetEntityId());
 		m_isSwitchedOn = false;
-		InformAllLinkedEntities(kSwitchOffVerb, true);
+		InformAllLinkedEntities(DRSKeys::kInteractionSwitchOff, true);
 
 		// Push the signal out using schematyc.
 		if (auto const pSchematycObject = GetEntity()->GetSchematycObject())
@@ -132,30 +148,28 @@ void CSwitchComponent::OnInteractionSwitchOff()
 }
 
 
-void CSwitchComponent::InformAllLinkedEntities(string verb, bool isSwitchedOn)
+void CSwitchComponent::InformAllLinkedEntities(const CHashedString& verb, bool isSwitchedOn)
 {
-	// Notify every linked entity.
-	auto* entityLinks = GetEntity()->GetEntityLinks();
-	while (entityLinks)
-	{
-		auto pTargetEntity = gEnv->pEntitySystem->GetEntity(entityLinks->entityId);
-		auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
+	auto pSignalBus = CChrysalisCorePlugin::Get()->GetDRSSignalBus();
+	const auto& linkedEntityIds = m_linkedActors.Get(GetEntity());
+	if (!pSignalBus || linkedEntityIds.empty())
+		return;
 
-		// Create a context variable collection and populate it based on information from the target entity.
-		DRS::IVariableCollectionSharedPtr pContextVariableCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+	// The signal is the same for every link, so there's no need to hash an override more than once.
+	const CHashedString queueSignal = m_queueSignal.empty() ? DRSKeys::kInteractionSwitch : CHashedString(m_queueSignal.c_str());
 
-		// It might be useful to know which verb triggered the interaction.
-		pContextVariableCollection->CreateVariable("Verb", CHashedString(verb));
+	// Every linked entity is sent the same context, so we only need to populate one collection.
+	DRS::IVariableCollectionSharedPtr pContextVariableCollection = m_contextCollections.Acquire();
 
-		// The switch value is always set, regardless of which verb was triggered.
-		pContextVariableCollection->CreateVariable("IsSwitchedOn", isSwitchedOn);
+	// It might be useful to know which verb triggered the interaction.
+	pContextVariableCollection->SetVariableValue(DRSKeys::kVerb, verb);
 
-		// Queue it and let the DRS handle it now.
-		const string queueSignalVerb = m_queueSignal.empty() ? kQueueSignal : m_queueSignal.c_str();
-		pDrsProxy->GetResponseActor()->QueueSignal(queueSignalVerb, pContextVariableCollection);
+	// The switch value is always set, regardless of which verb was triggered.
+	pContextVariableCollection->SetVariableValue(DRSKeys::kIsSwitchedOn, isSwitchedOn);
 
-		// Next please.
-		entityLinks = entityLinks->next;
-	}
+	// Queue it for every linked entity and let the signal bus hand them all to the DRS together. Repeats of
+	// the same verb within a frame are merged.
+	for (const EntityId linkedEntityId : linkedEntityIds)
+		pSignalBus->Queue(linkedEntityId, queueSignal, verb.GetHash(), pContextVariableCollection);
 }
 }
\ No newline at end of file
@@ -5,6 +5,13 @@
 
 namespace Chrysalis
 {
+namespace
+{
+/** The attachments for the hour, minute and second hands. */
+const char* const handNames [] = { "hours", "minutes", "seconds" };
+}
+
+
 void CTimePieceComponent::Register(Schematyc::CEnvRegistrationScope& componentScope)
 {
 	{
@@ -65,6 +72,13 @@ void CTimePieceComponent::Initialize()
 }
 
 
+CTimePieceComponent::~CTimePieceComponent()
+{
+	if (auto pDisplaySystem = CChrysalisCorePlugin::Get()->GetMechanicalDisplaySystem())
+		pDisplaySystem->Unregister(m_displayId);
+}
+
+
 void CTimePieceComponent::ProcessEvent(SEntityEvent& event)
 {
 	switch (event.event)
@@ -76,13 +90,6 @@ void CTimePieceComponent::ProcessEvent(SEntityEvent& event)
 			ResetObject();
 		}
 		break;
-
-		case ENTITY_EVENT_UPDATE:
-		{
-			SEntityUpdateContext* pCtx = (SEntityUpdateContext*)event.nParam [0];
-			Update(pCtx);
-		}
-		break;
 	}
 
 	CBaseMeshComponent::ProcessEvent(event);
@@ -104,6 +111,14 @@ void CTimePieceComponent::LoadFromDisk()
 
 void CTimePieceComponent::ResetObject()
 {
+	// The character or axis may have changed, so any attachments we resolved are no longer valid.
+	auto pDisplaySystem = CChrysalisCorePlugin::Get()->GetMechanicalDisplaySystem();
+	if (pDisplaySystem)
+	{
+		pDisplaySystem->Unregister(m_displayId);
+		m_displayId = InvalidMechanicalDisplayId;
+	}
+
 	if (m_pCachedCharacter == nullptr)
 	{
 		FreeEntitySlot();
@@ -111,48 +126,25 @@ void CTimePieceComponent::ResetObject()
 	}
 
 	m_pEntity->SetCharacter(m_pCachedCharacter, GetOrMakeEntitySlotId() | ENTITY_SLOT_ACTUAL, false);
+
+	if (pDisplaySystem)
+	{
+		m_displayId = pDisplaySystem->Register(GetEntityId(), m_pCachedCharacter, m_timePieceProperties.axis, handNames, CRY_ARRAY_COUNT(handNames));
+		UpdateDisplay();
+	}
 }
 
 
-void CTimePieceComponent::Update(SEntityUpdateContext* pCtx)
+void CTimePieceComponent::UpdateDisplay()
 {
-	if (m_pCachedCharacter)
+	if (auto pDisplaySystem = CChrysalisCorePlugin::Get()->GetMechanicalDisplaySystem())
 	{
-		// If we can access the attachments, we can try and find the rotation for each hand.
-		const IAttachmentManager* pAttachmentManager = m_pCachedCharacter->GetIAttachmentManager();
-		if (pAttachmentManager)
-		{
-			// Can we find the hours hand?
-			const auto hoursIndex = pAttachmentManager->GetIndexByName("hours");
-			if (IAttachment* pHoursAttachment = pAttachmentManager->GetInterfaceByIndex(hoursIndex))
-			{
-				QuatT trans = pHoursAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_timePieceProperties.hour * 30.0f + m_timePieceProperties.minute / 2.0f);
-				trans.q = Quat::CreateRotationXYZ(m_timePieceProperties.axis * radians);
-				pHoursAttachment->SetAttAbsoluteDefault(trans);
-			}
-
-			// Can we find the minutes hand?
-			const auto minutesIndex = pAttachmentManager->GetIndexByName("minutes");
-			if (IAttachment* pMinutesAttachment = pAttachmentManager->GetInterfaceByIndex(minutesIndex))
-			{
-				QuatT trans = pMinutesAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_timePieceProperties.minute * 6.0f);
-				trans.q = Quat::CreateRotationXYZ(m_timePieceProperties.axis * radians);
-				pMinutesAttachment->SetAttAbsoluteDefault(trans);
-			}
-
-			// Can we find the seconds hand?
-			const auto secondsIndex = pAttachmentManager->GetIndexByName("seconds");
-			IAttachment* pSecondsAttachment = pAttachmentManager->GetInterfaceByIndex(secondsIndex);
-			if (IAttachment* pSecondsAttachment = pAttachmentManager->GetInterfaceByIndex(secondsIndex))
-			{
-				QuatT trans = pSecondsAttachment->GetAttAbsoluteDefault();
-				const float radians = DEG2RAD(m_timePieceProperties.second * 6.0f);
-				trans.q = Quat::CreateRotationXYZ(m_timePieceProperties.axis * radians);
-				pSecondsAttachment->SetAttAbsoluteDefault(trans);
-			}
-		}
+		const float degrees [] = {
+			m_timePieceProperties.hour * 30.0f + m_timePieceProperties.minute / 2.0f,
+			m_timePieceProperties.minute * 6.0f,
+			m_timePieceProperties.second * 6.0f
+		};
+		pDisplaySystem->SetHandAngles(m_displayId, degrees, CRY_ARRAY_COUNT(degrees));
 	}
 }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Entities/Interaction/IEntityInteraction.h"
 #include <DefaultComponents/Geometry/BaseMeshComponent.h>
+#include <Game/Display/MechanicalDisplaySystem.h>
 
 
 namespace Chrysalis
@@ -20,12 +21,12 @@ protected:
 	// IEntityComponent
 	void Initialize() override;
 	void ProcessEvent(SEntityEvent& event) override;
-	uint64 GetEventMask() const { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask() | BIT64(ENTITY_EVENT_UPDATE); }
+	uint64 GetEventMask() const { return Cry::DefaultComponents::CBaseMeshComponent::GetEventMask(); }
 	// ~IEntityComponent
 
 public:
 	CTimePieceComponent() {}
-	virtual ~CTimePieceComponent() {}
+	virtual ~CTimePieceComponent();
 
 	static void ReflectType(Schematyc::CTypeDesc<CTimePieceComponent>& desc);
 
@@ -45,8 +46,6 @@ public:
 		Schematyc::Range<0, 60> second = 0.0f;
 	};
 
-	virtual void Update(SEntityUpdateContext* pCtx);
-
 	virtual void SetCharacterFile(const char* szPath) { m_filePath = szPath; };
 	const char* GetCharacterFile() const { return m_filePath.value.c_str(); }
 
@@ -62,22 +61,31 @@ public:
 	void SetHour(const float hour)
 	{
 		m_timePieceProperties.hour = hour;
+		UpdateDisplay();
 	}
 
 	void SetMinute(const float minute)
 	{
 		m_timePieceProperties.minute = minute;
+		UpdateDisplay();
 	}
 
 	void SetSecond(const float second)
 	{
 		m_timePieceProperties.second = second;
+		UpdateDisplay();
 	}
 
 protected:
+	/** Tells the mechanical display system where the hands should be pointing. */
+	void UpdateDisplay();
+
 	Schematyc::CharacterFileName m_filePath;
 	_smart_ptr<ICharacterInstance> m_pCachedCharacter = nullptr;
 	STimePieceProperties m_timePieceProperties;
+
+	/** Our registration with the mechanical display system. */
+	TMechanicalDisplayId m_displayId { InvalidMechanicalDisplayId };
 };
 
 
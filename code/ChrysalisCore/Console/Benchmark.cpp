@@ -0,0 +1,314 @@
+#include <StdAfx.h>
+
+#include "Benchmark.h"
+#include <CryString/StringUtils.h>
+#include <Components/Interaction/EntityAwarenessComponent.h>
+#include <ObjectID/ObjectId.h>
+#include <StateMachine/StateMachine.h>
+#include <Utility/CryHash.h>
+#include <Utility/ItemString.h>
+#include <Utility/StringConversions.h>
+
+#if BENCHMARK_ENABLED
+
+namespace Chrysalis
+{
+// ***
+// *** A small state machine which only exists to be benchmarked. It has two branches so that toggling between the leaf
+// *** states has to walk up to a common parent, and a root handler so that events have to bubble up the hierarchy.
+// ***
+
+
+enum EBenchmarkStateEvent
+{
+	BENCHMARK_EVENT_PING = STATE_EVENT_CUSTOM,
+	BENCHMARK_EVENT_TOGGLE,
+};
+
+
+enum EBenchmarkState
+{
+	BENCHMARK_STATE = STATE_FIRST,
+};
+
+
+class CBenchmarkStateHost
+{
+	DECLARE_STATE_MACHINE(CBenchmarkStateHost, Benchmark);
+
+public:
+	CBenchmarkStateHost() { StateMachineInitBenchmark(); }
+	~CBenchmarkStateHost() { StateMachineReleaseBenchmark(); }
+
+	/** The number of pings which have reached the root state. */
+	uint32 m_pingCount { 0 };
+
+	/** The number of times a leaf state has been entered. */
+	uint32 m_enterCount { 0 };
+};
+
+DEFINE_STATE_MACHINE(CBenchmarkStateHost, Benchmark);
+
+
+class CBenchmarkState : private CStateHierarchy<CBenchmarkStateHost>
+{
+	DECLARE_STATE_CLASS_BEGIN(CBenchmarkStateHost, CBenchmarkState)
+	DECLARE_STATE_CLASS_ADD(CBenchmarkStateHost, BranchA);
+	DECLARE_STATE_CLASS_ADD(CBenchmarkStateHost, LeafA);
+	DECLARE_STATE_CLASS_ADD(CBenchmarkStateHost, BranchB);
+	DECLARE_STATE_CLASS_ADD(CBenchmarkStateHost, LeafB);
+	DECLARE_STATE_CLASS_END(CBenchmarkStateHost);
+};
+
+
+DEFINE_STATE_CLASS_BEGIN(CBenchmarkStateHost, CBenchmarkState, BENCHMARK_STATE, LeafA)
+DEFINE_STATE_CLASS_ADD(CBenchmarkStateHost, CBenchmarkState, BranchA, Root)
+DEFINE_STATE_CLASS_ADD(CBenchmarkStateHost, CBenchmarkState, LeafA, BranchA)
+DEFINE_STATE_CLASS_ADD(CBenchmarkStateHost, CBenchmarkState, BranchB, Root)
+DEFINE_STATE_CLASS_ADD(CBenchmarkStateHost, CBenchmarkState, LeafB, BranchB)
+DEFINE_STATE_CLASS_END(CBenchmarkStateHost, CBenchmarkState);
+
+
+const CBenchmarkState::TStateIndex CBenchmarkState::Root(CBenchmarkStateHost& host, const SStateEvent& event)
+{
+	if (event.GetEventId() == BENCHMARK_EVENT_PING)
+		host.m_pingCount++;
+
+	return State_Continue;
+}
+
+
+const CBenchmarkState::TStateIndex CBenchmarkState::BranchA(CBenchmarkStateHost& host, const SStateEvent& event)
+{
+	return State_Continue;
+}
+
+
+const CBenchmarkState::TStateIndex CBenchmarkState::LeafA(CBenchmarkStateHost& host, const SStateEvent& event)
+{
+	switch (event.GetEventId())
+	{
+		case STATE_EVENT_ENTER:
+			host.m_enterCount++;
+			break;
+
+		case BENCHMARK_EVENT_TOGGLE:
+			return State_LeafB;
+	}
+
+	return State_Continue;
+}
+
+
+const CBenchmarkState::TStateIndex CBenchmarkState::BranchB(CBenchmarkStateHost& host, const SStateEvent& event)
+{
+	return State_Continue;
+}
+
+
+const CBenchmarkState::TStateIndex CBenchmarkState::LeafB(CBenchmarkStateHost& host, const SStateEvent& event)
+{
+	switch (event.GetEventId())
+	{
+		case STATE_EVENT_ENTER:
+			host.m_enterCount++;
+			break;
+
+		case BENCHMARK_EVENT_TOGGLE:
+			return State_LeafA;
+	}
+
+	return State_Continue;
+}
+
+
+// ***
+// *** Benchmarks
+// ***
+
+
+namespace
+{
+/** The number of distinct inputs each benchmark cycles through. Must be a power of two. */
+static const int benchmarkInputCount = 256;
+
+
+/**
+Times a benchmark. The body is handed the iteration number and returns a value to fold into the checksum.
+
+\param	name	   The name of the benchmark.
+\param	iterations The number of iterations.
+\param	body	   The work to time.
+
+\return The result.
+**/
+template<typename BODY>
+SBenchmarkResult TimeBenchmark(const char* name, int iterations, BODY body)
+{
+	SBenchmarkResult result;
+	result.name = name;
+	result.iterations = iterations;
+
+	const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+
+	for (int i = 0; i < iterations; ++i)
+		result.checksum += body(i);
+
+	result.totalMilliseconds = (gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds();
+
+	return result;
+}
+
+
+/** Names shaped like the item and parameter names we intern while loading. */
+std::vector<string> MakeBenchmarkNames()
+{
+	std::vector<string> names(benchmarkInputCount);
+	for (int i = 0; i < benchmarkInputCount; ++i)
+		names [i].Format("benchmark_item_%d_attachment_%d", i, i * 7);
+
+	return names;
+}
+
+
+string FormatResult(const SBenchmarkResult& result)
+{
+	string json;
+	json.Format("{\"name\":\"%s\",\"iterations\":%d,\"total_ms\":%.3f,\"ns_per_op\":%.2f,\"checksum\":%u}",
+		result.name, result.iterations, result.totalMilliseconds, result.GetNanosecondsPerIteration(), result.checksum);
+
+	return json;
+}
+}
+
+
+void RunBenchmarks(int iterations, const char* pOutputFile)
+{
+	std::vector<SBenchmarkResult> results;
+	const std::vector<string> names = MakeBenchmarkNames();
+	const int inputMask = benchmarkInputCount - 1;
+
+	// HSM.
+	{
+		CBenchmarkStateHost host;
+		const SStateEvent pingEvent(BENCHMARK_EVENT_PING);
+		const SStateEvent toggleEvent(BENCHMARK_EVENT_TOGGLE);
+
+		results.push_back(TimeBenchmark("hsm_dispatch", iterations, [&](int i)
+		{
+			host.StateMachineHandleEventBenchmark(pingEvent);
+			return host.m_pingCount;
+		}));
+
+		results.push_back(TimeBenchmark("hsm_transition", iterations, [&](int i)
+		{
+			host.StateMachineHandleEventBenchmark(toggleEvent);
+			return host.m_enterCount;
+		}));
+	}
+
+	// ObjectId generation, on a factory of its own so the real ones aren't used up.
+	{
+		CObjectIdFactory factory(0);
+
+		results.push_back(TimeBenchmark("objectid_create", iterations, [&](int i)
+		{
+			return uint32(factory.CreateObjectId());
+		}));
+	}
+
+	// SharedString interning. The strings are kept alive so that we measure lookups, rather than the first intern.
+	{
+		std::vector<ItemString> keepAlive(names.begin(), names.end());
+
+		results.push_back(TimeBenchmark("sharedstring_intern", iterations, [&](int i)
+		{
+			ItemString name(names [i & inputMask].c_str());
+			return uint32(name.length());
+		}));
+
+		results.push_back(TimeBenchmark("sharedstring_compare", iterations, [&](int i)
+		{
+			return uint32(keepAlive [i & inputMask] == keepAlive [(i * 13) & inputMask]);
+		}));
+	}
+
+	// Hashing.
+	results.push_back(TimeBenchmark("cryhash_string", iterations, [&](int i)
+	{
+		return CryHashStringId(names [i & inputMask].c_str()).id;
+	}));
+
+	// String conversions.
+	{
+		std::vector<string> vectors(benchmarkInputCount);
+		std::vector<string> quaternions(benchmarkInputCount);
+		for (int i = 0; i < benchmarkInputCount; ++i)
+		{
+			vectors [i] = Vec3ToString(Vec3(float(i), float(i) * 0.5f, float(-i)));
+			quaternions [i] = QuatToString(Quat::CreateRotationZ(float(i) * 0.01f));
+		}
+
+		results.push_back(TimeBenchmark("string_to_vec3", iterations, [&](int i)
+		{
+			return uint32(Vec3FromString(vectors [i & inputMask]).x);
+		}));
+
+		results.push_back(TimeBenchmark("string_to_quat", iterations, [&](int i)
+		{
+			return uint32(QuatFromString(quaternions [i & inputMask]).w * 1000.0f);
+		}));
+
+		results.push_back(TimeBenchmark("string_to_color", iterations, [&](int i)
+		{
+			return uint32(StringToColor("128,64,32,255", true).r * 1000.0f);
+		}));
+	}
+
+	// Awareness scoring, against items scattered in a ring around the eye.
+	{
+		const Vec3 eyePosition(0.0f, 0.0f, 1.8f);
+		const Vec3 dirLooking(0.0f, 1.0f, 0.0f);
+		std::vector<Vec3> itemPositions(benchmarkInputCount);
+		for (int i = 0; i < benchmarkInputCount; ++i)
+		{
+			const float angle = (float(i) / float(benchmarkInputCount)) * gf_PI2;
+			const float distance = 1.0f + float(i % 12);
+			itemPositions [i] = Vec3(sin_tpl(angle) * distance, cos_tpl(angle) * distance, 1.0f);
+		}
+
+		results.push_back(TimeBenchmark("awareness_scoring", iterations, [&](int i)
+		{
+			float score;
+			return uint32(CEntityAwarenessComponent::ScoreDotFiltered(eyePosition, dirLooking, itemPositions [i & inputMask], 0.9f, 1.0f, score));
+		}));
+	}
+
+	// Report.
+	FILE* pFile = pOutputFile ? gEnv->pCryPak->FOpen(pOutputFile, "wt") : nullptr;
+	if (pFile)
+		gEnv->pCryPak->FPrintf(pFile, "[\n");
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const string json = FormatResult(results [i]);
+		CryLogAlways("BENCHMARK %s", json.c_str());
+
+		if (pFile)
+			gEnv->pCryPak->FPrintf(pFile, "  %s%s\n", json.c_str(), (i + 1 < results.size()) ? "," : "");
+	}
+
+	if (pFile)
+	{
+		gEnv->pCryPak->FPrintf(pFile, "]\n");
+		gEnv->pCryPak->FClose(pFile);
+		CryLogAlways("Benchmark results written to %s", pOutputFile);
+	}
+	else if (pOutputFile)
+	{
+		CryLogAlways("Unable to write the benchmark results to %s", pOutputFile);
+	}
+}
+}
+
+#endif // BENCHMARK_ENABLED
@@ -0,0 +1,44 @@
+/**
+\file	Console\Benchmark.h
+
+Micro-benchmarks for the hot paths in the core gameplay code. These run inside the engine from the console, so the code
+under test is the same as the game runs, rather than a stubbed copy of it. Results are logged one per line as JSON,
+prefixed with "BENCHMARK", so they can be pulled out of the log and compared between builds.
+
+The benchmarks and their console command are compiled out of release builds.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+#if !defined(_RELEASE)
+#define BENCHMARK_ENABLED			 (1)
+#else
+#define BENCHMARK_ENABLED			 (0)
+#endif
+
+#if BENCHMARK_ENABLED
+/** The timing for a single benchmark. */
+struct SBenchmarkResult
+{
+	const char* name { nullptr };
+	int iterations { 0 };
+	float totalMilliseconds { 0.0f };
+
+	/** Folded from the results of the work, so the compiler is unable to optimise it away. */
+	uint32 checksum { 0 };
+
+	float GetNanosecondsPerIteration() const { return (iterations > 0) ? (totalMilliseconds * 1000000.0f) / float(iterations) : 0.0f; }
+};
+
+
+/**
+Runs each of the benchmarks, logging the results.
+
+\param	iterations   The number of iterations for each benchmark.
+\param	pOutputFile  (Optional) If non-null, the results are also written to this file as a JSON array.
+**/
+void RunBenchmarks(int iterations, const char* pOutputFile = nullptr);
+#endif // BENCHMARK_ENABLED
+}
@@ -4,10 +4,17 @@
 #include <CrySystem/ISystem.h>
 #include "Components/Player/PlayerComponent.h"
 #include <Actor/Animation/Actions/ActorAnimationActionEmote.h>
+#include <Actor/Animation/Actions/ActorAnimationActionPool.h>
 #include <Actor/Character/CharacterComponent.h>
+#include <Animation/ProceduralContext/ProceduralContextHelpers.h>
+#include <Console/Benchmark.h>
 #include <ObjectID/ObjectId.h>
 #include <ObjectID/ObjectIdMasterFactory.h>
 #include <Plugin/ChrysalisCorePlugin.h>
+#include <StateMachine/StateMachine.h>
+#include <Utility/GameplayTrace.h>
+#include <Utility/StringConversions.h>
+#include <thread>
 
 
 namespace Chrysalis
@@ -22,6 +29,7 @@ void CCVars::RegisterVariables()
 
 	// Game - misc
 	REGISTER_CVAR2("game_rayCastQuota", &m_rayCastQuota, 64, VF_CHEAT, "Number of allowed deferred raycasts.");
+	REGISTER_CVAR2("game_raycast_service_debug", &m_raycastServiceDebug, 0, VF_CHEAT, "Show statistics for the deferred raycast service.");
 	REGISTER_CVAR2("cl_invertPitch", &m_cl_invertPitch, false, VF_CHEAT, "Should we invert the Y axis for camera movements? This is preferred by some players, particularly those using a flight yoke.");
 	REGISTER_CVAR2("cl_mouseSensitivity", &m_cl_mouseSensitivity, 1.0f, VF_CHEAT, "Overall mouse sensitivity. This should be factored into any movements involving the mouse.");
 	REGISTER_CVAR2("watch_enabled", &m_watch_enabled, true, VF_CHEAT, "Is watch debug enabled?");
@@ -31,11 +39,36 @@ void CCVars::RegisterVariables()
 	REGISTER_CVAR2("watch_text_render_lineSpacing", &m_watch_text_render_lineSpacing, 9.3f, VF_CHEAT, "Line spacing for watch text.");
 	REGISTER_CVAR2("watch_text_render_fxscale", &m_watch_text_render_fxscale, 13.0f, VF_CHEAT, "The watch text render fxscale.");
 
+	// Game cache
+	REGISTER_CVAR2("game_cache_debug", &m_gameCacheDebug, 0, VF_CHEAT, "Show the memory use of each category in the game cache.");
+	REGISTER_CVAR2("game_cache_budget_character_model", &m_gameCacheBudgetCharacterModel, 64, VF_NULL, "Memory budget for cached character models (MB). Least recently used models are evicted once this is exceeded. 0 - unlimited.");
+	REGISTER_CVAR2("game_cache_budget_static_object", &m_gameCacheBudgetStaticObject, 128, VF_NULL, "Memory budget for cached static geometry (MB). Least recently used geometry is evicted once this is exceeded. 0 - unlimited.");
+	REGISTER_CVAR2("game_cache_budget_texture", &m_gameCacheBudgetTexture, 256, VF_NULL, "Memory budget for cached textures (MB). Least recently used textures are evicted once this is exceeded. 0 - unlimited.");
+	REGISTER_CVAR2("game_cache_budget_material", &m_gameCacheBudgetMaterial, 16, VF_NULL, "Memory budget for cached materials (MB). Least recently used materials are evicted once this is exceeded. 0 - unlimited.");
+	REGISTER_CVAR2("game_cache_budget_particle_effect", &m_gameCacheBudgetParticleEffect, 32, VF_NULL, "Memory budget for cached particle effects (MB). Least recently used effects are evicted once this is exceeded. 0 - unlimited.");
+	REGISTER_CVAR2("game_cache_prefetch_budget_ms", &m_gameCachePrefetchBudgetMs, 2.0f, VF_NULL, "Time each frame which may be spent creating prefetched assets (ms). At least one asset is created each frame, if any are ready.");
+	m_gameCacheWarmSet = REGISTER_STRING("game_cache_warm_set", "Libs/GameCache/WarmSet.xml", VF_NULL, "Manifest of assets which are loaded into the game cache while a level is loading.");
+
+	// Mechanical displays
+	REGISTER_CVAR2("game_mechanical_display_debug", &m_mechanicalDisplayDebug, 0, VF_CHEAT, "Show statistics for the clocks, gauges and other mechanical displays.");
+	REGISTER_CVAR2("game_mechanical_display_tick_rate", &m_mechanicalDisplayTickRate, 10.0f, VF_NULL, "How many times a second mechanical displays may move their hands. 0 - every frame.");
+	REGISTER_CVAR2("game_mechanical_display_lod_distance", &m_mechanicalDisplayLodDistance, 30.0f, VF_NULL, "Mechanical displays further than this from the camera (m) only move their hands every game_mechanical_display_lod_interval seconds.");
+	REGISTER_CVAR2("game_mechanical_display_lod_interval", &m_mechanicalDisplayLodInterval, 1.0f, VF_NULL, "The shortest time between updates for a distant mechanical display (s).");
+
+	// Water level service
+	REGISTER_CVAR2("game_water_level_debug", &m_waterLevelServiceDebug, 0, VF_CHEAT, "Show cache and bottom probe statistics for the water level service.");
+	REGISTER_CVAR2("game_water_level_cell_size", &m_waterLevelCellSize, 2.0f, VF_NULL, "Width of the grid cells the water level service caches results in (m).");
+	REGISTER_CVAR2("game_water_level_lifetime", &m_waterLevelLifetime, 0.5f, VF_NULL, "How long a cached water level is used before the engine is asked again (s). This is the longest an actor can take to notice the water has moved.");
+	REGISTER_CVAR2("game_water_bottom_lifetime", &m_waterBottomLifetime, 10.0f, VF_NULL, "How long a cached bottom depth is used before it is probed again (s).");
+
+	// DRS signal bus
+	REGISTER_CVAR2("game_drs_signal_bus_debug", &m_drsSignalBusDebug, 0, VF_CHEAT, "Show how many signals the DRS signal bus queued, coalesced and sent last frame.");
+
 	// TODO: Deprecate this.
 	REGISTER_CVAR2("ladder_logVerbosity", &m_ladder_logVerbosity, 0, VF_CHEAT, "Ladder logging.");
 
 	// Camera manager
-	m_cameraManagerDebugViewOffset = REGISTER_STRING("camera_manager_debug_view_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned.");
+	RegisterTypedCVar(m_cameraManagerDebugViewOffset, "camera_manager_debug_view_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned.");
 	REGISTER_CVAR2("camera_manager_default_camera", &m_cameraManagerDefaultCamera, 1, VF_CHEAT, "Default camera mode. 0 - FP, 1 - ActionRPG");
 
 	// Action RPG Camera
@@ -49,8 +82,12 @@ void CCVars::RegisterVariables()
 	REGISTER_CVAR2("camera_actionrpg_ZoomMax", &m_actionRPGCameraZoomMax, 1.0f, VF_CHEAT, "The maximum value for camera zoom.");
 	REGISTER_CVAR2("camera_actionrpg_ZoomStep", &m_actionRPGCameraZoomStep, 0.02f, VF_CHEAT, "Each zoom event in or out will alter the zoom factor, m_zoom, by this amount. Use lower values for more steps and higher values to zoom in / out faster with less steps.");
 	REGISTER_CVAR2("camera_actionrpg_ZoomSpeed", &m_actionRPGCameraZoomSpeed, 10.0f, VF_CHEAT, "When the zoom changes we interpolate between it's last value and the goal value. This provides for smoother movement on camera zooms. Higher values will interpolate faster than lower values.");
-	m_actionRPGCameraViewPositionOffset = REGISTER_STRING("camera_actionrpg_view_position_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
-	m_actionRPGCameraAimPositionOffset = REGISTER_STRING("camera_actionrpg_aim_position_offset", "0.45, -0.5, 0.0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
+	RegisterTypedCVar(m_actionRPGCameraViewPositionOffset, "camera_actionrpg_view_position_offset", "0, 0, 0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
+	RegisterTypedCVar(m_actionRPGCameraAimPositionOffset, "camera_actionrpg_aim_position_offset", "0.45, -0.5, 0.0", VF_CHEAT, "A translation vector which is applied after the camera is initially positioned. This provides for 'over the shoulder' views of the target actor.");
+	REGISTER_CVAR2("camera_actionrpg_collision_radius", &m_actionRPGCameraCollisionRadius, 0.2f, VF_CHEAT, "Radius of the sphere which is swept from the aim position to the camera to detect collisions.");
+	REGISTER_CVAR2("camera_actionrpg_collision_hysteresis", &m_actionRPGCameraCollisionHysteresis, 0.15f, VF_CHEAT, "The camera won't ease back out after a collision until it has at least this much room (metres). This stops it hunting back and forth near geometry.");
+	REGISTER_CVAR2("camera_actionrpg_collision_ease_out_speed", &m_actionRPGCameraCollisionEaseOutSpeed, 4.0f, VF_CHEAT, "The speed at which the camera eases back out once a collision has cleared. The camera pulls in immediately.");
+	REGISTER_CVAR2("camera_actionrpg_collision_probes", &m_actionRPGCameraCollisionProbes, 1, VF_CHEAT, "Cast a ring of deferred probes around where the camera is heading. The camera won't ease out while they report obstructions.");
 
 	// First Person Camera
 	REGISTER_CVAR2("camera_firstperson_debug", &m_firstPersonCameraDebug, 0, VF_CHEAT, "Allow debug display.");
@@ -78,10 +115,27 @@ void CCVars::RegisterVariables()
 
 	REGISTER_COMMAND("attach", CCVars::OnAttach, VF_NULL, "Attaches the player to a specified character.\n"
 		"Usage: attach [entity name]");
+	REGISTER_COMMAND("action_pool_stats", CCVars::OnActionPoolStats, VF_NULL, "Logs the live count and high-water mark for each pool of animation actions.\n"
+		"Usage: action_pool_stats");
+	REGISTER_COMMAND("hsm_stats", CCVars::OnStateMachineStats, VF_NULL, "Logs the counters for the state machines' state pools and deferred event rings.\n"
+		"Pool allocations should stop increasing once the pools have warmed up, and event overflows should stay at zero.\n"
+		"Usage: hsm_stats");
+#if BENCHMARK_ENABLED
+	REGISTER_COMMAND("benchmark", CCVars::OnBenchmark, VF_CHEAT, "Times the hot paths in the core gameplay code and logs the results as JSON.\n"
+		"Usage: benchmark [iterations] [output file]");
+#endif // BENCHMARK_ENABLED
 	REGISTER_COMMAND("createobjectid", CCVars::OnCreateObjectId, VF_NULL, "Requests a new unique ObjectId for [class] of objects.\n"
 		"Usage: createobjectid [class]");
+	REGISTER_COMMAND("objectid_stress_test", CCVars::OnObjectIdStressTest, VF_CHEAT, "Creates ObjectIds from several threads at once and checks they are all unique.\n"
+		"Usage: objectid_stress_test [threads] [ids per thread]");
+	REGISTER_COMMAND("request_list_self_test", CCVars::OnRequestListSelfTest, VF_CHEAT, "Checks that procedural context request identifiers stay unique as their slots are reused.\n"
+		"Usage: request_list_self_test");
 	REGISTER_COMMAND("emote", CCVars::OnEmote, VF_NULL, "Makes a request for the character under player command to perform an emote.\n"
 		"Usage: emote [emotion]");
+	REGISTER_COMMAND("gameplay_trace", CCVars::OnGameplayTrace, VF_NULL, "Sets which categories of gameplay event are recorded by the gameplay trace. With no categories, shows which are recorded.\n"
+		"Usage: gameplay_trace [all | none | switch | interact | item | openable ...]");
+	REGISTER_COMMAND("gameplay_trace_dump", CCVars::OnGameplayTraceDump, VF_NULL, "Writes the most recent gameplay trace records from every thread to the log.\n"
+		"Usage: gameplay_trace_dump [max records] [clear]");
 }
 
 
@@ -92,13 +146,66 @@ void CCVars::UnregisterVariables()
 	// ***
 
 
+	m_typedCVars.clear();
+
 	// ***
 	// *** COMMANDS
 	// ***
 
 	gEnv->pConsole->RemoveCommand("attach");
+	gEnv->pConsole->RemoveCommand("action_pool_stats");
+	gEnv->pConsole->RemoveCommand("hsm_stats");
+#if BENCHMARK_ENABLED
+	gEnv->pConsole->RemoveCommand("benchmark");
+#endif // BENCHMARK_ENABLED
 	gEnv->pConsole->RemoveCommand("createobjectid");
+	gEnv->pConsole->RemoveCommand("objectid_stress_test");
+	gEnv->pConsole->RemoveCommand("request_list_self_test");
 	gEnv->pConsole->RemoveCommand("emote");
+	gEnv->pConsole->RemoveCommand("gameplay_trace");
+	gEnv->pConsole->RemoveCommand("gameplay_trace_dump");
+}
+
+
+void CCVars::RegisterTypedCVar(CTypedCVarBase& typedCVar, const char* name, const char* defaultValue, int flags, const char* help)
+{
+	typedCVar.m_pCVar = REGISTER_STRING_CB(name, defaultValue, flags, help, &CCVars::OnTypedCVarChanged);
+	if (typedCVar.m_pCVar)
+	{
+		typedCVar.Parse();
+		m_typedCVars.push_back(&typedCVar);
+	}
+}
+
+
+void CCVars::OnTypedCVarChanged(ICVar* pCVar)
+{
+	for (auto pTypedCVar : g_cvars.m_typedCVars)
+	{
+		if (pTypedCVar->GetCVar() == pCVar)
+		{
+			pTypedCVar->Parse();
+			break;
+		}
+	}
+}
+
+
+void ParseCVarValue(const char* pValue, Vec3& value)
+{
+	value = Vec3FromString(pValue);
+}
+
+
+void ParseCVarValue(const char* pValue, Quat& value)
+{
+	value = QuatFromString(pValue);
+}
+
+
+void ParseCVarValue(const char* pValue, ColorF& value)
+{
+	value = StringToColor(pValue, false);
 }
 
 
@@ -127,6 +234,34 @@ void CCVars::OnAttach(IConsoleCmdArgs* pConsoleCommandArgs)
 }
 
 
+void CCVars::OnActionPoolStats(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	LogActionPoolStats();
+}
+
+
+void CCVars::OnStateMachineStats(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const SStatePoolStats& poolStats = GetStatePoolStats();
+	CryLogAlways("HSM state pools: allocations %d, reuses %d, live %d, released to the heap %d",
+		poolStats.allocations.load(), poolStats.reuses.load(), poolStats.live.load(), poolStats.releases.load());
+
+	const SStateEventStats& eventStats = GetStateEventStats();
+	CryLogAlways("HSM deferred events: high-water %d, overflows %d", eventStats.highWater.load(), eventStats.overflows.load());
+}
+
+
+#if BENCHMARK_ENABLED
+void CCVars::OnBenchmark(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int iterations = (pConsoleCommandArgs->GetArgCount() > 1) ? max(atoi(pConsoleCommandArgs->GetArg(1)), 1) : 100000;
+	const char* pOutputFile = (pConsoleCommandArgs->GetArgCount() > 2) ? pConsoleCommandArgs->GetArg(2) : nullptr;
+
+	RunBenchmarks(iterations, pOutputFile);
+}
+#endif // BENCHMARK_ENABLED
+
+
 void CCVars::OnCreateObjectId(IConsoleCmdArgs* pConsoleCommandArgs)
 {
 	if (pConsoleCommandArgs->GetArgCount() == 2)
@@ -167,6 +302,58 @@ void CCVars::OnCreateObjectId(IConsoleCmdArgs* pConsoleCommandArgs)
 }
 
 
+void CCVars::OnObjectIdStressTest(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const int threadCount = (pConsoleCommandArgs->GetArgCount() > 1) ? max(atoi(pConsoleCommandArgs->GetArg(1)), 1) : 8;
+	const int idsPerThread = (pConsoleCommandArgs->GetArgCount() > 2) ? max(atoi(pConsoleCommandArgs->GetArg(2)), 1) : 100000;
+
+	// A fresh factory, so the test doesn't use up the Ids of the real ones.
+	CObjectIdFactory factory(0);
+	std::vector<std::vector<ObjectId>> results(threadCount);
+	std::vector<std::thread> threads;
+
+	const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+
+	for (int i = 0; i < threadCount; ++i)
+	{
+		results [i].reserve(idsPerThread);
+		threads.emplace_back([&factory, &ids = results [i], idsPerThread]()
+		{
+			for (int j = 0; j < idsPerThread; ++j)
+				ids.push_back(factory.CreateObjectId());
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+
+	const float elapsed = (gEnv->pTimer->GetAsyncTime() - startTime).GetSeconds();
+
+	std::vector<ObjectId> allIds;
+	allIds.reserve(size_t(threadCount) * idsPerThread);
+	for (auto& ids : results)
+		allIds.insert(allIds.end(), ids.begin(), ids.end());
+
+	std::sort(allIds.begin(), allIds.end());
+	const size_t invalidCount = std::count(allIds.begin(), allIds.end(), CObjectIdFactory::InvalidId);
+	const size_t duplicateCount = allIds.size() - (std::unique(allIds.begin(), allIds.end()) - allIds.begin());
+
+	CryLogAlways("ObjectId stress test: %d threads created %" PRISIZE_T " Ids in %.3f seconds (%.0f Ids / second).",
+		threadCount, allIds.size(), elapsed, (elapsed > 0.0f) ? float(allIds.size()) / elapsed : 0.0f);
+
+	if ((invalidCount == 0) && (duplicateCount == 0))
+		CryLogAlways("ObjectId stress test: PASSED. Every Id was unique.");
+	else
+		CryLogAlways("ObjectId stress test: FAILED. %" PRISIZE_T " invalid Ids, %" PRISIZE_T " duplicate Ids.", invalidCount, duplicateCount);
+}
+
+
+void CCVars::OnRequestListSelfTest(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	ProceduralContextHelpers::RunRequestListSelfTest();
+}
+
+
 void CCVars::OnEmote(IConsoleCmdArgs* pConsoleCommandArgs)
 {
 	if (pConsoleCommandArgs->GetArgCount() == 2)
@@ -257,4 +444,43 @@ void CCVars::OnEmote(IConsoleCmdArgs* pConsoleCommandArgs)
 		CryLogAlways("Please supply the name of the emote to play.");
 	}
 }
+
+
+void CCVars::OnGameplayTrace(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	if (pConsoleCommandArgs->GetArgCount() > 1)
+	{
+		uint32 enabledCategories = 0;
+
+		for (int i = 1; i < pConsoleCommandArgs->GetArgCount(); ++i)
+		{
+			uint32 categories = 0;
+			if (!CGameplayTrace::GetCategoryFromName(pConsoleCommandArgs->GetArg(i), categories))
+			{
+				CryLogAlways("There is no gameplay trace category called '%s'.", pConsoleCommandArgs->GetArg(i));
+				return;
+			}
+
+			enabledCategories |= categories;
+		}
+
+		CGameplayTrace::SetEnabledCategories(enabledCategories);
+	}
+
+#if !GAMEPLAY_TRACE_ENABLED
+	CryLogAlways("The gameplay trace is compiled out of this build, so nothing will be recorded.");
+#endif
+
+	CryLogAlways("Gameplay trace categories: %s", CGameplayTrace::GetCategoryNames(CGameplayTrace::GetEnabledCategories()).c_str());
+}
+
+
+void CCVars::OnGameplayTraceDump(IConsoleCmdArgs* pConsoleCommandArgs)
+{
+	const uint32 maxRecords = (pConsoleCommandArgs->GetArgCount() > 1) ? uint32(max(atoi(pConsoleCommandArgs->GetArg(1)), 1)) : 100;
+	CGameplayTrace::Dump(maxRecords);
+
+	if ((pConsoleCommandArgs->GetArgCount() > 2) && (stricmp(pConsoleCommandArgs->GetArg(2), "clear") == 0))
+		CGameplayTrace::Clear();
+}
 }
\ No newline at end of file
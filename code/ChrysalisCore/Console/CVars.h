@@ -1,7 +1,54 @@
 #pragma once
 
+#include <CryMath/Cry_Color.h>
+#include <Console/Benchmark.h>
+
+
 namespace Chrysalis
 {
+/**
+A console variable which is entered as a string, but parsed into a typed value once each time it changes, rather than
+each time it is read.
+**/
+class CTypedCVarBase
+{
+public:
+	virtual ~CTypedCVarBase() = default;
+
+	ICVar* GetCVar() const { return m_pCVar; }
+
+	/** Parses the current string value of the console variable. */
+	virtual void Parse() = 0;
+
+private:
+	friend class CCVars;
+
+	ICVar* m_pCVar { nullptr };
+};
+
+
+void ParseCVarValue(const char* pValue, Vec3& value);
+void ParseCVarValue(const char* pValue, Quat& value);
+void ParseCVarValue(const char* pValue, ColorF& value);
+
+
+template<typename TYPE>
+class CTypedCVar : public CTypedCVarBase
+{
+public:
+	const TYPE& Get() const { return m_value; }
+
+	void Parse() override { ParseCVarValue(GetCVar()->GetString(), m_value); }
+
+private:
+	TYPE m_value;
+};
+
+typedef CTypedCVar<Vec3> CVec3CVar;
+typedef CTypedCVar<Quat> CQuatCVar;
+typedef CTypedCVar<ColorF> CColorCVar;
+
+
 class CCVars final
 {
 public:
@@ -16,6 +63,7 @@ public:
 
 	// Game - misc
 	int m_rayCastQuota { 64 };
+	int m_raycastServiceDebug { 0 };
 	int m_ladder_logVerbosity { 0 };
 	int m_cl_invertPitch { 0 };
 	float m_cl_mouseSensitivity { 1.0f };
@@ -26,8 +74,33 @@ public:
 	float m_watch_text_render_lineSpacing { 9.3f };
 	float m_watch_text_render_fxscale { 13.0f };
 
+	// Game cache - budgets are in megabytes.
+	int m_gameCacheDebug { 0 };
+	int m_gameCacheBudgetCharacterModel { 64 };
+	int m_gameCacheBudgetStaticObject { 128 };
+	int m_gameCacheBudgetTexture { 256 };
+	int m_gameCacheBudgetMaterial { 16 };
+	int m_gameCacheBudgetParticleEffect { 32 };
+	float m_gameCachePrefetchBudgetMs { 2.0f };
+	ICVar* m_gameCacheWarmSet;
+
+	// Mechanical displays - clocks, gauges and the like.
+	int m_mechanicalDisplayDebug { 0 };
+	float m_mechanicalDisplayTickRate { 10.0f };
+	float m_mechanicalDisplayLodDistance { 30.0f };
+	float m_mechanicalDisplayLodInterval { 1.0f };
+
+	// Water level service.
+	int m_waterLevelServiceDebug { 0 };
+	float m_waterLevelCellSize { 2.0f };
+	float m_waterLevelLifetime { 0.5f };
+	float m_waterBottomLifetime { 10.0f };
+
+	// DRS signal bus.
+	int m_drsSignalBusDebug { 0 };
+
 	// Camera manager
-	ICVar* m_cameraManagerDebugViewOffset;
+	CVec3CVar m_cameraManagerDebugViewOffset;
 	int m_cameraManagerDefaultCamera { 1 };
 
 	// Action RPG Camera
@@ -41,8 +114,12 @@ public:
 	float m_actionRPGCameraZoomMax;
 	float m_actionRPGCameraZoomStep;
 	float m_actionRPGCameraZoomSpeed;
-	ICVar* m_actionRPGCameraViewPositionOffset;
-	ICVar* m_actionRPGCameraAimPositionOffset;
+	CVec3CVar m_actionRPGCameraViewPositionOffset;
+	CVec3CVar m_actionRPGCameraAimPositionOffset;
+	float m_actionRPGCameraCollisionRadius { 0.2f };
+	float m_actionRPGCameraCollisionHysteresis { 0.15f };
+	float m_actionRPGCameraCollisionEaseOutSpeed { 4.0f };
+	int m_actionRPGCameraCollisionProbes { 1 };
 
 	// First Person Camera
 	int m_firstPersonCameraDebug { 0 };
@@ -72,6 +149,32 @@ public:
 	static void OnAttach(IConsoleCmdArgs* pConsoleCommandArgs);
 
 
+	/**
+	Logs how many of each type of animation action are alive, and the most there have been at once.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnActionPoolStats(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Logs the counters for the state machines.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnStateMachineStats(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+#if BENCHMARK_ENABLED
+	/**
+	Runs the micro-benchmarks for the core gameplay hot paths, and logs the results.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnBenchmark(IConsoleCmdArgs* pConsoleCommandArgs);
+#endif // BENCHMARK_ENABLED
+
+
 	/**
 	Requests a new ObjectId to be created, and output to the log.
 
@@ -80,12 +183,67 @@ public:
 	static void OnCreateObjectId(IConsoleCmdArgs* pConsoleCommandArgs);
 
 
+	/**
+	Creates ObjectIds from several threads at once, and reports on whether they were all unique and how long it took.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnObjectIdStressTest(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Checks that procedural context request identifiers stay unique as their slots are reused, and logs the results.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnRequestListSelfTest(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
 	/**
 	Makes a request for the character under player command to perform an emote.
 
 	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
 	**/
 	static void OnEmote(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Sets which categories of gameplay event are traced, or logs the current categories if none are given.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnGameplayTrace(IConsoleCmdArgs* pConsoleCommandArgs);
+
+
+	/**
+	Writes the most recent traced gameplay events to the log.
+
+	\param [in,out]	pConsoleCommandArgs If non-null, the console command arguments.
+	**/
+	static void OnGameplayTraceDump(IConsoleCmdArgs* pConsoleCommandArgs);
+
+private:
+	/**
+	Registers a typed console variable, and parses its default value.
+
+	\param [in,out]	typedCVar    The typed console variable.
+	\param 		   	name		 The name of the console variable.
+	\param 		   	defaultValue The default value, as a string.
+	\param 		   	flags		 The console variable flags.
+	\param 		   	help		 The help text.
+	**/
+	void RegisterTypedCVar(CTypedCVarBase& typedCVar, const char* name, const char* defaultValue, int flags, const char* help);
+
+
+	/**
+	Re-parses a typed console variable whenever its string value is changed.
+
+	\param [in,out]	pCVar The console variable which changed.
+	**/
+	static void OnTypedCVarChanged(ICVar* pCVar);
+
+	/** All the typed console variables, so the change callback can find the one which changed. */
+	std::vector<CTypedCVarBase*> m_typedCVars;
 };
 
 extern CCVars g_cvars;
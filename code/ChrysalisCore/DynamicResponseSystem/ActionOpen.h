@@ -1,6 +1,7 @@
 #pragma once
 
 #include <CryDynamicResponseSystem/IDynamicResponseAction.h>
+#include "DynamicResponseSystem/EntityNameResolver.h"
 
 
 namespace Chrysalis
@@ -21,6 +22,9 @@ public:
 
 private:
 	string m_targetName;
+
+	/** The entity m_targetName was last resolved to. */
+	SEntityNameHandle m_targetHandle;
 };
 
 
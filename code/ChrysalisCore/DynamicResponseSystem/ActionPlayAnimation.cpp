@@ -84,18 +84,18 @@ void CActionPlayAnimation::StartAnimation(DRS::IResponseInstance* pResponseInsta
 			if (pContextVariables)
 			{
 				// The animation to play.
-				CHashedString animationFile = DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationFile", CHashedString(""));
+				CHashedString animationFile = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationFile, DRSKeys::kEmpty);
 
 				// Playback parameters.
-				aparams.m_fPlaybackSpeed = DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationSpeed", 1.0f);
-				aparams.m_fTransTime = DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationBlendTime", 0.2f);
-				bool isMovementControlled = DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationMovementIsControled", false);
-				aparams.m_nLayerID = m_animationLayer = CLAMP(DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationLayer", 0), 0, 15);
+				aparams.m_fPlaybackSpeed = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationSpeed, 1.0f);
+				aparams.m_fTransTime = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationBlendTime, 0.2f);
+				bool isMovementControlled = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationMovementIsControled, false);
+				aparams.m_nLayerID = m_animationLayer = CLAMP(DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationLayer, 0), 0, 15);
 				aparams.m_nUserToken = GetNextToken();
 
 				// Playback flags.
-				bool isLooped = DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationLooped", false);
-				bool shouldRepeatLastFrame = DRSUtility::GetValueOrDefault(pContextVariables, "PlayAnimationRepeatLastFrame", false);
+				bool isLooped = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationLooped, false);
+				bool shouldRepeatLastFrame = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kPlayAnimationRepeatLastFrame, false);
 				if (isLooped)
 				{
 					aparams.m_nFlags |= CA_LOOP_ANIMATION;
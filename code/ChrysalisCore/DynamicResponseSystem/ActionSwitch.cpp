@@ -15,22 +15,22 @@ DRS::IResponseActionInstanceUniquePtr CActionSwitch::Execute(DRS::IResponseInsta
 
 	if (pResponseActor && pContextVariables)
 	{
-		IEntity* const pEntity = pResponseActor->GetLinkedEntity();
+		IEntity* const pEntity = DRSUtility::GetTargetEntity(pResponseInstance, m_targetName, m_targetHandle);
 
 		if (pEntity)
 		{
 			// They may have sent us a different verb to the standard one.
-			CHashedString verb = DRSUtility::GetValueOrDefault(pContextVariables, "Verb", CHashedString(""));
+			CHashedString verb = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kVerb, DRSKeys::kEmpty);
 
 			// This allows us to select between being switched on and off.
 			// #TODO: Put this into use and look into what else we can add.
-			bool isSwitchOn = DRSUtility::GetValueOrDefault(pContextVariables, "IsSwitchedOn", false);
+			bool isSwitchOn = DRSUtility::GetValueOrDefault(pContextVariables, DRSKeys::kIsSwitchedOn, false);
 
 			if (auto pInteractor = pEntity->GetComponent<CEntityInteractionComponent>())
 			{
 				// Simple option is to play the verb.
 				// #TODO: This should be a little more nuanced.
-				auto pInteraction = pInteractor->GetInteraction(verb.GetText())._Get();
+				auto pInteraction = pInteractor->GetInteraction(verb.GetText().c_str())._Get();
 				if (pInteraction)
 				{
 					pInteraction->OnInteractionStart();
@@ -54,6 +54,10 @@ string CActionSwitch::GetVerboseInfo() const
 void CActionSwitch::Serialize(Serialization::IArchive& ar)
 {
 	ar(m_targetName, "TargetName", "^ TargetName");
+
+	// The name may have been edited.
+	if (ar.isInput())
+		m_targetHandle = SEntityNameHandle();
 }
 
 
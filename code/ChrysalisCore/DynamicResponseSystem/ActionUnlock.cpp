@@ -2,13 +2,14 @@
 
 #include "ActionUnlock.h"
 #include <CryDynamicResponseSystem/IDynamicResponseSystem.h>
+#include "Utility/DRS.h"
 
 
 namespace Chrysalis
 {
 DRS::IResponseActionInstanceUniquePtr CActionUnlock::Execute(DRS::IResponseInstance* pResponseInstance)
 {
-	IEntity* pEntity = pResponseInstance->GetCurrentActor()->GetLinkedEntity();
+	IEntity* pEntity = DRSUtility::GetTargetEntity(pResponseInstance, m_targetName, m_targetHandle);
 	if (pEntity)
 	{
 		auto pContextVariables = pResponseInstance->GetContextVariables();
@@ -31,6 +32,10 @@ string CActionUnlock::GetVerboseInfo() const
 void CActionUnlock::Serialize(Serialization::IArchive& ar)
 {
 	ar(m_targetName, "TargetName", "^ TargetName");
+
+	// The name may have been edited.
+	if (ar.isInput())
+		m_targetHandle = SEntityNameHandle();
 }
 
 
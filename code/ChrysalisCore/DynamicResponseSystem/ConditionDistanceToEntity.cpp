@@ -2,6 +2,7 @@
 
 #include "ConditionDistanceToEntity.h"
 #include <CrySerialization/IArchive.h>
+#include "Plugin/ChrysalisCorePlugin.h"
 
 
 namespace Chrysalis
@@ -24,7 +25,7 @@ CConditionDistanceToEntity::~CConditionDistanceToEntity()
 
 bool CConditionDistanceToEntity::IsMet(DRS::IResponseInstance* pResponseInstance)
 {
-	IEntity* pTargetEntity = gEnv->pEntitySystem->FindEntityByName(m_entityName.c_str());
+	IEntity* pTargetEntity = CChrysalisCorePlugin::Get()->GetEntityNameResolver()->Resolve(m_entityName, m_entityHandle);
 	if (pTargetEntity)
 	{
 		IEntity* pSourceEntity = pResponseInstance->GetCurrentActor()->GetLinkedEntity();
@@ -44,6 +45,10 @@ void CConditionDistanceToEntity::Serialize(Serialization::IArchive& ar)
 	ar(distance, "Distance", "^> Distance");
 	m_squaredDistance = distance * distance;
 	ar(m_entityName, "EntityName", "^EntityName");
+
+	// The name may have been edited.
+	if (ar.isInput())
+		m_entityHandle = SEntityNameHandle();
 }
 
 
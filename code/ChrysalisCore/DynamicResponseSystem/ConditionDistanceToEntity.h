@@ -2,6 +2,7 @@
 
 #include <CryDynamicResponseSystem/IDynamicResponseCondition.h>
 #include <CryDynamicResponseSystem/IDynamicResponseSystem.h>
+#include "DynamicResponseSystem/EntityNameResolver.h"
 
 namespace Chrysalis
 {
@@ -24,7 +25,11 @@ public:
 	// ~IResponseCondition
 
 private:
+	/** Kept squared, so the test doesn't need a square root. */
 	float m_squaredDistance { 100.0f };
 	string m_entityName;
+
+	/** The entity m_entityName was last resolved to. */
+	SEntityNameHandle m_entityHandle;
 };
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <StdAfx.h>
+
+#include "DRSSignalBus.h"
+#include <CryEntitySystem/IEntity.h>
+#include <Console/CVars.h>
+
+
+namespace Chrysalis
+{
+const std::vector<EntityId>& CLinkedResponseActors::Get(IEntity* pEntity)
+{
+	if (m_isValid)
+		return m_entityIds;
+
+	m_entityIds.clear();
+
+	auto* entityLinks = pEntity->GetEntityLinks();
+	while (entityLinks)
+	{
+		if (auto pTargetEntity = gEnv->pEntitySystem->GetEntity(entityLinks->entityId))
+		{
+			// Make sure the target entity has a DRS proxy.
+			auto pDrsProxy = crycomponent_cast<IEntityDynamicResponseComponent*> (pTargetEntity->CreateProxy(ENTITY_PROXY_DYNAMICRESPONSE));
+			if (pDrsProxy && pDrsProxy->GetResponseActor())
+				m_entityIds.push_back(pTargetEntity->GetId());
+		}
+
+		entityLinks = entityLinks->next;
+	}
+
+	m_isValid = true;
+
+	return m_entityIds;
+}
+
+
+CDRSSignalBus::CDRSSignalBus()
+{
+}
+
+
+CDRSSignalBus::~CDRSSignalBus()
+{
+}
+
+
+void CDRSSignalBus::Queue(EntityId entityId, const CHashedString& signal, uint32 coalesceKey, const DRS::IVariableCollectionSharedPtr& pContext)
+{
+	m_stats.queued++;
+
+	// The key is only a hash, so make sure it really is the same signal before replacing it. If it's not, step along to
+	// the next key. Nothing is removed from the lookup until the whole queue is sent, so a signal which collided is
+	// always found again by stepping along the same way.
+	uint64 pendingKey = GetPendingKey(entityId, signal, coalesceKey);
+	for (auto it = m_pendingLookup.find(pendingKey); it != m_pendingLookup.end(); it = m_pendingLookup.find(++pendingKey))
+	{
+		SPendingSignal& pendingSignal = m_pending [it->second];
+		if ((pendingSignal.entityId == entityId) && (pendingSignal.signal == signal) && (pendingSignal.coalesceKey == coalesceKey))
+		{
+			// The earlier signal is dropped and this one goes on the end, rather than taking its place. Otherwise on, off,
+			// on within a frame would be sent as on, off, and the linked entities would end up in the wrong state.
+			pendingSignal.entityId = INVALID_ENTITYID;
+			pendingSignal.pContext.reset();
+			m_stats.coalesced++;
+
+			break;
+		}
+
+		m_stats.collisions++;
+	}
+
+	// Either a new key, or the one the replaced signal was using.
+	m_pendingLookup [pendingKey] = uint32(m_pending.size());
+
+	SPendingSignal pendingSignal;
+	pendingSignal.entityId = entityId;
+	pendingSignal.signal = signal;
+	pendingSignal.coalesceKey = coalesceKey;
+	pendingSignal.pContext = pContext;
+	m_pending.push_back(pendingSignal);
+}
+
+
+void CDRSSignalBus::Update()
+{
+	for (auto& pendingSignal : m_pending)
+	{
+		// Replaced by a later copy of the same signal.
+		if (pendingSignal.entityId == INVALID_ENTITYID)
+			continue;
+
+		// The entity may have been removed since the signal was queued, taking its response actor with it.
+		auto pEntity = gEnv->pEntitySystem->GetEntity(pendingSignal.entityId);
+		auto pDrsComponent = pEntity ? pEntity->GetComponent<IEntityDynamicResponseComponent>() : nullptr;
+		auto pResponseActor = pDrsComponent ? pDrsComponent->GetResponseActor() : nullptr;
+
+		if (pResponseActor)
+		{
+			pResponseActor->QueueSignal(pendingSignal.signal, pendingSignal.pContext);
+			m_stats.sent++;
+		}
+		else
+		{
+			m_stats.dropped++;
+		}
+	}
+
+	// The queue keeps its storage, so a steady stream of signals doesn't need to grow it each frame.
+	m_pending.clear();
+	m_pendingLookup.clear();
+
+	m_lastStats = m_stats;
+	m_stats = SStats();
+
+	if (g_cvars.m_drsSignalBusDebug)
+	{
+		CryWatch("DRS signal bus: last frame - queued %d, coalesced %d, sent %d, dropped %d, key collisions %d",
+			m_lastStats.queued, m_lastStats.coalesced, m_lastStats.sent, m_lastStats.dropped, m_lastStats.collisions);
+	}
+}
+
+
+void CDRSSignalBus::Reset()
+{
+	m_pending.clear();
+	m_pendingLookup.clear();
+	m_stats = SStats();
+	m_lastStats = SStats();
+}
+
+
+void CDRSSignalBus::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddContainer(m_pending);
+	pSizer->AddObject(m_pendingLookup);
+}
+
+
+uint64 CDRSSignalBus::GetPendingKey(EntityId entityId, const CHashedString& signal, uint32 coalesceKey)
+{
+	return (uint64(entityId) << 32) | (signal.GetHash() ^ (coalesceKey * 0x9e3779b9));
+}
+}
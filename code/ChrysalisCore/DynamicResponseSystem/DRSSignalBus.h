@@ -0,0 +1,114 @@
+/**
+\file	DynamicResponseSystem\DRSSignalBus.h
+
+Gameplay code often needs to tell every entity wired to it that something happened, such as a switch being thrown or an
+interaction ticking. Rather than queueing each signal with its response actor there and then, senders queue them on the
+signal bus and they are handed to the DRS together once per frame. If the same signal is queued for the same actor more
+than once in a frame, which is what happens when an interaction ticks every frame, only the last one is sent. It is
+sent in the position of the last copy, so signals for different verbs still arrive in the order they last happened.
+
+Senders keep a CLinkedResponseActors so their entity links are only followed, and the DRS proxies created, when the links
+change, instead of on every signal. Only the entity identifiers are kept. The response actor is looked up when the signal
+is sent, so a signal for an entity which has been removed, or has lost its DRS component, is simply dropped.
+**/
+#pragma once
+
+#include <CryDynamicResponseSystem/IDynamicResponseSystem.h>
+
+
+namespace Chrysalis
+{
+/** The linked entities which have response actors, resolved when first needed and kept until the links change. */
+class CLinkedResponseActors
+{
+public:
+	/**
+	Gets the linked entities which have response actors, resolving them again if the links have changed. A link to an
+	entity which doesn't exist is skipped.
+
+	\param	pEntity The entity whose links should be followed.
+
+	\return The linked entity identifiers. The reference is only valid until the links are next resolved.
+	**/
+	const std::vector<EntityId>& Get(IEntity* pEntity);
+
+
+	/** Forgets the resolved actors. Call this whenever the entity's links change. */
+	void Invalidate() { m_isValid = false; }
+
+private:
+	std::vector<EntityId> m_entityIds;
+
+	bool m_isValid { false };
+};
+
+
+class CDRSSignalBus
+{
+public:
+	CDRSSignalBus();
+	virtual ~CDRSSignalBus();
+
+
+	/**
+	Queues a signal to be sent to an entity's response actor when the bus is next updated. A signal which has the same name
+	and coalesce key as one already queued for that entity replaces it, and moves to the back of the queue.
+
+	\param	entityId	Identifier for the entity.
+	\param	signal		The name of the signal.
+	\param	coalesceKey Signals which differ only in the values of their context variables should share a key, e.g. the
+						hash of the verb they pass along.
+	\param	pContext	The context variables for the signal. These may be shared by every signal in a fan-out.
+	**/
+	void Queue(EntityId entityId, const CHashedString& signal, uint32 coalesceKey, const DRS::IVariableCollectionSharedPtr& pContext);
+
+
+	/** Sends every queued signal to its entity's response actor, and shows the statistics. Call this once per frame. */
+	void Update();
+
+
+	/** Drops every queued signal without sending it. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+private:
+	struct SPendingSignal
+	{
+		EntityId entityId { INVALID_ENTITYID };
+		CHashedString signal;
+		uint32 coalesceKey { 0 };
+		DRS::IVariableCollectionSharedPtr pContext;
+	};
+
+	struct SStats
+	{
+		int queued { 0 };
+		int coalesced { 0 };
+		int sent { 0 };
+
+		/** Signals whose entity was removed, or lost its response actor, before they could be sent. */
+		int dropped { 0 };
+
+		/** Different signals which wanted the same pending key. */
+		int collisions { 0 };
+	};
+
+	/** Combines the entity, signal and coalesce key into a key for the pending lookup. */
+	static uint64 GetPendingKey(EntityId entityId, const CHashedString& signal, uint32 coalesceKey);
+
+	/** The signals waiting to be sent, in the order they were last queued. Replaced signals are left with no entity. */
+	std::vector<SPendingSignal> m_pending;
+
+	/**
+	Index of each pending signal into m_pending. A signal whose key is already taken by a different signal uses the next
+	free key along, so a lookup has to keep stepping forward until it finds its signal or an unused key.
+	**/
+	std::unordered_map<uint64, uint32> m_pendingLookup;
+
+	/** Statistics are gathered over each frame, and the last full frame is shown. */
+	SStats m_stats;
+	SStats m_lastStats;
+};
+}
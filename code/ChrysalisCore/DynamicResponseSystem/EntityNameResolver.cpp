@@ -0,0 +1,167 @@
+#include <StdAfx.h>
+
+#include "EntityNameResolver.h"
+#include <CryEntitySystem/IEntity.h>
+
+
+namespace Chrysalis
+{
+namespace
+{
+CryHash GetNameHash(const char* name)
+{
+	return CryHashStringId(name).id;
+}
+}
+
+
+CEntityNameResolver::CEntityNameResolver()
+{
+}
+
+
+CEntityNameResolver::~CEntityNameResolver()
+{
+	if (m_isListening && gEnv->pEntitySystem)
+		gEnv->pEntitySystem->RemoveSink(this);
+}
+
+
+void CEntityNameResolver::Init()
+{
+	// We only need to hear about name changes, not every event for every entity.
+	gEnv->pEntitySystem->AddSink(this,
+		IEntitySystem::OnSpawn | IEntitySystem::OnRemove | IEntitySystem::OnReused | IEntitySystem::OnEvent,
+		BIT64(ENTITY_EVENT_SET_NAME));
+	m_isListening = true;
+}
+
+
+IEntity* CEntityNameResolver::Resolve(const string& name, SEntityNameHandle& handle)
+{
+	// Nothing has been forgotten since this handle was resolved, so the entity it points at is still the right one.
+	if (handle.generation == m_generation)
+		return (handle.entityId != INVALID_ENTITYID) ? gEnv->pEntitySystem->GetEntity(handle.entityId) : nullptr;
+
+	if (name.empty())
+	{
+		handle.entityId = INVALID_ENTITYID;
+		handle.generation = m_generation;
+
+		return nullptr;
+	}
+
+	const CryHash nameHash = GetNameHash(name.c_str());
+	auto it = m_entries.find(nameHash);
+	if (it == m_entries.end())
+	{
+		IEntity* pEntity = gEnv->pEntitySystem->FindEntityByName(name.c_str());
+
+		SEntry entry;
+		entry.name = name;
+		entry.entityId = pEntity ? pEntity->GetId() : INVALID_ENTITYID;
+		it = m_entries.emplace(nameHash, entry).first;
+
+		if (pEntity)
+			m_entityNames [entry.entityId] = nameHash;
+	}
+	else if (it->second.name != name)
+	{
+		// Another name already has this hash. It's rare enough that we don't bother caching it, and the handle is left
+		// with a generation that never matches, so it's looked up each time.
+		IEntity* pEntity = gEnv->pEntitySystem->FindEntityByName(name.c_str());
+		handle.entityId = pEntity ? pEntity->GetId() : INVALID_ENTITYID;
+		handle.generation = 0;
+
+		return pEntity;
+	}
+
+	handle.entityId = it->second.entityId;
+	handle.generation = m_generation;
+
+	return (handle.entityId != INVALID_ENTITYID) ? gEnv->pEntitySystem->GetEntity(handle.entityId) : nullptr;
+}
+
+
+void CEntityNameResolver::Reset()
+{
+	m_entries.clear();
+	m_entityNames.clear();
+	Invalidate();
+}
+
+
+void CEntityNameResolver::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddObject(m_entries);
+	pSizer->AddObject(m_entityNames);
+}
+
+
+void CEntityNameResolver::OnSpawn(IEntity* pEntity, SEntitySpawnParams& params)
+{
+	ForgetMissingName(pEntity->GetName());
+}
+
+
+bool CEntityNameResolver::OnRemove(IEntity* pEntity)
+{
+	ForgetEntity(pEntity->GetId());
+
+	return true;
+}
+
+
+void CEntityNameResolver::OnReused(IEntity* pEntity, SEntitySpawnParams& params)
+{
+	// The identifier now belongs to what is effectively a new entity, which may well have a different name.
+	ForgetEntity(pEntity->GetId());
+	ForgetMissingName(params.sName);
+}
+
+
+void CEntityNameResolver::OnEvent(IEntity* pEntity, SEntityEvent& event)
+{
+	if (event.event == ENTITY_EVENT_SET_NAME)
+	{
+		ForgetEntity(pEntity->GetId());
+		ForgetMissingName(pEntity->GetName());
+	}
+}
+
+
+void CEntityNameResolver::ForgetEntity(EntityId entityId)
+{
+	auto it = m_entityNames.find(entityId);
+	if (it == m_entityNames.end())
+		return;
+
+	m_entries.erase(it->second);
+	m_entityNames.erase(it);
+	Invalidate();
+}
+
+
+void CEntityNameResolver::ForgetMissingName(const char* name)
+{
+	if (!name || !name [0])
+		return;
+
+	// If the name already resolved to an entity we keep it, just as finding it by name would keep finding that one.
+	auto it = m_entries.find(GetNameHash(name));
+	if ((it != m_entries.end()) && (it->second.entityId == INVALID_ENTITYID))
+	{
+		m_entries.erase(it);
+		Invalidate();
+	}
+}
+
+
+void CEntityNameResolver::Invalidate()
+{
+	// Zero is reserved for handles which are never valid.
+	if (++m_generation == 0)
+		m_generation = 1;
+}
+}
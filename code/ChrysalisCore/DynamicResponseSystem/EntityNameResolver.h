@@ -0,0 +1,97 @@
+/**
+\file	DynamicResponseSystem\EntityNameResolver.h
+
+Resolves the entity names used by our DRS conditions and actions into entity identifiers. Finding an entity by name has
+to walk every entity in the level, which is far too slow to do each time a condition is evaluated. Names are resolved
+once and kept until the entity system tells us an entity with that name has been spawned, removed or renamed.
+
+Conditions and actions hold onto an SEntityNameHandle for their name. The handle remembers the entity it resolved to,
+along with the generation of the resolver at that time. While nothing has been invalidated, resolving through a handle
+is no more than a lookup by identifier.
+**/
+#pragma once
+
+#include <CryEntitySystem/IEntitySystem.h>
+#include "Utility/CryHash.h"
+
+
+namespace Chrysalis
+{
+/** The last resolution of a name, as held by a condition or action. */
+struct SEntityNameHandle
+{
+	EntityId entityId { INVALID_ENTITYID };
+
+	/** The generation of the resolver when this was resolved. Zero is never a valid generation. */
+	uint32 generation { 0 };
+};
+
+
+class CEntityNameResolver final : public IEntitySystemSink
+{
+public:
+	CEntityNameResolver();
+	virtual ~CEntityNameResolver();
+
+
+	/** Starts listening to the entity system for the events which invalidate a resolved name. */
+	void Init();
+
+
+	/**
+	Finds the entity with the given name. Names which don't match an entity are remembered as well, so a condition which
+	refers to an entity that doesn't exist yet won't walk the entity system each time it's evaluated.
+
+	\param 		   	name   The name of the entity.
+	\param [in,out]	handle The handle for the name, which is updated if the name needed to be resolved again.
+
+	\return Null if there is no entity with that name, else the entity.
+	**/
+	IEntity* Resolve(const string& name, SEntityNameHandle& handle);
+
+
+	/** Forgets every resolved name. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+	// IEntitySystemSink
+	virtual bool OnBeforeSpawn(SEntitySpawnParams& params) override { return true; }
+	virtual void OnSpawn(IEntity* pEntity, SEntitySpawnParams& params) override;
+	virtual bool OnRemove(IEntity* pEntity) override;
+	virtual void OnReused(IEntity* pEntity, SEntitySpawnParams& params) override;
+	virtual void OnEvent(IEntity* pEntity, SEntityEvent& event) override;
+	// ~IEntitySystemSink
+
+private:
+	/** Forgets the name an entity was resolved under, if any. */
+	void ForgetEntity(EntityId entityId);
+
+	/** Forgets a name which didn't match an entity when it was resolved, as it might now. */
+	void ForgetMissingName(const char* name);
+
+	/** Makes every handle resolve again the next time it is used. */
+	void Invalidate();
+
+	struct SEntry
+	{
+		/** Kept to guard against two names which hash to the same value. */
+		string name;
+
+		/** The entity with this name, or INVALID_ENTITYID if there wasn't one. */
+		EntityId entityId { INVALID_ENTITYID };
+	};
+
+	/** Resolved names, keyed on a hash of the name. */
+	std::unordered_map<CryHash, SEntry> m_entries;
+
+	/** The name hash each resolved entity is stored under, so we can find it again after a rename. */
+	std::unordered_map<EntityId, CryHash> m_entityNames;
+
+	/** Bumped each time a resolved name is forgotten. */
+	uint32 m_generation { 1 };
+
+	bool m_isListening { false };
+};
+}
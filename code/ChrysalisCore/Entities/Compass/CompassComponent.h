@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Components/Interaction/EntityInteractionComponent.h>
+#include <Utility/GameplayTrace.h>
 #include <DefaultComponents/Geometry/StaticMeshComponent.h>
 #include <Components/Animation/ControlledAnimationComponent.h>
 
@@ -32,10 +33,10 @@ public:
 	}
 
 	// IInteractionItem
-	void OnInteractionItemInspect() override { gEnv->pLog->LogAlways("OnInteractionItemInspect fired."); };
-	void OnInteractionItemPickup() override { gEnv->pLog->LogAlways("OnInteractionItemPickup fired."); };
-	void OnInteractionItemDrop() override { gEnv->pLog->LogAlways("OnInteractionItemDrop fired."); };
-	void OnInteractionItemToss() override { gEnv->pLog->LogAlways("OnInteractionItemToss fired."); };
+	void OnInteractionItemInspect() override { GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemInspect, GetEntityId()); };
+	void OnInteractionItemPickup() override { GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemPickup, GetEntityId()); };
+	void OnInteractionItemDrop() override { GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemDrop, GetEntityId()); };
+	void OnInteractionItemToss() override { GameplayTrace(eGTC_Item, EGameplayTraceEvent::ItemToss, GetEntityId()); };
 	// IInteractionItem
 
 	virtual void OnResetState() final;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Entities/Interaction/IEntityInteraction.h>
+#include <Utility/GameplayTrace.h>
 #include <DefaultComponents/Geometry/AnimatedMeshComponent.h>
 #include <DefaultComponents/Physics/RigidBodyComponent.h>
 
@@ -46,19 +47,19 @@ public:
 
 	// IInteractionInteract
 	void OnInteractionInteractStart() override;
-	void OnInteractionInteractTick() override { gEnv->pLog->LogAlways("OnInteractionInteractTick fired."); };
-	void OnInteractionInteractComplete() override { gEnv->pLog->LogAlways("OnInteractionInteractComplete fired."); };
-	void OnInteractionInteractCancel() override { gEnv->pLog->LogAlways("OnInteractionInteractCancel fired."); };
+	void OnInteractionInteractTick() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractTick, GetEntityId()); };
+	void OnInteractionInteractComplete() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractComplete, GetEntityId()); };
+	void OnInteractionInteractCancel() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractCancel, GetEntityId()); };
 	// ~IInteractionInteract
 
 	// IInteractionOpenable
-	void OnInteractionOpenableOpen() override { gEnv->pLog->LogAlways("OnInteractionOpenableOpen fired."); };
-	void OnInteractionOpenableClose() override { gEnv->pLog->LogAlways("OnInteractionOpenableClose fired."); };
+	void OnInteractionOpenableOpen() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::OpenableOpen, GetEntityId()); };
+	void OnInteractionOpenableClose() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::OpenableClose, GetEntityId()); };
 	// ~IInteractionOpenable
 
 	// IInteractionLockable
-	void OnInteractionLockableLock() override { gEnv->pLog->LogAlways("OnInteractionLockableLock fired."); };
-	void OnInteractionLockableUnlock() override { gEnv->pLog->LogAlways("OnInteractionLockableUnlock fired."); };
+	void OnInteractionLockableLock() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::LockableLock, GetEntityId()); };
+	void OnInteractionLockableUnlock() override { GameplayTrace(eGTC_Openable, EGameplayTraceEvent::LockableUnlock, GetEntityId()); };
 	// ~IInteractionLockable
 
 private:
@@ -7,6 +7,7 @@
 #include <SharedParameters/DynamicLight.h>
 #include <Entities/EntityEffects.h>
 #include <Entities/Interaction/IEntityInteraction.h>
+#include <Utility/GameplayTrace.h>
 #include <DefaultComponents/Geometry/StaticMeshComponent.h>
 #include <Components/Lights/DynamicLightComponent.h>
 #include <DefaultComponents/Physics/RigidBodyComponent.h>
@@ -59,16 +60,16 @@ public:
 	// ~CDynamicLightComponent::IDynamicLightListener
 
 	// IInteractionInteract
-	void OnInteractionInteractStart() override { gEnv->pLog->LogAlways("OnInteractionInteractStart fired."); };
-	void OnInteractionInteractTick() override { gEnv->pLog->LogAlways("OnInteractionInteractTick fired."); };
-	void OnInteractionInteractComplete() override { gEnv->pLog->LogAlways("OnInteractionInteractComplete fired."); };
-	void OnInteractionInteractCancel() override { gEnv->pLog->LogAlways("OnInteractionInteractCancel fired."); };
+	void OnInteractionInteractStart() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractStart, GetEntityId()); };
+	void OnInteractionInteractTick() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractTick, GetEntityId()); };
+	void OnInteractionInteractComplete() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractComplete, GetEntityId()); };
+	void OnInteractionInteractCancel() override { GameplayTrace(eGTC_Interact, EGameplayTraceEvent::InteractCancel, GetEntityId()); };
 	// ~IInteractionInteract
 
 	// IInteractionSwitch
-	void OnInteractionSwitchToggle() override { gEnv->pLog->LogAlways("OnInteractionSwitchToggle fired."); ToggleSwitch(); };
-	void OnInteractionSwitchOn() override { gEnv->pLog->LogAlways("OnInteractionSwitchOn fired."); Switch(true); };
-	void OnInteractionSwitchOff() override { gEnv->pLog->LogAlways("OnInteractionSwitchOff fired."); Switch(false); };
+	void OnInteractionSwitchToggle() override { GameplayTrace(eGTC_Switch, EGameplayTraceEvent::SwitchToggle, GetEntityId()); ToggleSwitch(); };
+	void OnInteractionSwitchOn() override { GameplayTrace(eGTC_Switch, EGameplayTraceEvent::SwitchOn, GetEntityId()); Switch(true); };
+	void OnInteractionSwitchOff() override { GameplayTrace(eGTC_Switch, EGameplayTraceEvent::SwitchOff, GetEntityId()); Switch(false); };
 	// ~IInteractionSwitch
 
 	// ***
@@ -20,8 +20,12 @@ struct IInteraction
 	virtual void OnInteractionCancel() {};
 
 	bool IsUseable() const { return true; };
-	virtual const string GetVerb() const { return "interaction_interact"; };
-	virtual const string GetVerbUI() const { return "@" + GetVerb(); };
+
+	/** The verb is a literal which lives as long as the interaction, so it's handed out without copying. */
+	virtual const char* GetVerb() const { return "interaction_interact"; };
+
+	/** The localisation label for the verb. This allocates, so only ask for it when it's about to be displayed. */
+	virtual string GetVerbUI() const { return string("@") + GetVerb(); };
 
 	bool IsEnabled() const { return m_isEnabled; };
 	void SetEnabled(bool isEnabled) { m_isEnabled = isEnabled; };
@@ -57,7 +61,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_examine"; };
+	const char* GetVerb() const override { return "interaction_examine"; };
 	void OnInteractionStart() override { m_subject->OnInteractionExamineStart(); };
 	void OnInteractionComplete() override { m_subject->OnInteractionExamineComplete(); };
 	void OnInteractionCancel() override { m_subject->OnInteractionExamineCancel(); };
@@ -92,7 +96,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_interact"; };
+	const char* GetVerb() const override { return "interaction_interact"; };
 	void OnInteractionStart() override { m_subject->OnInteractionInteractStart(); };
 	void OnInteractionTick() override { m_subject->OnInteractionInteractTick(); };
 	void OnInteractionComplete() override { m_subject->OnInteractionInteractComplete(); };
@@ -124,7 +128,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_drs"; };
+	const char* GetVerb() const override { return "interaction_drs"; };
 	void OnInteractionStart() override { m_subject->OnInteractionDRS(); };
 
 private:
@@ -155,7 +159,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_switch_toggle"; };
+	const char* GetVerb() const override { return "interaction_switch_toggle"; };
 	void OnInteractionStart() override { m_subject->OnInteractionSwitchToggle(); };
 
 private:
@@ -174,7 +178,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_switch_on"; };
+	const char* GetVerb() const override { return "interaction_switch_on"; };
 	void OnInteractionStart() override { m_subject->OnInteractionSwitchOn(); };
 
 private:
@@ -193,7 +197,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_switch_off"; };
+	const char* GetVerb() const override { return "interaction_switch_off"; };
 	void OnInteractionStart() override { m_subject->OnInteractionSwitchOff(); };
 
 private:
@@ -226,7 +230,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_inspect"; };
+	const char* GetVerb() const override { return "interaction_inspect"; };
 	void OnInteractionStart() override { m_subject->OnInteractionItemInspect(); };
 
 private:
@@ -245,7 +249,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_pickup"; };
+	const char* GetVerb() const override { return "interaction_pickup"; };
 	void OnInteractionStart() override { m_subject->OnInteractionItemPickup(); };
 
 private:
@@ -264,7 +268,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_drop"; };
+	const char* GetVerb() const override { return "interaction_drop"; };
 	void OnInteractionStart() override { m_subject->OnInteractionItemDrop(); };
 
 private:
@@ -283,7 +287,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_toss"; };
+	const char* GetVerb() const override { return "interaction_toss"; };
 	void OnInteractionStart() override { m_subject->OnInteractionItemToss(); };
 
 private:
@@ -314,7 +318,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_openable_open"; };
+	const char* GetVerb() const override { return "interaction_openable_open"; };
 	void OnInteractionStart() override { m_subject->OnInteractionOpenableOpen(); };
 
 private:
@@ -333,7 +337,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_openable_close"; };
+	const char* GetVerb() const override { return "interaction_openable_close"; };
 	void OnInteractionStart() override { m_subject->OnInteractionOpenableClose(); };
 
 private:
@@ -364,7 +368,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_lockable_lock"; };
+	const char* GetVerb() const override { return "interaction_lockable_lock"; };
 	void OnInteractionStart() override { m_subject->OnInteractionLockableLock(); };
 
 private:
@@ -383,7 +387,7 @@ public:
 		m_isHidden = isHidden;
 	};
 
-	const string GetVerb() const override { return "interaction_lockable_unlock"; };
+	const char* GetVerb() const override { return "interaction_lockable_unlock"; };
 	void OnInteractionStart() override { m_subject->OnInteractionLockableUnlock(); };
 
 private:
@@ -409,7 +413,7 @@ DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 //public:
 //	CInteractionDoorOpen(IInteractionDoor* subject) { m_subject = subject; };
 //
-//	const string GetVerb() const override { return "interaction_door_open"; };
+//	const char* GetVerb() const override { return "interaction_door_open"; };
 //	void OnInteractionStart() override { m_subject->OnInteractionDoorOpen(); };
 //
 //private:
@@ -423,7 +427,7 @@ DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 //public:
 //	CInteractionDoorClose(IInteractionDoor* subject) { m_subject = subject; };
 //
-//	const string GetVerb() const override { return "interaction_door_close"; };
+//	const char* GetVerb() const override { return "interaction_door_close"; };
 //	void OnInteractionStart() override { m_subject->OnInteractionDoorClose(); };
 //
 //private:
@@ -451,7 +455,7 @@ DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 //public:
 //	CInteractionContainerOpen(IInteractionContainer* subject) { m_subject = subject; };
 //
-//	const string GetVerb() const override { return "interaction_container_open"; };
+//	const char* GetVerb() const override { return "interaction_container_open"; };
 //	void OnInteractionStart() override { m_subject->OnInteractionContainerOpen(); };
 //
 //private:
@@ -465,7 +469,7 @@ DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 //public:
 //	CInteractionContainerClose(IInteractionContainer* subject) { m_subject = subject; };
 //
-//	const string GetVerb() const override { return "interaction_container_close"; };
+//	const char* GetVerb() const override { return "interaction_container_close"; };
 //	void OnInteractionStart() override { m_subject->OnInteractionContainerClose(); };
 //
 //private:
@@ -479,7 +483,7 @@ DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 //public:
 //	CInteractionContainerLock(IInteractionContainer* subject) { m_subject = subject; };
 //
-//	const string GetVerb() const override { return "interaction_container_lock"; };
+//	const char* GetVerb() const override { return "interaction_container_lock"; };
 //	void OnInteractionStart() override { m_subject->OnInteractionContainerLock(); };
 //
 //private:
@@ -493,7 +497,7 @@ DECLARE_SHARED_POINTERS(CInteractionLockableUnlock);
 //public:
 //	CInteractionContainerUnlock(IInteractionContainer* subject) { m_subject = subject; };
 //
-//	const string GetVerb() const override { return "interaction_container_unlock"; };
+//	const char* GetVerb() const override { return "interaction_container_unlock"; };
 //	void OnInteractionStart() override { m_subject->OnInteractionContainerUnlock(); };
 //
 //private:
@@ -3,6 +3,7 @@
 #include "SecurityPadComponent.h"
 #include "Components/Player/PlayerComponent.h"
 #include <Components/Player/Camera/CameraManagerComponent.h>
+#include <Utility/GameplayTrace.h>
 
 
 namespace Chrysalis
@@ -44,7 +45,7 @@ void CSecurityPadComponent::OnResetState()
 
 void CSecurityPadComponent::OnInteractionExamineStart()
 {
-	gEnv->pLog->LogAlways("OnInteractionExamineStart fired.");
+	GameplayTrace(eGTC_Interact, EGameplayTraceEvent::ExamineStart, GetEntityId());
 
 	// Switch to the examine camera.
 	if (auto pPlayer = CPlayerComponent::GetLocalPlayer())
@@ -57,7 +58,7 @@ void CSecurityPadComponent::OnInteractionExamineStart()
 
 void CSecurityPadComponent::OnInteractionExamineComplete()
 {
-	gEnv->pLog->LogAlways("OnInteractionExamineComplete fired.");
+	GameplayTrace(eGTC_Interact, EGameplayTraceEvent::ExamineComplete, GetEntityId());
 
 	// Switch back to the previous camera.
 	if (auto pPlayer = CPlayerComponent::GetLocalPlayer())
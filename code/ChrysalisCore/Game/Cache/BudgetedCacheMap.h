@@ -0,0 +1,266 @@
+/**
+\file	Game\Cache\BudgetedCacheMap.h
+
+A map of cached assets which keeps track of how much memory the assets are using, and evicts the least recently used
+of them once a memory budget is exceeded. Entries are threaded onto an intrusive LRU list, so touching and evicting an
+entry never allocates. Entries which are pinned are taken off the list entirely until they are unpinned, and so can't be
+evicted.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+/** Memory accounting for one category of cached asset. */
+struct SCacheCategoryStats
+{
+	/** The size of every asset currently held in the cache, including those which are pinned. */
+	size_t residentBytes { 0 };
+
+	/** The size of the assets which are pinned and can't be evicted. */
+	size_t pinnedBytes { 0 };
+
+	/** The total size of every asset which has been evicted from the cache. */
+	size_t evictedBytes { 0 };
+
+	uint32 residentCount { 0 };
+	uint32 evictedCount { 0 };
+};
+
+
+/**
+Assets held by a std::shared_ptr are considered in use while anyone outside of the cache holds a reference. Engine
+smart pointers don't allow us to tell the cache's reference apart from the engine's own, so they rely on pinning.
+**/
+template<typename VALUE>
+ILINE bool IsCachedValueInUse(const VALUE& value) { return false; }
+
+template<typename TYPE>
+ILINE bool IsCachedValueInUse(const std::shared_ptr<TYPE>& value) { return value.use_count() > 1; }
+
+
+template<typename KEY, typename VALUE, typename COMPARE = std::less<KEY>>
+class CBudgetedCacheMap
+{
+public:
+	CBudgetedCacheMap() = default;
+	CBudgetedCacheMap(const CBudgetedCacheMap&) = delete;
+	CBudgetedCacheMap& operator=(const CBudgetedCacheMap&) = delete;
+
+
+	/** Determines if there is an entry for the key, without counting it as a use. */
+	bool Contains(const KEY& key) const { return m_entries.find(key) != m_entries.end(); }
+
+
+	/**
+	Finds the value for a key, marking it as the most recently used entry.
+
+	\param	key The key.
+
+	\return The value, or nullptr if there is no entry for the key.
+	**/
+	const VALUE* Find(const KEY& key)
+	{
+		auto it = m_entries.find(key);
+		if (it == m_entries.end())
+			return nullptr;
+
+		SEntry& entry = it->second;
+		if (entry.pinCount == 0)
+		{
+			Unlink(entry);
+			LinkAtHead(entry);
+		}
+
+		return &entry.value;
+	}
+
+
+	/**
+	Adds a value to the cache as the most recently used entry. Existing entries are left untouched. Room is made for the
+	new entry before it's added, so it can never be the one which is evicted to fit it within the budget.
+
+	\param	key		    The key.
+	\param	value	    The value.
+	\param	bytes	    The memory used by the asset.
+	\param	budgetBytes The budget in bytes. A budget of zero is unlimited.
+	**/
+	void Insert(const KEY& key, const VALUE& value, const size_t bytes, const size_t budgetBytes)
+	{
+		if (Contains(key))
+			return;
+
+		Evict(budgetBytes, bytes);
+
+		auto result = m_entries.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple());
+		if (!result.second)
+			return;
+
+		SEntry& entry = result.first->second;
+		entry.key = key;
+		entry.value = value;
+		entry.bytes = bytes;
+		LinkAtHead(entry);
+
+		m_stats.residentBytes += bytes;
+		m_stats.residentCount++;
+	}
+
+
+	/**
+	Prevents an entry from being evicted until it has been unpinned as many times as it was pinned.
+
+	\param	key The key.
+
+	\return True if there was an entry to pin.
+	**/
+	bool Pin(const KEY& key)
+	{
+		auto it = m_entries.find(key);
+		if (it == m_entries.end())
+			return false;
+
+		SEntry& entry = it->second;
+		if (entry.pinCount++ == 0)
+		{
+			Unlink(entry);
+			m_stats.pinnedBytes += entry.bytes;
+		}
+
+		return true;
+	}
+
+
+	/**
+	Releases a pin on an entry. Once the last pin is released it becomes the most recently used entry.
+
+	\param	key The key.
+
+	\return True if there was a pinned entry to unpin.
+	**/
+	bool Unpin(const KEY& key)
+	{
+		auto it = m_entries.find(key);
+		if ((it == m_entries.end()) || (it->second.pinCount == 0))
+			return false;
+
+		SEntry& entry = it->second;
+		if (--entry.pinCount == 0)
+		{
+			LinkAtHead(entry);
+			m_stats.pinnedBytes -= entry.bytes;
+		}
+
+		return true;
+	}
+
+
+	/**
+	Evicts the least recently used entries until the cache fits within the budget. Pinned entries and those still in use
+	are skipped, so it's possible for the cache to remain over budget.
+
+	\param	budgetBytes   The budget in bytes. A budget of zero is unlimited.
+	\param	incomingBytes (Optional) Room to leave within the budget for an entry which is about to be added.
+	**/
+	void Evict(const size_t budgetBytes, const size_t incomingBytes = 0)
+	{
+		if (budgetBytes == 0)
+			return;
+
+		SEntry* pEntry = m_pLruTail;
+		while (pEntry && (m_stats.residentBytes + incomingBytes > budgetBytes))
+		{
+			SEntry* pNext = pEntry->pLruPrev;
+
+			if (!IsCachedValueInUse(pEntry->value))
+			{
+				Unlink(*pEntry);
+
+				m_stats.residentBytes -= pEntry->bytes;
+				m_stats.residentCount--;
+				m_stats.evictedBytes += pEntry->bytes;
+				m_stats.evictedCount++;
+
+				// The key needs to be copied out, as erasing the entry destroys it.
+				const KEY key = pEntry->key;
+				m_entries.erase(key);
+			}
+
+			pEntry = pNext;
+		}
+	}
+
+
+	/** Removes every entry, pinned or not. The eviction totals are kept, as they cover the whole session. */
+	void Clear()
+	{
+		m_entries.clear();
+		m_pLruHead = m_pLruTail = nullptr;
+		m_stats.residentBytes = 0;
+		m_stats.residentCount = 0;
+		m_stats.pinnedBytes = 0;
+	}
+
+
+	const SCacheCategoryStats& GetStats() const { return m_stats; }
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const
+	{
+		pSizer->AddContainer(m_entries);
+	}
+
+private:
+	struct SEntry
+	{
+		KEY key;
+		VALUE value;
+		size_t bytes { 0 };
+		int pinCount { 0 };
+
+		/** Towards the most recently used entry. */
+		SEntry* pLruPrev { nullptr };
+
+		/** Towards the least recently used entry. */
+		SEntry* pLruNext { nullptr };
+	};
+
+
+	void LinkAtHead(SEntry& entry)
+	{
+		entry.pLruPrev = nullptr;
+		entry.pLruNext = m_pLruHead;
+
+		if (m_pLruHead)
+			m_pLruHead->pLruPrev = &entry;
+		else
+			m_pLruTail = &entry;
+
+		m_pLruHead = &entry;
+	}
+
+
+	void Unlink(SEntry& entry)
+	{
+		if (entry.pLruPrev)
+			entry.pLruPrev->pLruNext = entry.pLruNext;
+		else if (m_pLruHead == &entry)
+			m_pLruHead = entry.pLruNext;
+
+		if (entry.pLruNext)
+			entry.pLruNext->pLruPrev = entry.pLruPrev;
+		else if (m_pLruTail == &entry)
+			m_pLruTail = entry.pLruPrev;
+
+		entry.pLruPrev = entry.pLruNext = nullptr;
+	}
+
+	/** Map nodes never move, so the LRU list is able to point straight at the entries. */
+	std::map<KEY, SEntry, COMPARE> m_entries;
+
+	SEntry* m_pLruHead { nullptr };
+	SEntry* m_pLruTail { nullptr };
+
+	SCacheCategoryStats m_stats;
+};
+}
@@ -5,10 +5,49 @@
 #include <CryAnimation/ICryAnimation.h>
 #include "Item/Parameters/ItemParameter.h"
 #include <CryString/StringUtils.h>
+#include <Console/CVars.h>
+#include <CryThreading/IJobManager.h>
 
 
 namespace Chrysalis
 {
+/**
+Measures the memory used by an asset. This walks the asset with a sizer, so it's only done once, when the asset is
+first cached.
+
+\param	pAsset The asset.
+
+\return The size of the asset in bytes.
+**/
+template<typename TYPE>
+static size_t GetAssetMemoryUsage(const TYPE* pAsset)
+{
+	ICrySizer* pSizer = gEnv->pSystem->CreateSizer();
+	pAsset->GetMemoryUsage(pSizer);
+	const size_t bytes = pSizer->GetTotalSize();
+	pSizer->Release();
+
+	return bytes;
+}
+
+
+/**
+Wraps a reference counted engine object in a std::shared_ptr. The engine owns these objects, so the last reference
+must release the object rather than delete it.
+
+\param [in,out]	pObject The object.
+
+\return A shared pointer holding a reference to the object.
+**/
+template<typename TYPE>
+static std::shared_ptr<TYPE> MakeSharedEngineObject(TYPE* pObject)
+{
+	pObject->AddRef();
+
+	return std::shared_ptr<TYPE>(pObject, [](TYPE* pReleaseObject) { pReleaseObject->Release(); });
+}
+
+
 CGameCache::CGameCache()
 {}
 
@@ -25,21 +64,154 @@ void CGameCache::Init()
 
 void CGameCache::Reset()
 {
-	m_textureCache.clear();
-	m_materialCache.clear();
-	m_statiObjectCache.clear();
-	m_particleEffectCache.clear();
+	// Let anyone waiting on a prefetch know it isn't going to happen.
+	std::deque<TPrefetchRequestPtr> abandonedRequests;
+	abandonedRequests.swap(m_prefetchQueue);
+	for (auto& pRequest : abandonedRequests)
+	{
+		if (pRequest->callback)
+			pRequest->callback(pRequest->handle, false);
+	}
+
+	m_characterFileModelCache.Clear();
+	m_textureCache.Clear();
+	m_materialCache.Clear();
+	m_statiObjectCache.Clear();
+	m_particleEffectCache.Clear();
 }
 
 
 void CGameCache::GetMemoryUsage(ICrySizer *s) const
 {
 	s->Add(*this);
+	s->AddContainer(m_prefetchQueue);
+
+	static const char* componentNames [] = { "CharacterModels", "StaticObjects", "Textures", "Materials", "ParticleEffects" };
+	static_assert(CRY_ARRAY_COUNT(componentNames) == size_t(ECacheCategory::COUNT), "A name is needed for each cache category.");
+
+	for (int i = 0; i < int(ECacheCategory::COUNT); ++i)
+	{
+		const ECacheCategory category = ECacheCategory(i);
+		SIZER_COMPONENT_NAME(s, componentNames [i]);
+
+		// Our bookkeeping for the assets.
+		switch (category)
+		{
+			case ECacheCategory::CharacterModel:
+				m_characterFileModelCache.GetMemoryUsage(s);
+				break;
+
+			case ECacheCategory::StaticObject:
+				m_statiObjectCache.GetMemoryUsage(s);
+				break;
+
+			case ECacheCategory::Texture:
+				m_textureCache.GetMemoryUsage(s);
+				break;
+
+			case ECacheCategory::Material:
+				m_materialCache.GetMemoryUsage(s);
+				break;
+
+			case ECacheCategory::ParticleEffect:
+				m_particleEffectCache.GetMemoryUsage(s);
+				break;
+		}
+
+		// The assets themselves belong to the engine, but the cache is what keeps them resident, so report what it holds.
+		// The statistics are used as the identifiers, since each needs to be unique within the sizer.
+		const SCacheCategoryStats& stats = GetStats(category);
+		{
+			SIZER_COMPONENT_NAME(s, "Resident");
+			s->AddObject(&stats.residentBytes, stats.residentBytes);
+		}
+		{
+			SIZER_COMPONENT_NAME(s, "Pinned");
+			s->AddObject(&stats.pinnedBytes, stats.pinnedBytes);
+		}
+		{
+			SIZER_COMPONENT_NAME(s, "Evicted");
+			s->AddObject(&stats.evictedBytes, stats.evictedBytes);
+		}
+	}
+}
+
+
+void CGameCache::Update()
+{
+	UpdatePrefetches();
+
+	if (g_cvars.m_gameCacheDebug)
+	{
+		static const char* categoryNames [] = { "Character models", "Static objects", "Textures", "Materials", "Particle effects" };
+		static_assert(CRY_ARRAY_COUNT(categoryNames) == size_t(ECacheCategory::COUNT), "A name is needed for each cache category.");
+
+		for (int i = 0; i < int(ECacheCategory::COUNT); ++i)
+		{
+			const ECacheCategory category = ECacheCategory(i);
+			const SCacheCategoryStats& stats = GetStats(category);
+			const size_t budgetBytes = GetBudgetBytes(category);
+
+			CryWatch("Game cache: %s - resident %u (%" PRISIZE_T "KB / %" PRISIZE_T "KB), pinned %" PRISIZE_T "KB, evicted %u (%" PRISIZE_T "KB)",
+				categoryNames [i], stats.residentCount, stats.residentBytes / 1024, budgetBytes / 1024, stats.pinnedBytes / 1024,
+				stats.evictedCount, stats.evictedBytes / 1024);
+		}
+
+		CryWatch("Game cache: %" PRISIZE_T " prefetch requests pending", m_prefetchQueue.size());
+	}
+}
+
+
+const SCacheCategoryStats& CGameCache::GetStats(ECacheCategory category) const
+{
+	switch (category)
+	{
+		case ECacheCategory::CharacterModel:
+			return m_characterFileModelCache.GetStats();
+
+		case ECacheCategory::StaticObject:
+			return m_statiObjectCache.GetStats();
+
+		case ECacheCategory::Texture:
+			return m_textureCache.GetStats();
+
+		case ECacheCategory::Material:
+			return m_materialCache.GetStats();
+
+		default:
+			return m_particleEffectCache.GetStats();
+	}
+}
+
 
-	s->AddContainer(m_textureCache);
-	s->AddContainer(m_materialCache);
-	s->AddContainer(m_statiObjectCache);
-	s->AddContainer(m_particleEffectCache);
+size_t CGameCache::GetBudgetBytes(ECacheCategory category)
+{
+	int budgetMB { 0 };
+
+	switch (category)
+	{
+		case ECacheCategory::CharacterModel:
+			budgetMB = g_cvars.m_gameCacheBudgetCharacterModel;
+			break;
+
+		case ECacheCategory::StaticObject:
+			budgetMB = g_cvars.m_gameCacheBudgetStaticObject;
+			break;
+
+		case ECacheCategory::Texture:
+			budgetMB = g_cvars.m_gameCacheBudgetTexture;
+			break;
+
+		case ECacheCategory::Material:
+			budgetMB = g_cvars.m_gameCacheBudgetMaterial;
+			break;
+
+		case ECacheCategory::ParticleEffect:
+			budgetMB = g_cvars.m_gameCacheBudgetParticleEffect;
+			break;
+	}
+
+	return size_t(max(budgetMB, 0)) * 1024 * 1024;
 }
 
 
@@ -55,22 +227,18 @@ bool CGameCache::AddCachedCharacterFileModel(const ECharacterFileModelCacheType
 
 	if (!bCached && szFileName && szFileName [0])
 	{
-		if (gEnv->IsEditor())
+		// Outside of the editor the resources are locked as well, so the streaming system keeps them resident.
+		if (gEnv->IsEditor() || gEnv->pCharacterManager->LoadAndLockResources(szFileName, 0))
 		{
+			// Holding an instance keeps the model loaded, and gives the cache something to measure and evict.
 			ICharacterInstance *pCachedInstance = gEnv->pCharacterManager->CreateInstance(szFileName);
 			if (pCachedInstance)
 			{
-				m_editorCharacterFileModelCache [type].insert(TEditorCharacterFileModelCache::value_type(fileNameHash, TCharacterInstancePtr(pCachedInstance)));
+				m_characterFileModelCache.Insert(MakeCharacterFileModelKey(type, fileNameHash), MakeSharedEngineObject(pCachedInstance),
+					GetAssetMemoryUsage(pCachedInstance), GetBudgetBytes(ECacheCategory::CharacterModel));
 				bCached = true;
 			}
 		}
-		else
-		{
-			bool hasLoaded = gEnv->pCharacterManager->LoadAndLockResources(szFileName, 0);
-			if (hasLoaded)
-			{
-			}
-		}
 	}
 
 	return bCached;
@@ -84,17 +252,10 @@ ILINE bool CGameCache::IsCharacterFileModelCached(const char* szFileName, uint32
 	if (szFileName && szFileName [0])
 	{
 		outputFileNameHash = CCrc32::Compute(szFileName);
-		if (gEnv->IsEditor())
+		for (uint32 i = eCFMCache_Default; i < eCFMCache_COUNT; ++i)
 		{
-			for (uint32 i = eCFMCache_Default; i < eCFMCache_COUNT; ++i)
-			{
-				TEditorCharacterFileModelCache::const_iterator itCache = m_editorCharacterFileModelCache [i].find(outputFileNameHash);
-
-				if (itCache == m_editorCharacterFileModelCache [i].end())
-					continue;
-
+			if (m_characterFileModelCache.Contains(MakeCharacterFileModelKey(i, outputFileNameHash)))
 				return true;
-			}
 		}
 	}
 
@@ -122,12 +283,13 @@ void CGameCache::CacheGeometry(const char* geometryFileName)
 		{
 			const CryHash hashName = CryStringUtils::HashString(geometryFileName);
 
-			if (m_statiObjectCache.find(hashName) == m_statiObjectCache.end())
+			if (!m_statiObjectCache.Find(hashName))
 			{
 				IStatObj* pStaticObject = gEnv->p3DEngine->LoadStatObj(geometryFileName);
 				if (pStaticObject)
 				{
-					m_statiObjectCache.insert(TGameStaticObjectCacheMap::value_type(hashName, TStaticObjectSmartPtr(pStaticObject)));
+					m_statiObjectCache.Insert(hashName, TStaticObjectSmartPtr(pStaticObject), GetAssetMemoryUsage(pStaticObject),
+						GetBudgetBytes(ECacheCategory::StaticObject));
 				}
 			}
 		}
@@ -148,12 +310,12 @@ void CGameCache::CacheTexture(const char* textureFileName, const int textureFlag
 	{
 		const STextureKey textureKey(CryStringUtils::HashString(textureFileName), textureFlags);
 
-		if (m_textureCache.find(textureKey) == m_textureCache.end())
+		if (!m_textureCache.Find(textureKey))
 		{
 			ITexture* pTexture = gEnv->pRenderer->EF_LoadTexture(textureFileName, textureFlags);
 			if (pTexture)
 			{
-				m_textureCache.insert(TGameTextureCacheMap::value_type(textureKey, TTextureSmartPtr(pTexture)));
+				m_textureCache.Insert(textureKey, TTextureSmartPtr(pTexture), size_t(max(pTexture->GetDataSize(), 0)), GetBudgetBytes(ECacheCategory::Texture));
 				pTexture->Release();
 			}
 		}
@@ -174,28 +336,27 @@ void CGameCache::CacheMaterial(const char* materialFileName)
 	{
 		const CryHash hashName = CryStringUtils::HashString(materialFileName);
 
-		if (m_materialCache.find(hashName) == m_materialCache.end())
+		if (!m_materialCache.Find(hashName))
 		{
 			IMaterial* pMaterial = gEnv->p3DEngine->GetMaterialManager()->LoadMaterial(materialFileName);
 			if (pMaterial)
 			{
-				m_materialCache.insert(TGameMaterialCacheMap::value_type(hashName, TMaterialSmartPtr(pMaterial)));
+				m_materialCache.Insert(hashName, MakeSharedEngineObject(pMaterial), GetAssetMemoryUsage(pMaterial), GetBudgetBytes(ECacheCategory::Material));
 			}
 		}
 	}
 }
 
 
-CGameCache::TMaterialSmartPtr CGameCache::GetMaterial(const char* materialFileName) const
+CGameCache::TMaterialSmartPtr CGameCache::GetMaterial(const char* materialFileName)
 {
 	const bool validName = (materialFileName && materialFileName [0]);
 
 	if (validName)
 	{
 		const CryHash hashName = CryStringUtils::HashString(materialFileName);
-		auto it = m_materialCache.find(hashName);
-		if (it != m_materialCache.end())
-			return it->second;
+		if (auto pMaterial = m_materialCache.Find(hashName))
+			return *pMaterial;
 	}
 
 	return nullptr;
@@ -215,30 +376,303 @@ void CGameCache::CacheParticleEffect(const char* particleEffectFileName)
 	{
 		const CryHash hashName = CryStringUtils::HashString(particleEffectFileName);
 
-		if (m_particleEffectCache.find(hashName) == m_particleEffectCache.end())
+		if (!m_particleEffectCache.Find(hashName))
 		{
 			IParticleEffect* pParticleEffect = gEnv->p3DEngine->GetParticleManager()->FindEffect(particleEffectFileName, "CGameCache::CacheParticleEffect");
 			if (pParticleEffect)
 			{
-				m_particleEffectCache.insert(TGameParticleEffectCacheMap::value_type(hashName, TParticleEffectSmartPtr(pParticleEffect)));
+				m_particleEffectCache.Insert(hashName, MakeSharedEngineObject(pParticleEffect), GetAssetMemoryUsage(pParticleEffect),
+					GetBudgetBytes(ECacheCategory::ParticleEffect));
 			}
 		}
 	}
 }
 
 
-CGameCache::TParticleEffectSmartPtr CGameCache::GetParticleEffect(const char* particleEffectFileName) const
+CGameCache::TParticleEffectSmartPtr CGameCache::GetParticleEffect(const char* particleEffectFileName)
 {
 	const bool validName = (particleEffectFileName && particleEffectFileName [0]);
 
 	if (validName)
 	{
 		const CryHash hashName = CryStringUtils::HashString(particleEffectFileName);
-		auto it = m_particleEffectCache.find(hashName);
-		if (it != m_particleEffectCache.end())
-			return it->second;
+		if (auto pParticleEffect = m_particleEffectCache.Find(hashName))
+			return *pParticleEffect;
 	}
 
 	return nullptr;
 }
-}
\ No newline at end of file
+
+
+// ***
+// *** Prefetching
+// ***
+
+
+SPrefetchHandle CGameCache::Prefetch(ECacheCategory category, const char* fileName, int textureFlags, TPrefetchCallback callback)
+{
+	SPrefetchHandle handle;
+
+	if (!fileName || !fileName [0])
+		return handle;
+
+	// Geometry is cached according to the type of file, which means character files end up in the character cache.
+	const stack_string ext(PathUtil::GetExt(fileName));
+	if ((category == ECacheCategory::StaticObject) && ((ext == "cdf") || (ext == "chr") || (ext == "cga")))
+		category = ECacheCategory::CharacterModel;
+
+	handle.id = m_nextPrefetchId++;
+	if (m_nextPrefetchId == 0)
+		m_nextPrefetchId++;
+	handle.category = category;
+	handle.nameHash = (category == ECacheCategory::CharacterModel) ? CCrc32::Compute(fileName) : CryStringUtils::HashString(fileName);
+	handle.textureFlags = (category == ECacheCategory::Texture) ? textureFlags : 0;
+
+	TPrefetchRequestPtr pRequest = std::make_shared<SPrefetchRequest>();
+	pRequest->handle = handle;
+	pRequest->fileName = fileName;
+	pRequest->callback = callback;
+	m_prefetchQueue.push_back(pRequest);
+
+	// Particle effects are named within a library rather than being files of their own, so there's nothing to read.
+	if (category == ECacheCategory::ParticleEffect)
+	{
+		pRequest->isRead = true;
+	}
+	else
+	{
+		string readFileName = pRequest->fileName;
+		if ((category == ECacheCategory::Material) && ext.empty())
+			readFileName = PathUtil::ReplaceExtension(readFileName, "mtl");
+		else if ((category == ECacheCategory::Texture) && (ext == "tif"))
+			readFileName = PathUtil::ReplaceExtension(readFileName, "dds");
+
+		// The job holds its own reference, so the request outlives a Reset while the read is under way.
+		gEnv->pJobManager->AddLambdaJob("GameCache::ReadAhead", [pRequest, readFileName]()
+		{
+			ReadAheadFile(readFileName);
+			pRequest->isRead = true;
+		});
+	}
+
+	return handle;
+}
+
+
+EPrefetchStatus CGameCache::GetPrefetchStatus(const SPrefetchHandle& handle) const
+{
+	for (const auto& pRequest : m_prefetchQueue)
+	{
+		if (pRequest->handle.id == handle.id)
+			return EPrefetchStatus::Pending;
+	}
+
+	return IsCached(handle) ? EPrefetchStatus::Cached : EPrefetchStatus::NotCached;
+}
+
+
+void CGameCache::CancelPrefetchCallback(const SPrefetchHandle& handle)
+{
+	for (auto& pRequest : m_prefetchQueue)
+	{
+		if (pRequest->handle.id == handle.id)
+		{
+			pRequest->callback = nullptr;
+			break;
+		}
+	}
+}
+
+
+void CGameCache::FlushPrefetches()
+{
+	// The engine will read the file itself if the job hasn't got to it yet, so there's no need to wait.
+	while (!m_prefetchQueue.empty())
+	{
+		TPrefetchRequestPtr pRequest = m_prefetchQueue.front();
+		m_prefetchQueue.pop_front();
+		CompletePrefetch(*pRequest);
+	}
+}
+
+
+int CGameCache::PrimeWarmSet(const char* manifestFileName)
+{
+	if (!manifestFileName || !manifestFileName [0])
+		return 0;
+
+	XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFromFile(manifestFileName);
+	if (!rootNode)
+	{
+		CryLog("CGameCache: No warm set was found at %s", manifestFileName);
+		return 0;
+	}
+
+	int queued { 0 };
+
+	for (int i = 0; i < rootNode->getChildCount(); ++i)
+	{
+		XmlNodeRef assetNode = rootNode->getChild(i);
+		const char* name = assetNode->getAttr("name");
+
+		ECacheCategory category { ECacheCategory::COUNT };
+		if (assetNode->isTag("Geometry"))
+			category = ECacheCategory::StaticObject;
+		else if (assetNode->isTag("Texture"))
+			category = ECacheCategory::Texture;
+		else if (assetNode->isTag("Material"))
+			category = ECacheCategory::Material;
+		else if (assetNode->isTag("ParticleEffect"))
+			category = ECacheCategory::ParticleEffect;
+
+		if (category == ECacheCategory::COUNT)
+		{
+			CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_WARNING, "CGameCache: Unknown asset type <%s> in warm set %s", assetNode->getTag(), manifestFileName);
+			continue;
+		}
+
+		int textureFlags { 0 };
+		assetNode->getAttr("flags", textureFlags);
+
+		if (Prefetch(category, name, textureFlags).IsValid())
+		{
+			// The warm set lists exactly what the level is going to need, so keep it in the cache until the level unloads.
+			m_prefetchQueue.back()->isPinned = true;
+			queued++;
+		}
+	}
+
+	return queued;
+}
+
+
+void CGameCache::ReadAheadFile(const string& fileName)
+{
+	FILE* pFile = gEnv->pCryPak->FOpen(fileName.c_str(), "rb");
+	if (!pFile)
+		return;
+
+	char buffer [16 * 1024];
+	while (gEnv->pCryPak->FReadRaw(buffer, 1, sizeof(buffer), pFile) == sizeof(buffer))
+	{
+	}
+
+	gEnv->pCryPak->FClose(pFile);
+}
+
+
+void CGameCache::CompletePrefetch(SPrefetchRequest& request)
+{
+	const char* fileName = request.fileName.c_str();
+
+	switch (request.handle.category)
+	{
+		case ECacheCategory::CharacterModel:
+		case ECacheCategory::StaticObject:
+			CacheGeometry(fileName);
+			break;
+
+		case ECacheCategory::Texture:
+			CacheTexture(fileName, request.handle.textureFlags);
+			break;
+
+		case ECacheCategory::Material:
+			CacheMaterial(fileName);
+			break;
+
+		case ECacheCategory::ParticleEffect:
+			CacheParticleEffect(fileName);
+			break;
+	}
+
+	if (request.isPinned)
+		Pin(request.handle);
+
+	if (request.callback)
+		request.callback(request.handle, IsCached(request.handle));
+}
+
+
+void CGameCache::UpdatePrefetches()
+{
+	if (m_prefetchQueue.empty())
+		return;
+
+	const CTimeValue startTime = gEnv->pTimer->GetAsyncTime();
+	const float budgetMs = max(g_cvars.m_gameCachePrefetchBudgetMs, 0.0f);
+
+	// Any request whose read has finished can be completed, so a slow read only holds up itself. Older requests are
+	// still given the first chance at the time budget.
+	for (auto it = m_prefetchQueue.begin(); it != m_prefetchQueue.end();)
+	{
+		if (!(*it)->isRead)
+		{
+			++it;
+			continue;
+		}
+
+		// The callback is free to make new requests, so take the request out of the queue first.
+		TPrefetchRequestPtr pRequest = *it;
+		const size_t index = std::distance(m_prefetchQueue.begin(), it);
+		m_prefetchQueue.erase(it);
+		CompletePrefetch(*pRequest);
+		it = m_prefetchQueue.begin() + min(index, m_prefetchQueue.size());
+
+		if ((gEnv->pTimer->GetAsyncTime() - startTime).GetMilliSeconds() >= budgetMs)
+			break;
+	}
+}
+
+
+bool CGameCache::Pin(const SPrefetchHandle& handle)
+{
+	switch (handle.category)
+	{
+		case ECacheCategory::CharacterModel:
+			return m_characterFileModelCache.Pin(MakeCharacterFileModelKey(eCFMCache_Default, handle.nameHash));
+
+		case ECacheCategory::StaticObject:
+			return m_statiObjectCache.Pin(handle.nameHash);
+
+		case ECacheCategory::Texture:
+			return m_textureCache.Pin(STextureKey(handle.nameHash, handle.textureFlags));
+
+		case ECacheCategory::Material:
+			return m_materialCache.Pin(handle.nameHash);
+
+		case ECacheCategory::ParticleEffect:
+			return m_particleEffectCache.Pin(handle.nameHash);
+	}
+
+	return false;
+}
+
+
+bool CGameCache::IsCached(const SPrefetchHandle& handle) const
+{
+	switch (handle.category)
+	{
+		case ECacheCategory::CharacterModel:
+			for (uint32 i = eCFMCache_Default; i < eCFMCache_COUNT; ++i)
+			{
+				if (m_characterFileModelCache.Contains(MakeCharacterFileModelKey(i, handle.nameHash)))
+					return true;
+			}
+			return false;
+
+		case ECacheCategory::StaticObject:
+			return m_statiObjectCache.Contains(handle.nameHash);
+
+		case ECacheCategory::Texture:
+			return m_textureCache.Contains(STextureKey(handle.nameHash, handle.textureFlags));
+
+		case ECacheCategory::Material:
+			return m_materialCache.Contains(handle.nameHash);
+
+		case ECacheCategory::ParticleEffect:
+			return m_particleEffectCache.Contains(handle.nameHash);
+	}
+
+	return false;
+}
+}
@@ -9,6 +9,8 @@ trying to reduce the surface area and dependancies of the code.
 #pragma once
 
 #include <Utility/CryHash.h>
+#include "BudgetedCacheMap.h"
+#include <atomic>
 
 
 namespace Chrysalis
@@ -19,7 +21,47 @@ struct CItemParameter;
 // TODO: Add more caches, and ability to query for items in the caches.
 // TODO: Implement material loading for geometry cache. See ItemResourceCache for how.
 // TODO: Add animation cache.
-// TODO: Flush caches.
+
+/** The categories of asset held by the cache. Each has its own memory budget. */
+enum class ECacheCategory
+{
+	CharacterModel,
+	StaticObject,
+	Texture,
+	Material,
+	ParticleEffect,
+
+	COUNT
+};
+
+
+/**
+Identifies a prefetch request, and the asset it will bring into the cache. Handles remain valid after the request has
+completed, and can be used to check whether the asset made it into the cache.
+**/
+struct SPrefetchHandle
+{
+	uint32 id { 0 };
+	ECacheCategory category { ECacheCategory::COUNT };
+	CryHash nameHash { 0 };
+	int textureFlags { 0 };
+
+	bool IsValid() const { return id != 0; }
+};
+
+
+enum class EPrefetchStatus
+{
+	/** The request is still waiting to be processed. */
+	Pending,
+
+	/** The request has completed and the asset is in the cache. */
+	Cached,
+
+	/** The request failed, or the asset has since been evicted. */
+	NotCached
+};
+
 
 class CGameCache
 {
@@ -53,6 +95,30 @@ public:
 	void GetMemoryUsage(ICrySizer *s) const;
 
 
+	/** Shows the memory use for each category when game_cache_debug is enabled. */
+	void Update();
+
+
+	/**
+	Gets the memory accounting for a category of asset.
+
+	\param	category The category.
+
+	\return The statistics.
+	**/
+	const SCacheCategoryStats& GetStats(ECacheCategory category) const;
+
+private:
+	/**
+	Gets the memory budget for a category from its cvar.
+
+	\param	category The category.
+
+	\return The budget in bytes, or zero if the category has an unlimited budget.
+	**/
+	static size_t GetBudgetBytes(ECacheCategory category);
+
+
 	// ***
 	// *** Character Geometry Cache
 	// ***
@@ -73,9 +139,12 @@ public:
 	bool IsCharacterFileModelCached(const char* szFileName, uint32& outputFileNameHash) const;
 
 private:
-	// Character file model cache.
-	typedef std::map<uint32, TCharacterInstancePtr> TEditorCharacterFileModelCache;
-	TEditorCharacterFileModelCache   m_editorCharacterFileModelCache [eCFMCache_COUNT];
+	/** The cache type and file name hash, packed together. */
+	ILINE static uint64 MakeCharacterFileModelKey(uint32 type, uint32 fileNameHash) { return (uint64(type) << 32) | fileNameHash; }
+
+	// Character file model cache. All the cache types share the one map, so they can also share the one budget.
+	typedef CBudgetedCacheMap<uint64, TCharacterInstancePtr> TCharacterFileModelCache;
+	TCharacterFileModelCache m_characterFileModelCache;
 
 
 	// ***
@@ -88,7 +157,7 @@ public:
 	void CacheGeometry(const char* geometryObjectFileName);
 
 private:
-	typedef std::map<CryHash, TStaticObjectSmartPtr> TGameStaticObjectCacheMap;
+	typedef CBudgetedCacheMap<CryHash, TStaticObjectSmartPtr> TGameStaticObjectCacheMap;
 	TGameStaticObjectCacheMap m_statiObjectCache;
 
 
@@ -125,7 +194,7 @@ public:
 	void CacheTexture(const char* textureFileName, const int textureFlags);
 
 private:
-	typedef	std::map<STextureKey, TTextureSmartPtr, STextureKey::compare> TGameTextureCacheMap;
+	typedef	CBudgetedCacheMap<STextureKey, TTextureSmartPtr, STextureKey::compare> TGameTextureCacheMap;
 	TGameTextureCacheMap m_textureCache;
 
 
@@ -137,10 +206,11 @@ public:
 	typedef std::shared_ptr<IMaterial> TMaterialSmartPtr;
 
 	void CacheMaterial(const char* materialFileName);
-	TMaterialSmartPtr GetMaterial(const char* materialFileName) const;
+	/** Gets a cached material. Holding on to the pointer prevents the material from being evicted while it's in use. */
+	TMaterialSmartPtr GetMaterial(const char* materialFileName);
 
 private:
-	typedef std::map<CryHash, TMaterialSmartPtr> TGameMaterialCacheMap;
+	typedef CBudgetedCacheMap<CryHash, TMaterialSmartPtr> TGameMaterialCacheMap;
 	TGameMaterialCacheMap m_materialCache;
 
 
@@ -152,10 +222,130 @@ public:
 	typedef std::shared_ptr<IParticleEffect> TParticleEffectSmartPtr;
 
 	void CacheParticleEffect(const char* particleEffectFileName);
-	TParticleEffectSmartPtr GetParticleEffect(const char* particleEffectFileName) const;
+	/** Gets a cached effect. Holding on to the pointer prevents the effect from being evicted while it's in use. */
+	TParticleEffectSmartPtr GetParticleEffect(const char* particleEffectFileName);
 
 private:
-	typedef std::map<CryHash, TParticleEffectSmartPtr> TGameParticleEffectCacheMap;
+	typedef CBudgetedCacheMap<CryHash, TParticleEffectSmartPtr> TGameParticleEffectCacheMap;
 	TGameParticleEffectCacheMap m_particleEffectCache;
+
+
+	// ***
+	// *** Prefetching
+	// ***
+
+public:
+	/** Called on the main thread when a prefetch request completes. 'success' is true if the asset is now cached. */
+	typedef std::function<void(const SPrefetchHandle& handle, bool success)> TPrefetchCallback;
+
+
+	/**
+	Queues an asset to be brought into the cache ahead of its first use. The asset file is read on a worker job, which
+	warms the file cache, and the engine object is then created on the main thread during Update, within the time
+	budget set by game_cache_prefetch_budget_ms.
+
+	\param	category	 The category of asset.
+	\param	fileName	 The file name of the asset, or the name of the effect for particle effects.
+	\param	textureFlags The texture flags. Only used for textures.
+	\param	callback	 Optional callback which is made when the request completes.
+
+	\return A handle for the request. The handle is invalid if the request could not be made.
+	**/
+	SPrefetchHandle Prefetch(ECacheCategory category, const char* fileName, int textureFlags = 0, TPrefetchCallback callback = nullptr);
+
+
+	/**
+	Gets the status of a prefetch request.
+
+	\param	handle The handle returned by Prefetch.
+
+	\return The status.
+	**/
+	EPrefetchStatus GetPrefetchStatus(const SPrefetchHandle& handle) const;
+
+
+	/**
+	Drops the callback for a request, e.g. because the requester is being destroyed. The asset is still loaded.
+
+	\param	handle The handle returned by Prefetch.
+	**/
+	void CancelPrefetchCallback(const SPrefetchHandle& handle);
+
+
+	/**
+	Completes every pending prefetch request immediately, on the calling thread, whether or not its read has finished.
+	Only call this while loading, and as late as possible, so the reads have had time to finish.
+	**/
+	void FlushPrefetches();
+
+
+	/**
+	Queues every asset listed in a warm set manifest for prefetching. The manifest is an XML file with a root node
+	containing any number of Geometry, Texture, Material and ParticleEffect nodes, each with a 'name' attribute.
+	Textures may also have a 'flags' attribute. The assets are pinned in the cache once loaded, so they won't be evicted
+	before the level is unloaded.
+
+	\param	manifestFileName The manifest file name.
+
+	\return The number of assets which were queued.
+	**/
+	int PrimeWarmSet(const char* manifestFileName);
+
+private:
+	struct SPrefetchRequest
+	{
+		SPrefetchHandle handle;
+		string fileName;
+		TPrefetchCallback callback;
+
+		/** Set by the worker job once it has finished reading the file. */
+		std::atomic<bool> isRead { false };
+
+		/** The asset should be pinned in the cache once it's loaded. */
+		bool isPinned { false };
+	};
+
+	typedef std::shared_ptr<SPrefetchRequest> TPrefetchRequestPtr;
+
+
+	/**
+	Reads through an asset file on a worker thread, discarding the data. The point is to have the file in memory before
+	the main thread asks the engine to load it.
+
+	\param	fileName The file name.
+	**/
+	static void ReadAheadFile(const string& fileName);
+
+
+	/**
+	Loads the asset for a request into the cache, and makes the callback.
+
+	\param [in,out]	request The request.
+	**/
+	void CompletePrefetch(SPrefetchRequest& request);
+
+
+	/** Processes as many completed reads as will fit within the per frame time budget. */
+	void UpdatePrefetches();
+
+
+	/**
+	Prevents the asset for a handle from being evicted. Pins are only released when the cache is reset.
+
+	\param	handle The handle.
+
+	\return True if the asset was in the cache to be pinned.
+	**/
+	bool Pin(const SPrefetchHandle& handle);
+
+
+	/** Determines if the asset for a handle is in the cache. */
+	bool IsCached(const SPrefetchHandle& handle) const;
+
+	/** Requests which have not yet completed, in the order they were made. They may complete in any order. */
+	std::deque<TPrefetchRequestPtr> m_prefetchQueue;
+
+	/** The id which will be given to the next prefetch request. */
+	uint32 m_nextPrefetchId { 1 };
 };
 }
\ No newline at end of file
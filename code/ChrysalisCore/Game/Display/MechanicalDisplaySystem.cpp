@@ -0,0 +1,204 @@
+#include <StdAfx.h>
+
+#include "MechanicalDisplaySystem.h"
+#include <CryAnimation/ICryAnimation.h>
+#include <Console/CVars.h>
+
+
+namespace Chrysalis
+{
+CMechanicalDisplaySystem::CMechanicalDisplaySystem()
+{
+}
+
+
+CMechanicalDisplaySystem::~CMechanicalDisplaySystem()
+{
+}
+
+
+TMechanicalDisplayId CMechanicalDisplaySystem::Register(EntityId entityId, ICharacterInstance* pCharacter, const Vec3& axis, const char* const* handNames, int handCount)
+{
+	if (!pCharacter)
+		return InvalidMechanicalDisplayId;
+
+	const IAttachmentManager* pAttachmentManager = pCharacter->GetIAttachmentManager();
+	if (!pAttachmentManager)
+		return InvalidMechanicalDisplayId;
+
+	SDisplay display;
+	display.entityId = entityId;
+	display.pCharacter = pCharacter;
+	display.axis = axis;
+	display.handCount = min(handCount, maxHands);
+
+	// This is the only time we look the attachments up by name.
+	bool hasHands = false;
+	for (int i = 0; i < display.handCount; ++i)
+	{
+		display.hands [i].attachmentIndex = pAttachmentManager->GetIndexByName(handNames [i]);
+		hasHands |= display.hands [i].attachmentIndex >= 0;
+	}
+
+	if (!hasHands)
+		return InvalidMechanicalDisplayId;
+
+	// Zero is reserved for the invalid identifier.
+	if (++m_lastDisplayId == InvalidMechanicalDisplayId)
+		++m_lastDisplayId;
+
+	display.displayId = m_lastDisplayId;
+	m_displayLookup [display.displayId] = uint32(m_displays.size());
+	m_displays.push_back(display);
+
+	return display.displayId;
+}
+
+
+void CMechanicalDisplaySystem::Unregister(TMechanicalDisplayId displayId)
+{
+	auto it = m_displayLookup.find(displayId);
+	if (it == m_displayLookup.end())
+		return;
+
+	const uint32 displayIndex = it->second;
+	const uint32 lastIndex = uint32(m_displays.size() - 1);
+	m_displayLookup.erase(it);
+
+	// Keep the displays packed by moving the last one into the gap.
+	if (displayIndex != lastIndex)
+	{
+		m_displays [displayIndex] = m_displays [lastIndex];
+		m_displayLookup [m_displays [displayIndex].displayId] = displayIndex;
+	}
+
+	m_displays.pop_back();
+
+	// Stale ids in the dirty list are skipped during the update, so there's no need to search for it.
+}
+
+
+void CMechanicalDisplaySystem::SetHandAngles(TMechanicalDisplayId displayId, const float* degrees, int count)
+{
+	auto it = m_displayLookup.find(displayId);
+	if (it == m_displayLookup.end())
+		return;
+
+	SDisplay& display = m_displays [it->second];
+	const int handCount = min(count, display.handCount);
+	bool hasChanged = false;
+
+	for (int i = 0; i < handCount; ++i)
+	{
+		SHand& hand = display.hands [i];
+		hasChanged |= (hand.attachmentIndex >= 0) && (degrees [i] != hand.appliedDegrees);
+		hand.targetDegrees = degrees [i];
+	}
+
+	if (hasChanged && !display.isDirty)
+	{
+		display.isDirty = true;
+		m_dirtyDisplays.push_back(displayId);
+	}
+}
+
+
+void CMechanicalDisplaySystem::Update()
+{
+	m_timeSinceTick += gEnv->pTimer->GetFrameTime();
+
+	if (g_cvars.m_mechanicalDisplayDebug)
+	{
+		CryWatch("Mechanical displays: registered %" PRISIZE_T ", waiting %" PRISIZE_T ", moved last tick %d",
+			m_displays.size(), m_dirtyDisplays.size(), m_appliedLastTick);
+	}
+
+	// Nothing has changed, which is the usual case.
+	if (m_dirtyDisplays.empty())
+		return;
+
+	if ((g_cvars.m_mechanicalDisplayTickRate > 0.0f) && (m_timeSinceTick < 1.0f / g_cvars.m_mechanicalDisplayTickRate))
+		return;
+
+	m_timeSinceTick = 0.0f;
+	m_appliedLastTick = 0;
+
+	const CTimeValue now = gEnv->pTimer->GetFrameStartTime();
+	const Vec3 cameraPosition = gEnv->pSystem->GetViewCamera().GetPosition();
+	const float lodDistanceSquared = sqr(g_cvars.m_mechanicalDisplayLodDistance);
+
+	for (auto displayId : m_dirtyDisplays)
+	{
+		auto it = m_displayLookup.find(displayId);
+		if (it == m_displayLookup.end())
+			continue;
+
+		SDisplay& display = m_displays [it->second];
+
+		// Distant displays keep their place in the queue until they have waited long enough.
+		if ((now - display.lastAppliedTime).GetSeconds() < g_cvars.m_mechanicalDisplayLodInterval)
+		{
+			const IEntity* pEntity = gEnv->pEntitySystem->GetEntity(display.entityId);
+			if (pEntity && (pEntity->GetWorldPos().GetSquaredDistance(cameraPosition) > lodDistanceSquared))
+			{
+				m_deferredDisplays.push_back(displayId);
+				continue;
+			}
+		}
+
+		Apply(display);
+		display.lastAppliedTime = now;
+		display.isDirty = false;
+		m_appliedLastTick++;
+	}
+
+	// Swapping keeps the capacity of both lists, so we don't allocate once they've grown.
+	m_dirtyDisplays.swap(m_deferredDisplays);
+	m_deferredDisplays.clear();
+}
+
+
+void CMechanicalDisplaySystem::Apply(SDisplay& display)
+{
+	IAttachmentManager* pAttachmentManager = display.pCharacter->GetIAttachmentManager();
+	if (!pAttachmentManager)
+		return;
+
+	for (int i = 0; i < display.handCount; ++i)
+	{
+		SHand& hand = display.hands [i];
+		if ((hand.attachmentIndex < 0) || (hand.targetDegrees == hand.appliedDegrees))
+			continue;
+
+		if (IAttachment* pAttachment = pAttachmentManager->GetInterfaceByIndex(hand.attachmentIndex))
+		{
+			QuatT trans = pAttachment->GetAttAbsoluteDefault();
+			trans.q = Quat::CreateRotationXYZ(display.axis * DEG2RAD(hand.targetDegrees));
+			pAttachment->SetAttAbsoluteDefault(trans);
+		}
+
+		hand.appliedDegrees = hand.targetDegrees;
+	}
+}
+
+
+void CMechanicalDisplaySystem::Reset()
+{
+	m_displays.clear();
+	m_displayLookup.clear();
+	m_dirtyDisplays.clear();
+	m_deferredDisplays.clear();
+	m_timeSinceTick = 0.0f;
+	m_appliedLastTick = 0;
+}
+
+
+void CMechanicalDisplaySystem::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddContainer(m_displays);
+	pSizer->AddContainer(m_displayLookup);
+	pSizer->AddContainer(m_dirtyDisplays);
+	pSizer->AddContainer(m_deferredDisplays);
+}
+}
@@ -0,0 +1,131 @@
+/**
+\file	Game\Display\MechanicalDisplaySystem.h
+
+A plugin wide system which drives the hands of clocks, gauges and other mechanical displays. Each display resolves the
+attachments for its hands once, when it registers. The components only tell us when the value they show has changed, so
+a level full of idle clocks costs nothing more than a check of an empty list each frame.
+
+Changes are applied at a fixed tick rate rather than every frame, and displays which are far from the camera are only
+moved every so often, since nobody is able to read them anyway.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+/** Identifies a display registered with the system. */
+typedef uint32 TMechanicalDisplayId;
+static const TMechanicalDisplayId InvalidMechanicalDisplayId { 0 };
+
+
+class CMechanicalDisplaySystem
+{
+public:
+	/** The most hands a single display can have. */
+	static const int maxHands { 3 };
+
+	CMechanicalDisplaySystem();
+	virtual ~CMechanicalDisplaySystem();
+
+
+	/**
+	Adds a display to the system, resolving the attachments for each of its hands. Hands without a matching attachment
+	are ignored.
+
+	\param	entityId    Identifier for the entity which owns the display.
+	\param	pCharacter  The character holding the hand attachments.
+	\param	axis	    The axis around which the hands rotate.
+	\param	handNames   The attachment names, one for each hand.
+	\param	handCount   The number of hands, up to maxHands.
+
+	\return An identifier for the display, or InvalidMechanicalDisplayId if it has no hands we are able to move.
+	**/
+	TMechanicalDisplayId Register(EntityId entityId, ICharacterInstance* pCharacter, const Vec3& axis, const char* const* handNames, int handCount);
+
+
+	/**
+	Removes a display from the system. The hands are left where they are.
+
+	\param	displayId Identifier for the display.
+	**/
+	void Unregister(TMechanicalDisplayId displayId);
+
+
+	/**
+	Sets the angle each hand should be showing. The display is only queued for an update if one of them has changed.
+
+	\param	displayId Identifier for the display.
+	\param	degrees   The angles in degrees, in the same order as the hand names it registered with.
+	\param	count	  The number of angles.
+	**/
+	void SetHandAngles(TMechanicalDisplayId displayId, const float* degrees, int count);
+
+
+	/** Moves the hands for any displays which have changed, if it's time for a tick. */
+	void Update();
+
+
+	/** Removes every display. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+private:
+	struct SHand
+	{
+		/** The index of the attachment in the character's attachment manager. */
+		int32 attachmentIndex { -1 };
+
+		/** The angle the hand should show. */
+		float targetDegrees { 0.0f };
+
+		/** The angle the hand was last moved to. */
+		float appliedDegrees { FLT_MAX };
+	};
+
+	struct SDisplay
+	{
+		TMechanicalDisplayId displayId { InvalidMechanicalDisplayId };
+		EntityId entityId { INVALID_ENTITYID };
+		_smart_ptr<ICharacterInstance> pCharacter;
+		Vec3 axis { 0.0f, 1.0f, 0.0f };
+		SHand hands [maxHands];
+		int handCount { 0 };
+
+		/** When the hands were last moved. Used to throttle distant displays. */
+		CTimeValue lastAppliedTime;
+
+		bool isDirty { false };
+	};
+
+
+	/**
+	Moves the hands on a display to their target angles.
+
+	\param [in,out]	display The display.
+	**/
+	void Apply(SDisplay& display);
+
+	/** The displays are stored contiguously, and kept packed by swapping the last display into any gaps. */
+	std::vector<SDisplay> m_displays;
+
+	/** Maps from a display identifier to its index in m_displays. */
+	std::unordered_map<TMechanicalDisplayId, uint32> m_displayLookup;
+
+	/** Displays whose target angles have changed since their hands were last moved. */
+	std::vector<TMechanicalDisplayId> m_dirtyDisplays;
+
+	/** Scratch space for the displays which are too far away to update on this tick. */
+	std::vector<TMechanicalDisplayId> m_deferredDisplays;
+
+	/** The last identifier handed out. */
+	TMechanicalDisplayId m_lastDisplayId { InvalidMechanicalDisplayId };
+
+	/** The time since we last moved any hands. */
+	float m_timeSinceTick { 0.0f };
+
+	/** The number of displays moved on the last tick. */
+	int m_appliedLastTick { 0 };
+};
+}
@@ -0,0 +1,384 @@
+#include <StdAfx.h>
+
+#include "RaycastService.h"
+#include <Console/CVars.h>
+
+
+namespace Chrysalis
+{
+/** Ray origins closer than this (squared, in metres) are considered to be the same point. */
+static const float mergeOriginToleranceSqr = 0.01f * 0.01f;
+
+/** Normalised ray directions with a dot product at least this high are considered to be the same direction. */
+static const float mergeDirectionDot = 0.99999f;
+
+/** Ray lengths must match to within this fraction to be merged. */
+static const float mergeLengthTolerance = 0.01f;
+
+
+CRaycastService* CRaycastService::s_pInstance { nullptr };
+
+
+// ***
+// *** CRaycastService::SRay
+// ***
+
+
+bool CRaycastService::SRay::CanMerge(const SRaycastRequest& request) const
+{
+	if ((objectTypes != request.objectTypes) || (flags != request.flags))
+		return false;
+
+	if (receiverCount >= maxReceiversPerRay)
+		return false;
+
+	// There needs to be room in the skip list for whichever of the request's skip entities it doesn't already have.
+	if (skipCount + CountNewSkipEntities(request) > maxSkipEntities)
+		return false;
+
+	if (origin.GetSquaredDistance(request.origin) > mergeOriginToleranceSqr)
+		return false;
+
+	const float length = direction.GetLength();
+	const float requestLength = request.direction.GetLength();
+	if (fabs_tpl(length - requestLength) > (length * mergeLengthTolerance))
+		return false;
+
+	return (direction.GetNormalizedSafe().Dot(request.direction.GetNormalizedSafe()) >= mergeDirectionDot);
+}
+
+
+int CRaycastService::SRay::CountNewSkipEntities(const SRaycastRequest& request) const
+{
+	int newCount = (request.pSkipEntity && !IsSkipped(request.pSkipEntity)) ? 1 : 0;
+
+	for (int i = 0; i < request.skipEntityCount; ++i)
+	{
+		if (request.pSkipEntities [i] && (request.pSkipEntities [i] != request.pSkipEntity) && !IsSkipped(request.pSkipEntities [i]))
+			newCount++;
+	}
+
+	return newCount;
+}
+
+
+void CRaycastService::SRay::AddSkipEntities(const SRaycastRequest& request)
+{
+	AddSkipEntity(request.pSkipEntity);
+
+	for (int i = 0; i < request.skipEntityCount; ++i)
+		AddSkipEntity(request.pSkipEntities [i]);
+}
+
+
+void CRaycastService::SRay::AddSkipEntity(IPhysicalEntity* pSkipEntity)
+{
+	if (pSkipEntity && !IsSkipped(pSkipEntity))
+	{
+		// A request with too many skip entities will see through the ones which don't fit.
+		CRY_ASSERT(skipCount < maxSkipEntities);
+		if (skipCount < maxSkipEntities)
+			skipEntities [skipCount++] = pSkipEntity;
+	}
+}
+
+
+void CRaycastService::SRay::RemoveReceiver(IRaycastReceiver* pReceiver)
+{
+	for (int i = 0; i < receiverCount;)
+	{
+		if (receivers [i].pReceiver == pReceiver)
+			receivers [i] = receivers [--receiverCount];
+		else
+			++i;
+	}
+}
+
+
+// ***
+// *** CRaycastService
+// ***
+
+
+CRaycastService::CRaycastService()
+{
+	m_slots.resize(maxRaysInFlight);
+	m_pendingRays.reserve(maxRaysInFlight);
+}
+
+
+CRaycastService::~CRaycastService()
+{
+	Shutdown();
+}
+
+
+void CRaycastService::Init()
+{
+	CRY_ASSERT_MESSAGE(!s_pInstance, "Only one ray-cast service may listen for results.");
+	s_pInstance = this;
+
+	// Results for queued ray-casts arrive as logged events, which are pumped on the main thread.
+	gEnv->pPhysicalWorld->AddEventClient(EventPhysRWIResult::id, &CRaycastService::OnRWIResult, 1);
+}
+
+
+void CRaycastService::Shutdown()
+{
+	if (s_pInstance == this)
+	{
+		if (gEnv->pPhysicalWorld)
+			gEnv->pPhysicalWorld->RemoveEventClient(EventPhysRWIResult::id, &CRaycastService::OnRWIResult, 1);
+
+		s_pInstance = nullptr;
+	}
+
+	Reset();
+}
+
+
+TRaycastTicket CRaycastService::Queue(const SRaycastRequest& request, IRaycastReceiver* pReceiver)
+{
+	CRY_ASSERT(pReceiver);
+	if (!pReceiver || request.direction.IsZero())
+		return kInvalidRaycastTicket;
+
+	const TRaycastTicket ticket = m_nextTicket++;
+	if (m_nextTicket == kInvalidRaycastTicket)
+		m_nextTicket++;
+
+	m_stats.queued++;
+
+	// Look for a near-identical ray already queued this frame. There are rarely more than a few dozen of these, so a
+	// linear search is cheaper than maintaining a spatial lookup.
+	for (auto& ray : m_pendingRays)
+	{
+		if (ray.CanMerge(request))
+		{
+			ray.AddSkipEntities(request);
+			ray.receivers [ray.receiverCount++] = { pReceiver, ticket };
+			m_stats.merged++;
+
+			return ticket;
+		}
+	}
+
+	SRay ray;
+	ray.origin = request.origin;
+	ray.direction = request.direction;
+	ray.objectTypes = request.objectTypes;
+	ray.flags = request.flags;
+	ray.AddSkipEntities(request);
+	ray.receivers [ray.receiverCount++] = { pReceiver, ticket };
+	m_pendingRays.push_back(ray);
+
+	return ticket;
+}
+
+
+void CRaycastService::Cancel(IRaycastReceiver* pReceiver)
+{
+	for (auto& ray : m_pendingRays)
+		ray.RemoveReceiver(pReceiver);
+
+	// In-flight slots are left to complete, there's simply no one left to deliver the result to.
+	for (auto& slot : m_slots)
+	{
+		if (slot.isInFlight)
+			slot.ray.RemoveReceiver(pReceiver);
+	}
+
+	// The receiver may be cancelled by another receiver's callback for the result which is being delivered.
+	for (int i = 0; i < m_dispatchReceiverCount; ++i)
+	{
+		if (m_dispatchReceivers [i].pReceiver == pReceiver)
+			m_dispatchReceivers [i].pReceiver = nullptr;
+	}
+}
+
+
+void CRaycastService::Update()
+{
+	const int frameId = gEnv->nMainFrameID;
+
+	// Give up on any slots which have been waiting too long. They don't count against the quota any more, but they
+	// can't be re-used until physics returns their hit buffers.
+	for (auto& slot : m_slots)
+	{
+		if (slot.isInFlight && (frameId - slot.submitFrameId > maxFramesInFlight))
+		{
+			AbandonSlot(slot);
+			m_stats.lost++;
+		}
+	}
+
+	const int quota = clamp_tpl(g_cvars.m_rayCastQuota, 0, int(maxRaysInFlight));
+	int slotIndex = 0;
+
+	// Submit the whole batch. Rays over the quota are dropped; receivers are expected to ask again next frame.
+	for (auto& ray : m_pendingRays)
+	{
+		// Every receiver of this ray may have been cancelled.
+		if (ray.receiverCount == 0)
+			continue;
+
+		if ((m_raysInFlight >= quota) || (m_raysInFlight + m_abandonedSlots >= maxRaysInFlight))
+		{
+			m_stats.dropped++;
+			continue;
+		}
+
+		while (m_slots [slotIndex].isInFlight || m_slots [slotIndex].isAbandoned)
+			++slotIndex;
+
+		SSlot& slot = m_slots [slotIndex];
+		slot.ray = ray;
+		slot.submitFrameId = frameId;
+		slot.isInFlight = true;
+		m_raysInFlight++;
+
+		IPhysicalWorld::SRWIParams params;
+		params.org = slot.ray.origin;
+		params.dir = slot.ray.direction;
+		params.objtypes = slot.ray.objectTypes;
+		params.flags = slot.ray.flags | rwi_queue;
+		params.hits = slot.hits;
+		params.nMaxHits = SRaycastResult::maxHits;
+		params.pSkipEnts = slot.ray.skipEntities;
+		params.nSkipEnts = slot.ray.skipCount;
+		params.pForeignData = this;
+		params.iForeignData = int(MakeSlotHandle(slotIndex, slot.generation));
+
+		gEnv->pPhysicalWorld->RayWorldIntersection(params);
+		m_stats.submitted++;
+	}
+
+	m_pendingRays.clear();
+
+	if (g_cvars.m_raycastServiceDebug)
+	{
+		CryWatch("Raycast service: queued %d, merged %d, submitted %d, dropped %d", m_stats.queued, m_stats.merged, m_stats.submitted, m_stats.dropped);
+		CryWatch("Raycast service: in-flight %d, stale %d, lost %d, abandoned %d", m_raysInFlight, m_stats.stale, m_stats.lost, m_abandonedSlots);
+	}
+
+	m_stats = SStats();
+}
+
+
+void CRaycastService::Reset()
+{
+	m_pendingRays.clear();
+
+	for (auto& slot : m_slots)
+	{
+		if (slot.isInFlight)
+			ReleaseSlot(slot);
+
+		// Physics has been torn down, or we've stopped listening, so abandoned hit buffers are ours again.
+		if (slot.isAbandoned)
+		{
+			slot.isAbandoned = false;
+			slot.generation++;
+		}
+	}
+
+	m_abandonedSlots = 0;
+}
+
+
+void CRaycastService::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddContainer(m_pendingRays);
+	pSizer->AddContainer(m_slots);
+}
+
+
+int CRaycastService::OnRWIResult(const EventPhys* pEvent)
+{
+	const EventPhysRWIResult* pRWIResult = static_cast<const EventPhysRWIResult*>(pEvent);
+
+	// We receive the results for every queued ray-cast, not just our own.
+	if (s_pInstance && (pRWIResult->pForeignData == s_pInstance))
+		s_pInstance->OnResult(uint32(pRWIResult->iForeignData), *pRWIResult);
+
+	return 1;
+}
+
+
+void CRaycastService::OnResult(uint32 slotHandle, const EventPhysRWIResult& rwiResult)
+{
+	const int slotIndex = GetSlotIndex(slotHandle);
+	if (slotIndex >= int(m_slots.size()))
+		return;
+
+	// The slot may have been reset and even re-used since this ray was submitted.
+	SSlot& slot = m_slots [slotIndex];
+	if (slot.generation != GetSlotGeneration(slotHandle))
+	{
+		m_stats.stale++;
+		return;
+	}
+
+	// The result finally arrived for a ray we'd given up on. There's no one to deliver it to, but the slot is free again.
+	if (slot.isAbandoned)
+	{
+		slot.isAbandoned = false;
+		slot.generation++;
+		m_abandonedSlots--;
+		m_stats.stale++;
+		return;
+	}
+
+	if (!slot.isInFlight)
+	{
+		m_stats.stale++;
+		return;
+	}
+
+	SRaycastResult result;
+	result.hitCount = min(rwiResult.nHits, SRaycastResult::maxHits);
+	for (int i = 0; i < result.hitCount; ++i)
+		result.hits [i] = rwiResult.pHits [i];
+
+	// Receivers are allowed to queue new rays from within the callback, so work from a copy of the receiver list. Cancel
+	// clears entries in the copy, so receivers cancelled by an earlier callback are skipped.
+	CRY_ASSERT_MESSAGE(m_dispatchReceiverCount == 0, "Ray-cast results should never be delivered from within a callback.");
+	m_dispatchReceiverCount = slot.ray.receiverCount;
+	std::copy(slot.ray.receivers, slot.ray.receivers + m_dispatchReceiverCount, m_dispatchReceivers);
+	ReleaseSlot(slot);
+
+	for (int i = 0; i < m_dispatchReceiverCount; ++i)
+	{
+		const SReceiver receiver = m_dispatchReceivers [i];
+		if (receiver.pReceiver)
+			receiver.pReceiver->OnRayCastDataReceived(receiver.ticket, result);
+	}
+
+	m_dispatchReceiverCount = 0;
+}
+
+
+void CRaycastService::ReleaseSlot(SSlot& slot)
+{
+	CRY_ASSERT(slot.isInFlight);
+
+	slot.isInFlight = false;
+	slot.ray.receiverCount = 0;
+	slot.generation++;
+	m_raysInFlight--;
+}
+
+
+void CRaycastService::AbandonSlot(SSlot& slot)
+{
+	CRY_ASSERT(slot.isInFlight);
+
+	// The generation is left alone so the late result can still be matched to this slot, freeing it.
+	slot.isInFlight = false;
+	slot.isAbandoned = true;
+	slot.ray.receiverCount = 0;
+	m_raysInFlight--;
+	m_abandonedSlots++;
+}
+}
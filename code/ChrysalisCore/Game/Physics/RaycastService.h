@@ -0,0 +1,304 @@
+/**
+\file	Game\Physics\RaycastService.h
+
+A plugin wide service for deferred ray-casts. Requests are collected from any number of callers during the frame,
+near-identical rays are merged together and the whole batch is handed to the physics system in one go. Results are
+delivered to each receiver once physics has processed the batch, which will typically be on the following frame.
+
+This replaces the per-component slot arrays which were used with the CryAction ray-cast queue.
+**/
+#pragma once
+
+#include <CryPhysics/physinterface.h>
+
+
+namespace Chrysalis
+{
+/** Each queued ray-cast is given a ticket. Tickets increase monotonically, so a receiver is able to compare them to
+determine which of several results is the freshest. */
+typedef uint32 TRaycastTicket;
+
+/** A ticket value which will never be handed out. */
+static const TRaycastTicket kInvalidRaycastTicket = 0;
+
+
+/** A request for a single deferred ray-cast. */
+struct SRaycastRequest
+{
+	/** The most entities a single request can skip. */
+	static const int maxSkipEntities { 8 };
+
+	/** The start point of the ray. */
+	Vec3 origin { ZERO };
+
+	/** The direction of the ray. The length of this vector is the length of the ray. */
+	Vec3 direction { ZERO };
+
+	/** Physical entity types to test against. */
+	int objectTypes { ent_all };
+
+	/** Ray world intersection flags e.g. rwi_pierceability(n) | rwi_colltype_any. */
+	unsigned int flags { rwi_colltype_any };
+
+	/** An entity which should be ignored by the ray, usually the physics for the entity making the request. */
+	IPhysicalEntity* pSkipEntity { nullptr };
+
+	/**
+	Any further entities which should be ignored, e.g. everything attached to the requester. The array only needs to live
+	until Queue returns. Together with pSkipEntity there can be no more than maxSkipEntities.
+	**/
+	IPhysicalEntity* const* pSkipEntities { nullptr };
+	int skipEntityCount { 0 };
+};
+
+
+/**
+The result of a deferred ray-cast. As with RayWorldIntersection, hits [0] is always the solid hit and hits [1] is the
+nearest pierceable hit, if there was one.
+**/
+struct SRaycastResult
+{
+	static const int maxHits { 2 };
+
+	ray_hit hits [maxHits];
+	int hitCount { 0 };
+};
+
+
+/** Implement this to receive the results of deferred ray-casts. */
+struct IRaycastReceiver
+{
+	virtual ~IRaycastReceiver() = default;
+
+
+	/**
+	Called on the main thread when the result for a queued ray-cast is available. The collider pointers in the result
+	are only valid for the duration of this call.
+
+	\param	ticket The ticket which was returned when the ray-cast was queued.
+	\param	result The result.
+	**/
+	virtual void OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result) = 0;
+};
+
+
+class CRaycastService
+{
+public:
+	CRaycastService();
+	virtual ~CRaycastService();
+
+
+	/** Initialises this object and starts listening for ray-cast results from the physics system. */
+	void Init();
+
+
+	/** Stops listening for ray-cast results. */
+	void Shutdown();
+
+
+	/**
+	Queues a ray-cast for submission with the next batch. If a near-identical ray has already been queued this frame
+	the receiver is attached to that ray instead of a new one being created.
+
+	\param 		   	request   The ray-cast request.
+	\param [in,out]	pReceiver The receiver which will be notified when the result is available.
+
+	\return A ticket which identifies the result when it is delivered, or kInvalidRaycastTicket on failure.
+	**/
+	TRaycastTicket Queue(const SRaycastRequest& request, IRaycastReceiver* pReceiver);
+
+
+	/**
+	Removes a receiver from all queued and in-flight ray-casts. This must be called before a receiver is destroyed.
+
+	\param [in,out]	pReceiver The receiver.
+	**/
+	void Cancel(IRaycastReceiver* pReceiver);
+
+
+	/** Submits the rays which have been queued this frame as a single batch. Call this once per frame. */
+	void Update();
+
+
+	/** Abandons all queued and in-flight ray-casts. Any results which arrive after this will be rejected as stale. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+private:
+	/** The most entities we will skip for a single ray. Merged rays share a combined skip list. */
+	static const int maxSkipEntities { SRaycastRequest::maxSkipEntities };
+
+	/** The most receivers that can share the one ray. */
+	static const int maxReceiversPerRay { 8 };
+
+	/** A hard limit on the number of rays which may be in-flight at once. The game_rayCastQuota cvar can lower this. */
+	static const int maxRaysInFlight { 256 };
+
+	/**
+	Rays which have been in-flight for longer than this many frames are assumed lost and their receivers are abandoned. The
+	slot itself can't be used again until its result does arrive, since physics still holds on to its hit buffer.
+	**/
+	static const int maxFramesInFlight { 8 };
+
+	struct SReceiver
+	{
+		IRaycastReceiver* pReceiver;
+		TRaycastTicket ticket;
+	};
+
+	struct SRay
+	{
+		/**
+		Determines if a request is close enough to this ray that they can share the one result.
+
+		\param	request The request.
+
+		\return True if the request can be merged into this ray.
+		**/
+		bool CanMerge(const SRaycastRequest& request) const;
+
+
+		/**
+		Counts the skip entities for a request which aren't already in the skip list for this ray.
+
+		\param	request The request.
+
+		\return The number of skip entities which would have to be added.
+		**/
+		int CountNewSkipEntities(const SRaycastRequest& request) const;
+
+
+		/**
+		Adds the skip entities for a request into the skip list for this ray, if they're not already present.
+
+		\param	request The request.
+		**/
+		void AddSkipEntities(const SRaycastRequest& request);
+
+
+		/**
+		Adds a skip entity into the skip list for this ray, if it's not already present.
+
+		\param [in,out]	pSkipEntity The skip entity.
+		**/
+		void AddSkipEntity(IPhysicalEntity* pSkipEntity);
+
+
+		/**
+		Determines if an entity is in the skip list for this ray.
+
+		\param [in,out]	pSkipEntity The skip entity.
+
+		\return True if the entity is skipped.
+		**/
+		bool IsSkipped(IPhysicalEntity* pSkipEntity) const { return std::find(skipEntities, skipEntities + skipCount, pSkipEntity) != skipEntities + skipCount; }
+
+
+		/**
+		Removes a receiver from this ray.
+
+		\param [in,out]	pReceiver The receiver.
+		**/
+		void RemoveReceiver(IRaycastReceiver* pReceiver);
+
+		Vec3 origin { ZERO };
+		Vec3 direction { ZERO };
+		int objectTypes { 0 };
+		unsigned int flags { 0 };
+		IPhysicalEntity* skipEntities [maxSkipEntities];
+		int skipCount { 0 };
+		SReceiver receivers [maxReceiversPerRay];
+		int receiverCount { 0 };
+	};
+
+	/** In-flight rays are kept in slots, which the physics system holds on to until the result is delivered. */
+	struct SSlot
+	{
+		SRay ray;
+		ray_hit hits [SRaycastResult::maxHits];
+		int submitFrameId { 0 };
+		uint16 generation { 0 };
+		bool isInFlight { false };
+
+		/** The ray took too long and no one is waiting on it any more, but physics has yet to hand back the hit buffer. */
+		bool isAbandoned { false };
+	};
+
+	struct SStats
+	{
+		int queued { 0 };
+		int merged { 0 };
+		int submitted { 0 };
+		int dropped { 0 };
+		int stale { 0 };
+		int lost { 0 };
+	};
+
+
+	/**
+	Receives all ray world intersection results from the physics system and forwards ours on to the service.
+
+	\param	pEvent The event.
+
+	\return Always 1, allowing other listeners to process the event.
+	**/
+	static int OnRWIResult(const EventPhys* pEvent);
+
+
+	/**
+	Delivers the result for a slot to each of the receivers that were attached to it.
+
+	\param	slotHandle The slot index and generation, packed together.
+	\param	rwiResult  The ray world intersection result.
+	**/
+	void OnResult(uint32 slotHandle, const EventPhysRWIResult& rwiResult);
+
+
+	/** Frees a slot. Bumping the generation causes any late result for the slot to be rejected. */
+	void ReleaseSlot(SSlot& slot);
+
+
+	/**
+	Gives up on the receivers of a slot which has been in-flight for too long. The slot stays out of use until its result
+	arrives.
+
+	\param [in,out]	slot The slot.
+	**/
+	void AbandonSlot(SSlot& slot);
+
+	ILINE static uint32 MakeSlotHandle(int slotIndex, uint16 generation) { return (uint32(generation) << 16) | uint32(slotIndex); }
+	ILINE static int GetSlotIndex(uint32 slotHandle) { return int(slotHandle & 0xffff); }
+	ILINE static uint16 GetSlotGeneration(uint32 slotHandle) { return uint16(slotHandle >> 16); }
+
+	/** The service which is listening for results from the physics system. */
+	static CRaycastService* s_pInstance;
+
+	/** Rays which have been queued this frame and will be submitted on the next update. */
+	std::vector<SRay> m_pendingRays;
+
+	/** Rays which have been submitted to physics. This is sized once, so the hit buffers never move while in-flight. */
+	std::vector<SSlot> m_slots;
+
+	/** The number of slots which are currently in-flight. */
+	int m_raysInFlight { 0 };
+
+	/** The number of slots which were abandoned and are still waiting on physics to return their hit buffers. */
+	int m_abandonedSlots { 0 };
+
+	/**
+	The receivers for the result which is being delivered right now. Cancel clears entries from here too, so a receiver
+	which is cancelled by an earlier callback for the same result is not called.
+	**/
+	SReceiver m_dispatchReceivers [maxReceiversPerRay];
+	int m_dispatchReceiverCount { 0 };
+
+	/** The ticket which will be handed out on the next call to Queue. */
+	TRaycastTicket m_nextTicket { kInvalidRaycastTicket + 1 };
+
+	/** Statistics for the current frame, useful for tuning the quota. */
+	SStats m_stats;
+};
+}
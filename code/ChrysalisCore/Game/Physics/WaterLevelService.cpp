@@ -0,0 +1,207 @@
+#include <StdAfx.h>
+
+#include "WaterLevelService.h"
+#include <Console/CVars.h>
+#include "Plugin/ChrysalisCorePlugin.h"
+
+
+namespace Chrysalis
+{
+const float CWaterLevelService::cellHeight { 4.0f };
+const float CWaterLevelService::probePadding { 0.2f };
+const float CWaterLevelService::probeTimeout { 1.0f };
+const float CWaterLevelService::oceanLevelTolerance { 0.01f };
+
+
+CWaterLevelService::CWaterLevelService()
+{
+}
+
+
+CWaterLevelService::~CWaterLevelService()
+{
+	if (auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService())
+		pRaycastService->Cancel(this);
+}
+
+
+SWaterLevel CWaterLevelService::GetWaterLevel(const Vec3& position)
+{
+	const float currentTime = gEnv->pTimer->GetCurrTime();
+	SCell& cell = m_cells [GetCellKey(position)];
+
+	if ((cell.waterTime >= 0.0f) && ((currentTime - cell.waterTime) < g_cvars.m_waterLevelLifetime))
+	{
+		m_stats.waterHits++;
+		return cell.water;
+	}
+
+	m_stats.waterMisses++;
+
+	cell.water.level = gEnv->p3DEngine->GetWaterLevel(&position);
+
+	// This is only a heuristic. The engine doesn't say which body of water it found, so any water within a centimetre of
+	// the ocean's height is taken to be the ocean, even when it is really a volume which happens to sit at sea level.
+	const float oceanLevel = gEnv->p3DEngine->GetWaterLevel();
+	if (cell.water.level <= WATER_LEVEL_UNKNOWN)
+		cell.water.body = EWaterBody::None;
+	else if ((oceanLevel > WATER_LEVEL_UNKNOWN) && (fabs_tpl(cell.water.level - oceanLevel) <= oceanLevelTolerance))
+		cell.water.body = EWaterBody::Ocean;
+	else
+		cell.water.body = EWaterBody::Volume;
+
+	cell.waterTime = currentTime;
+
+	return cell.water;
+}
+
+
+bool CWaterLevelService::GetBottomLevel(const Vec3& position, float maxDepth, float& bottomLevel)
+{
+	const float currentTime = gEnv->pTimer->GetCurrTime();
+	const uint64 cellKey = GetCellKey(position);
+	SCell& cell = m_cells [cellKey];
+
+	if ((cell.bottomTime >= 0.0f) && ((currentTime - cell.bottomTime) < g_cvars.m_waterBottomLifetime))
+	{
+		m_stats.bottomHits++;
+		bottomLevel = cell.bottomLevel;
+
+		return true;
+	}
+
+	// Someone has already asked for this cell, so wait for their probe. The ray-cast service gives up on rays which take
+	// too long, so if it's been a while we assume it has been lost and ask again.
+	if (cell.bottomTicket != kInvalidRaycastTicket)
+	{
+		if ((currentTime - cell.bottomQueuedTime) < probeTimeout)
+			return false;
+
+		m_pendingProbes.erase(cell.bottomTicket);
+		cell.bottomTicket = kInvalidRaycastTicket;
+	}
+
+	auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService();
+	if (!pRaycastService)
+		return false;
+
+	// Don't reach further than the terrain, unless we're already underneath it, in a cave or such.
+	const float terrainHeight = gEnv->p3DEngine->GetTerrainElevation(position.x, position.y);
+	const float heightAboveTerrain = position.z - terrainHeight;
+	const float probeLength = ((heightAboveTerrain >= 0.0f) ? min(maxDepth, heightAboveTerrain) : maxDepth) + (probePadding * 2.0f);
+
+	SRaycastRequest request;
+	request.origin = position + Vec3(0.0f, 0.0f, probePadding);
+	request.direction = Vec3(0.0f, 0.0f, -probeLength);
+	request.objectTypes = ent_terrain | ent_static | ent_sleeping_rigid | ent_rigid;
+	request.flags = (geom_colltype_player << rwi_colltype_bit) | rwi_stop_at_pierceable;
+
+	const TRaycastTicket ticket = pRaycastService->Queue(request, this);
+	if (ticket != kInvalidRaycastTicket)
+	{
+		cell.bottomTicket = ticket;
+		cell.bottomQueuedTime = currentTime;
+		m_pendingProbes [ticket] = cellKey;
+		m_stats.probesQueued++;
+	}
+
+	return false;
+}
+
+
+void CWaterLevelService::Update()
+{
+	const float currentTime = gEnv->pTimer->GetCurrTime();
+
+	if (g_cvars.m_waterLevelServiceDebug)
+	{
+		const SStats& stats = m_lastStats;
+		const float averageLatency = (stats.probesReceived > 0) ? stats.probeLatencyTotal / stats.probesReceived : 0.0f;
+
+		CryWatch("Water level service: cells %" PRISIZE_T ", probes in-flight %" PRISIZE_T, m_cells.size(), m_pendingProbes.size());
+		CryWatch("Water level service: last second - water hits %d, misses %d, bottom hits %d, probes queued %d, received %d",
+			stats.waterHits, stats.waterMisses, stats.bottomHits, stats.probesQueued, stats.probesReceived);
+		CryWatch("Water level service: last second - probe latency average %.1fms, max %.1fms", averageLatency * 1000.0f, stats.probeLatencyMax * 1000.0f);
+	}
+
+	// Cells are cheap, so we only bother sweeping them out every so often.
+	if ((currentTime - m_lastSweepTime) < 1.0f)
+		return;
+
+	m_lastSweepTime = currentTime;
+	m_lastStats = m_stats;
+	m_stats = SStats();
+
+	for (auto it = m_cells.begin(); it != m_cells.end();)
+	{
+		const SCell& cell = it->second;
+		const bool isWaterStale = (currentTime - cell.waterTime) >= g_cvars.m_waterLevelLifetime;
+		const bool isBottomStale = (currentTime - cell.bottomTime) >= g_cvars.m_waterBottomLifetime;
+
+		if (isWaterStale && isBottomStale && (cell.bottomTicket == kInvalidRaycastTicket))
+			it = m_cells.erase(it);
+		else
+			++it;
+	}
+}
+
+
+void CWaterLevelService::Reset()
+{
+	if (auto pRaycastService = CChrysalisCorePlugin::Get()->GetRaycastService())
+		pRaycastService->Cancel(this);
+
+	m_cells.clear();
+	m_pendingProbes.clear();
+	m_lastSweepTime = 0.0f;
+	m_stats = SStats();
+	m_lastStats = SStats();
+}
+
+
+void CWaterLevelService::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddObject(m_cells);
+	pSizer->AddObject(m_pendingProbes);
+}
+
+
+void CWaterLevelService::OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result)
+{
+	auto it = m_pendingProbes.find(ticket);
+	if (it == m_pendingProbes.end())
+		return;
+
+	const uint64 cellKey = it->second;
+	m_pendingProbes.erase(it);
+
+	auto cellIt = m_cells.find(cellKey);
+	if ((cellIt == m_cells.end()) || (cellIt->second.bottomTicket != ticket))
+		return;
+
+	const float currentTime = gEnv->pTimer->GetCurrTime();
+	SCell& cell = cellIt->second;
+	cell.bottomLevel = (result.hitCount > 0) ? result.hits [0].pt.z : BOTTOM_LEVEL_UNKNOWN;
+	cell.bottomTime = currentTime;
+	cell.bottomTicket = kInvalidRaycastTicket;
+
+	const float latency = currentTime - cell.bottomQueuedTime;
+	m_stats.probesReceived++;
+	m_stats.probeLatencyTotal += latency;
+	m_stats.probeLatencyMax = max(m_stats.probeLatencyMax, latency);
+}
+
+
+uint64 CWaterLevelService::GetCellKey(const Vec3& position)
+{
+	const float cellSize = max(g_cvars.m_waterLevelCellSize, 0.1f);
+
+	// 21 bits for each axis is plenty, even for the largest of levels.
+	const uint64 x = uint64(int(floor_tpl(position.x / cellSize))) & 0x1fffff;
+	const uint64 y = uint64(int(floor_tpl(position.y / cellSize))) & 0x1fffff;
+	const uint64 z = uint64(int(floor_tpl(position.z / cellHeight))) & 0x1fffff;
+
+	return (x << 42) | (y << 21) | z;
+}
+}
@@ -0,0 +1,138 @@
+/**
+\file	Game\Physics\WaterLevelService.h
+
+A plugin wide cache of water surface heights and bottom depths, shared by every actor which needs to know if it should be
+swimming. The world is divided into a coarse grid and each cell remembers the water level at the point it was first
+asked about, along with which kind of water that was. Actors wading about in the same stretch of water share the one
+engine query, and the result is kept until it's old enough that the water might have moved.
+
+The depth to the bottom needs a ray-cast, which is queued with the ray-cast service rather than being cast straight away.
+The result is cached in the cell, so the next actor into that cell has it immediately. Callers poll for the bottom level
+until it arrives, which also means there is nothing to cancel if they lose interest.
+**/
+#pragma once
+
+#include "Game/Physics/RaycastService.h"
+
+
+namespace Chrysalis
+{
+/** The kind of water found at a point. This is a best guess, see CWaterLevelService::GetWaterLevel. */
+enum class EWaterBody
+{
+	None,
+	Ocean,
+	Volume
+};
+
+
+/** The water at a point, as seen by the water level service. */
+struct SWaterLevel
+{
+	/** The height of the water surface, or WATER_LEVEL_UNKNOWN if there is no water. */
+	float level { WATER_LEVEL_UNKNOWN };
+
+	EWaterBody body { EWaterBody::None };
+};
+
+
+class CWaterLevelService final : public IRaycastReceiver
+{
+public:
+	CWaterLevelService();
+	virtual ~CWaterLevelService();
+
+
+	/**
+	Gets the water level at a point, from the cache if the point's cell has been queried recently.
+
+	\param	position The position.
+
+	\return The water at that position.
+	**/
+	SWaterLevel GetWaterLevel(const Vec3& position);
+
+
+	/**
+	Gets the height of the bottom below a point. The first request for a cell queues a ray-cast, and the result is
+	available from a later frame. Keep asking until it is.
+
+	\param 		   	position	 The start of the probe, which should be above the bottom.
+	\param 		   	maxDepth	 The furthest below the position that we care about the bottom.
+	\param [in,out]	bottomLevel  The height of the bottom, or BOTTOM_LEVEL_UNKNOWN if nothing was found within reach. Only
+								 written when the result is available.
+
+	\return False while the probe is still in-flight, true once bottomLevel has been written.
+	**/
+	bool GetBottomLevel(const Vec3& position, float maxDepth, float& bottomLevel);
+
+
+	/** Drops cells which nobody has needed for a while, and shows the statistics. Call this once per frame. */
+	void Update();
+
+
+	/** Forgets everything, and abandons any probes which are in-flight. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+	// IRaycastReceiver
+	virtual void OnRayCastDataReceived(TRaycastTicket ticket, const SRaycastResult& result) override;
+	// ~IRaycastReceiver
+
+private:
+	/** Cells are only tall enough to tell a bridge from the river underneath it. */
+	static const float cellHeight;
+
+	/** Extra space above and below the bottom probe, as in the old per-actor probe. */
+	static const float probePadding;
+
+	/** A probe which hasn't returned in this long (s) is assumed lost, and the next caller queues another. */
+	static const float probeTimeout;
+
+	/** Water this close (m) to the ocean's height is classed as the ocean. */
+	static const float oceanLevelTolerance;
+
+	struct SCell
+	{
+		SWaterLevel water;
+		float waterTime { -1.0f };
+
+		float bottomLevel { BOTTOM_LEVEL_UNKNOWN };
+		float bottomTime { -1.0f };
+
+		/** The probe in-flight for this cell, if there is one. */
+		TRaycastTicket bottomTicket { kInvalidRaycastTicket };
+		float bottomQueuedTime { 0.0f };
+	};
+
+	struct SStats
+	{
+		int waterHits { 0 };
+		int waterMisses { 0 };
+		int bottomHits { 0 };
+		int probesQueued { 0 };
+		int probesReceived { 0 };
+
+		/** The time from queueing a probe to receiving its result, which is how long an actor waits to learn the depth. */
+		float probeLatencyTotal { 0.0f };
+		float probeLatencyMax { 0.0f };
+	};
+
+	/** Packs the grid coordinates of a position into a key for the cell map. */
+	static uint64 GetCellKey(const Vec3& position);
+
+	std::unordered_map<uint64, SCell> m_cells;
+
+	/** The cell each in-flight probe belongs to. */
+	std::unordered_map<TRaycastTicket, uint64> m_pendingProbes;
+
+	/** The last time stale cells were swept out. */
+	float m_lastSweepTime { 0.0f };
+
+	/** Statistics are gathered over a second at a time, and the last full second is shown. */
+	SStats m_stats;
+	SStats m_lastStats;
+};
+}
@@ -0,0 +1,253 @@
+#include <StdAfx.h>
+
+#include "InteractableSpatialHash.h"
+
+
+namespace Chrysalis
+{
+const float CInteractableSpatialHash::cellSize { 4.0f };
+const float CInteractableSpatialHash::maxCellCoord { float(1 << 24) };
+const int CInteractableSpatialHash::maxCellSpan { 64 };
+
+
+CInteractableSpatialHash::CInteractableSpatialHash()
+{
+}
+
+
+CInteractableSpatialHash::~CInteractableSpatialHash()
+{
+}
+
+
+void CInteractableSpatialHash::Register(EntityId entityId)
+{
+	if ((entityId == INVALID_ENTITYID) || (m_entryLookup.find(entityId) != m_entryLookup.end()))
+		return;
+
+	const uint32 entryIndex = uint32(m_entries.size());
+	m_entries.emplace_back();
+	m_entries [entryIndex].bounds.entityId = entityId;
+	m_entryLookup [entityId] = entryIndex;
+
+	// The entity is only placed into the grid once we've been able to read its bounds.
+	m_dirtyEntities.push_back(entityId);
+}
+
+
+void CInteractableSpatialHash::Unregister(EntityId entityId)
+{
+	auto it = m_entryLookup.find(entityId);
+	if (it == m_entryLookup.end())
+		return;
+
+	const uint32 entryIndex = it->second;
+	const uint32 lastIndex = uint32(m_entries.size() - 1);
+	RemoveFromCells(entryIndex);
+	m_entryLookup.erase(it);
+
+	// Keep the entries packed by moving the last one into the gap.
+	if (entryIndex != lastIndex)
+	{
+		m_entries [entryIndex] = m_entries [lastIndex];
+		m_entryLookup [m_entries [entryIndex].bounds.entityId] = entryIndex;
+		RenumberInCells(entryIndex, lastIndex);
+	}
+
+	m_entries.pop_back();
+
+	// Stale ids in the dirty list are skipped during the refresh, so there's no need to search for it.
+}
+
+
+void CInteractableSpatialHash::MarkDirty(EntityId entityId)
+{
+	auto it = m_entryLookup.find(entityId);
+	if (it == m_entryLookup.end())
+		return;
+
+	SEntry& entry = m_entries [it->second];
+	if (!entry.isDirty)
+	{
+		entry.isDirty = true;
+		m_dirtyEntities.push_back(entityId);
+	}
+}
+
+
+void CInteractableSpatialHash::Refresh()
+{
+	m_refreshFrameId = gEnv->nMainFrameID;
+
+	for (auto entityId : m_dirtyEntities)
+	{
+		auto it = m_entryLookup.find(entityId);
+		if (it != m_entryLookup.end())
+			RefreshEntry(it->second);
+	}
+
+	m_dirtyEntities.clear();
+}
+
+
+void CInteractableSpatialHash::Query(const AABB& box, std::vector<SInteractableBounds>& results)
+{
+	// Every caller this frame shares the one refresh of the entities which have moved.
+	if ((m_refreshFrameId != gEnv->nMainFrameID) && !m_dirtyEntities.empty())
+		Refresh();
+
+	if (box.IsReset() || !box.min.IsValid() || !box.max.IsValid())
+		return;
+
+	const uint32 queryStamp = ++m_queryStamp;
+	const int minX = GetCellCoord(box.min.x);
+	const int minY = GetCellCoord(box.min.y);
+	const int maxX = GetCellCoord(box.max.x);
+	const int maxY = GetCellCoord(box.max.y);
+
+	for (int x = minX; x <= maxX; ++x)
+	{
+		for (int y = minY; y <= maxY; ++y)
+		{
+			auto cell = m_cells.find(GetCellKey(x, y));
+			if (cell == m_cells.end())
+				continue;
+
+			for (auto entryIndex : cell->second)
+			{
+				SEntry& entry = m_entries [entryIndex];
+
+				// Entities spanning several cells will be found more than once.
+				if (entry.queryStamp == queryStamp)
+					continue;
+
+				entry.queryStamp = queryStamp;
+
+				if (entry.bounds.worldBounds.IsIntersectBox(box))
+					results.push_back(entry.bounds);
+			}
+		}
+	}
+}
+
+
+void CInteractableSpatialHash::Reset()
+{
+	m_entries.clear();
+	m_entryLookup.clear();
+	m_dirtyEntities.clear();
+	m_cells.clear();
+}
+
+
+void CInteractableSpatialHash::GetMemoryUsage(ICrySizer* pSizer) const
+{
+	pSizer->AddObject(this, sizeof(*this));
+	pSizer->AddContainer(m_entries);
+	pSizer->AddContainer(m_entryLookup);
+	pSizer->AddContainer(m_dirtyEntities);
+	pSizer->AddContainer(m_cells);
+}
+
+
+void CInteractableSpatialHash::RefreshEntry(uint32 entryIndex)
+{
+	SEntry& entry = m_entries [entryIndex];
+	entry.isDirty = false;
+
+	IEntity* pEntity = gEnv->pEntitySystem->GetEntity(entry.bounds.entityId);
+	if (!pEntity)
+		return;
+
+	// Cache everything the awareness queries need, so they never have to look up the entity.
+	SInteractableBounds& bounds = entry.bounds;
+	pEntity->GetWorldBounds(bounds.worldBounds);
+	bounds.worldPos = pEntity->GetWorldPos();
+
+	// An entity with no geometry or physics yet has no bounds, so treat it as a point until it does.
+	if (bounds.worldBounds.IsReset() || !bounds.worldBounds.min.IsValid() || !bounds.worldBounds.max.IsValid())
+		bounds.worldBounds = AABB(bounds.worldPos, bounds.worldPos);
+
+	AABB localBounds;
+	pEntity->GetLocalBounds(localBounds);
+	bounds.hasLocalBounds = !localBounds.IsEmpty();
+	if (bounds.hasLocalBounds)
+		bounds.worldOBB = OBB::CreateOBBfromAABB(Matrix33(pEntity->GetWorldTM()), localBounds);
+
+	// Only touch the grid if the entity has moved into a different set of cells.
+	int minX = GetCellCoord(bounds.worldBounds.min.x);
+	int minY = GetCellCoord(bounds.worldBounds.min.y);
+	int maxX = GetCellCoord(bounds.worldBounds.max.x);
+	int maxY = GetCellCoord(bounds.worldBounds.max.y);
+
+	// Bounds which are far too large for an interactable are most likely broken, and would fill the grid. These are only
+	// placed in the cell holding their position.
+	if ((maxX - minX > maxCellSpan) || (maxY - minY > maxCellSpan))
+	{
+		minX = maxX = GetCellCoord(bounds.worldPos.x);
+		minY = maxY = GetCellCoord(bounds.worldPos.y);
+	}
+
+	if ((minX != entry.cellMinX) || (minY != entry.cellMinY) || (maxX != entry.cellMaxX) || (maxY != entry.cellMaxY))
+	{
+		RemoveFromCells(entryIndex);
+		entry.cellMinX = minX;
+		entry.cellMinY = minY;
+		entry.cellMaxX = maxX;
+		entry.cellMaxY = maxY;
+		InsertIntoCells(entryIndex);
+	}
+}
+
+
+void CInteractableSpatialHash::InsertIntoCells(uint32 entryIndex)
+{
+	const SEntry& entry = m_entries [entryIndex];
+
+	for (int x = entry.cellMinX; x <= entry.cellMaxX; ++x)
+	{
+		for (int y = entry.cellMinY; y <= entry.cellMaxY; ++y)
+		{
+			m_cells [GetCellKey(x, y)].push_back(entryIndex);
+		}
+	}
+}
+
+
+void CInteractableSpatialHash::RemoveFromCells(uint32 entryIndex)
+{
+	const SEntry& entry = m_entries [entryIndex];
+
+	for (int x = entry.cellMinX; x <= entry.cellMaxX; ++x)
+	{
+		for (int y = entry.cellMinY; y <= entry.cellMaxY; ++y)
+		{
+			auto cell = m_cells.find(GetCellKey(x, y));
+			if (cell == m_cells.end())
+				continue;
+
+			stl::find_and_erase(cell->second, entryIndex);
+			if (cell->second.empty())
+				m_cells.erase(cell);
+		}
+	}
+}
+
+
+void CInteractableSpatialHash::RenumberInCells(uint32 entryIndex, uint32 oldIndex)
+{
+	const SEntry& entry = m_entries [entryIndex];
+
+	for (int x = entry.cellMinX; x <= entry.cellMaxX; ++x)
+	{
+		for (int y = entry.cellMinY; y <= entry.cellMaxY; ++y)
+		{
+			auto cell = m_cells.find(GetCellKey(x, y));
+			if (cell == m_cells.end())
+				continue;
+
+			std::replace(cell->second.begin(), cell->second.end(), oldIndex, entryIndex);
+		}
+	}
+}
+}
@@ -0,0 +1,164 @@
+/**
+\file	Game\Spatial\InteractableSpatialHash.h
+
+A plugin wide spatial index of every interactable entity in the level. Entities are bucketed into a uniform grid on the
+XY plane, which suits the mostly flat layout of towns and interiors. Bounds are cached when an entity registers and are
+only refreshed after the entity has moved or its geometry or physics has changed, so queries never need to touch the
+entity system.
+
+All the awareness components share this one index in place of running their own entity system proximity queries. Only
+entities with an interaction component are registered, so unlike those queries, the index never returns scenery or
+other entities which can't be interacted with.
+**/
+#pragma once
+
+
+namespace Chrysalis
+{
+/** The cached bounds for a single interactable entity. */
+struct SInteractableBounds
+{
+	EntityId entityId { INVALID_ENTITYID };
+
+	/** The axis aligned world bounds for the entity. */
+	AABB worldBounds { AABB::RESET };
+
+	/** The local bounds of the entity, oriented into world space. Only valid if hasLocalBounds is true. */
+	OBB worldOBB;
+
+	/** The world position of the entity, which is the centre for the OBB. */
+	Vec3 worldPos { ZERO };
+
+	/** False if the entity has empty local bounds. */
+	bool hasLocalBounds { false };
+};
+
+
+class CInteractableSpatialHash
+{
+public:
+	CInteractableSpatialHash();
+	virtual ~CInteractableSpatialHash();
+
+
+	/**
+	Adds an entity to the index. Its bounds will be resolved the next time the index is refreshed.
+
+	\param	entityId Identifier for the entity.
+	**/
+	void Register(EntityId entityId);
+
+
+	/**
+	Removes an entity from the index.
+
+	\param	entityId Identifier for the entity.
+	**/
+	void Unregister(EntityId entityId);
+
+
+	/**
+	Flags an entity as having moved, or having changed its geometry or physics. Its cached bounds will be refreshed, at
+	most once per frame, on the next query.
+
+	\param	entityId Identifier for the entity.
+	**/
+	void MarkDirty(EntityId entityId);
+
+
+	/** Refreshes the bounds for all entities which have moved since the last refresh. */
+	void Refresh();
+
+
+	/**
+	Finds all the entities with bounds that overlap the query box. Each entity is returned at most once, regardless of
+	how many grid cells it spans. Results are appended to the results container.
+
+	\param 		   	box	    The query box.
+	\param [in,out]	results The results.
+	**/
+	void Query(const AABB& box, std::vector<SInteractableBounds>& results);
+
+
+	/** Removes every entity from the index. */
+	void Reset();
+
+
+	void GetMemoryUsage(ICrySizer* pSizer) const;
+
+private:
+	/** The size of each grid cell in metres. Most queries are for a 12m box, so this keeps them to a handful of cells. */
+	static const float cellSize;
+
+	struct SEntry
+	{
+		SInteractableBounds bounds;
+
+		/** The range of cells the entity currently occupies. An empty range means it isn't in the grid yet. */
+		int cellMinX { 0 };
+		int cellMinY { 0 };
+		int cellMaxX { -1 };
+		int cellMaxY { -1 };
+
+		/** The last query which returned this entry, used to avoid returning it more than once. */
+		uint32 queryStamp { 0 };
+
+		bool isDirty { true };
+	};
+
+	typedef std::vector<uint32> TCell;
+	typedef std::unordered_map<uint64, TCell> TCellMap;
+
+	/** Cell coordinates are clamped to this, which keeps the conversion to an int well defined for any bounds. */
+	static const float maxCellCoord;
+
+	/** The most cells an entity may span along each axis. */
+	static const int maxCellSpan;
+
+	ILINE static int GetCellCoord(float value)
+	{
+		const float cell = floor_tpl(value / cellSize);
+		return NumberValid(cell) ? int(clamp_tpl(cell, -maxCellCoord, maxCellCoord)) : 0;
+	}
+
+	ILINE static uint64 GetCellKey(int x, int y) { return (uint64(uint32(x)) << 32) | uint64(uint32(y)); }
+
+
+	/**
+	Re-reads the bounds for the entity and moves it to its new cells if required.
+
+	\param	entryIndex Zero-based index of the entry.
+	**/
+	void RefreshEntry(uint32 entryIndex);
+
+
+	/** Inserts the entry into each of the cells within its cell range. */
+	void InsertIntoCells(uint32 entryIndex);
+
+
+	/** Removes the entry from each of the cells within its cell range. */
+	void RemoveFromCells(uint32 entryIndex);
+
+
+	/** Replaces one entry index with another in each of the cells within the entry's cell range. */
+	void RenumberInCells(uint32 entryIndex, uint32 oldIndex);
+
+	/** The entries are stored contiguously, and kept packed by swapping the last entry into any gaps. */
+	std::vector<SEntry> m_entries;
+
+	/** Maps from an EntityId to its index in m_entries. */
+	std::unordered_map<EntityId, uint32> m_entryLookup;
+
+	/** Entities which have moved since the last refresh. */
+	std::vector<EntityId> m_dirtyEntities;
+
+	/** The grid cells which have at least one entity in them. */
+	TCellMap m_cells;
+
+	/** Incremented for each query. */
+	uint32 m_queryStamp { 0 };
+
+	/** The frame on which we last refreshed. */
+	int m_refreshFrameId { -1 };
+};
+}
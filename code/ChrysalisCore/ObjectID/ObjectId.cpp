@@ -2,6 +2,7 @@
 
 #include "ObjectId.h"
 #include <atomic>
+#include <unordered_map>
 #include <CryCore/Assert/CryAssert.h>
 #include <time.h>
 #include <CryMath/Random.h>
@@ -9,11 +10,36 @@
 
 namespace Chrysalis
 {
+namespace
+{
+/** A block of Ids which a thread has reserved from a factory. */
+struct SThreadIdBlock
+{
+	uint32 factorySerial { 0 };
+	uint32 seconds { 0 };
+	uint32 nextVariant { 0 };
+	uint32 endVariant { 0 };
+};
+
+/** Each thread keeps its own block for every factory it has used, so interleaving factories never costs a reservation. */
+thread_local std::unordered_map<uint32, SThreadIdBlock> t_idBlocks;
+
+/** The block last used by this thread. Most callers use one factory many times in a row, so this skips the lookup. */
+thread_local SThreadIdBlock* t_pLastIdBlock { nullptr };
+
+std::atomic<uint32> s_nextFactorySerial { 1 };
+std::atomic<bool> s_hasWarnedAboutBorrowing { false };
+}
+
+
 CObjectIdFactory::CObjectIdFactory(uint32 instanceId)
 	: m_instanceId(instanceId),
-	m_randomVariant(0),
-	m_secondsSinceEpoch(0)
-{}
+	m_variantSalt(cry_random_uint32()),
+	m_serial(s_nextFactorySerial++),
+	m_state(0)
+{
+	static_assert((VariantsPerSecond % IdBlockSize) == 0, "Id blocks must fit evenly into a second.");
+}
 
 
 ObjectId CObjectIdFactory::CreateObjectId()
@@ -21,56 +47,100 @@ ObjectId CObjectIdFactory::CreateObjectId()
 	// Validation during testing / debug. For speed reasons we will not validate
 	// input in a release build. This decision might be wise to reconsider if you need the validation.
 	CRY_ASSERT(m_instanceId < MaxInstanceId);
-	CRY_ASSERT(m_randomVariant < MaxRandomVariant);
 
-	ObjectId objectId = InvalidId;
+	const uint32 now = GetCoarseSecondsSinceEpoch();
 
-	std::atomic<bool> spinLock { false };
+	// Reserve a new block when ours is used up, or has fallen behind the clock. Any Ids left in an old block are simply
+	// skipped, which keeps the seconds field close to the actual time of creation.
+	if (!t_pLastIdBlock || (t_pLastIdBlock->factorySerial != m_serial))
 	{
-		// Spin on this until we can get a lock.
-		while (spinLock.exchange(true)) {}
+		// Pointers into the map stay valid as it grows, so it's safe to hang on to this one.
+		t_pLastIdBlock = &t_idBlocks [m_serial];
+		t_pLastIdBlock->factorySerial = m_serial;
+	}
+
+	SThreadIdBlock& block = *t_pLastIdBlock;
+	if ((block.nextVariant >= block.endVariant) || (block.seconds < now))
+	{
+		ReserveIds(now, IdBlockSize, block.seconds, block.nextVariant);
+		block.endVariant = block.nextVariant + IdBlockSize;
+	}
 
-		// We're rounding our time down to 32 bit, so this code here is susceptible to the Y2038 problem in 2038 when
-		// the value will roll over. It will still provide a 1 second window, but the dates derived from using this
-		// number will be nonsense. Still, it will take 70+ years before it starts to clash - so plenty of time to
-		// switch to 64 bit numbers or another method.
-		auto now = static_cast<int32> (time(nullptr));
+	return MakeObjectId(block.seconds, block.nextVariant++);
+}
+
+
+void CObjectIdFactory::ReserveIds(uint32 now, uint32 count, uint32& seconds, uint32& firstVariant)
+{
+	uint64 state = m_state.load(std::memory_order_relaxed);
+	uint64 newState;
 
-		if (m_secondsSinceEpoch == now)
+	do
+	{
+		uint32 stateSeconds = uint32(state >> 32);
+		uint32 used = uint32(state);
+
+		// The state never moves backwards, so a clock which steps back can't cause Ids to be re-issued.
+		if (now > stateSeconds)
 		{
-			// Check for overflow on the variant.
-			m_randomVariant = (m_randomVariant + 1) & MaxRandomVariant;
-			if (m_lastRandomVariantSeed == m_randomVariant)
-			{
-				// #TODO: Don't let this assert happen for the dedicated server, since no-one will be
-				// there to notice.
-				CryLogAlways("Too many ObjectIds requested at once. See docs for limitations on ObjectId generation.");
-				CRY_ASSERT_MESSAGE(false, "Too many ObjectIds requested at once. See docs for limitations on ObjectId generation.");
-				return InvalidId;
-			}
+			stateSeconds = now;
+			used = 0;
 		}
-		else
-		{
-			// Bring the seconds up to date.
-			m_secondsSinceEpoch = now;
 
-			// We generate a new random seed to make keys harder to guess. It's fairly weak but better
-			// than nothing at all.
-			m_lastRandomVariantSeed = m_randomVariant = cry_random_uint32() & MaxRandomVariant;
+		// Rather than fail when a second is full, we borrow from the next one. The clock will catch up once the burst
+		// is over.
+		if (used + count > VariantsPerSecond)
+		{
+			stateSeconds++;
+			used = 0;
 		}
 
-		// Pack the values tightly into our data member. We're using the max values as a way to mask the raw
-		// data value packed in. This is a cheap operation to perform and should help prevent dirty data
-		// slipping in.
-		objectId = (static_cast<uint64_t>(m_secondsSinceEpoch) << (InstanceIdBits + RandomVariantBits))
-			+ (static_cast<uint64_t>((m_instanceId & MaxInstanceId)) << RandomVariantBits)
-			+ (m_randomVariant & MaxRandomVariant);
+		seconds = stateSeconds;
+		firstVariant = used;
+		newState = (uint64(stateSeconds) << 32) | (used + count);
+	}
+	while (!m_state.compare_exchange_weak(state, newState, std::memory_order_relaxed));
+
+	if ((seconds > now + MaxBorrowSeconds) && !s_hasWarnedAboutBorrowing.exchange(true))
+	{
+		CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_WARNING, "ObjectId generation is running %u seconds ahead of the clock. See docs for limitations on ObjectId generation.", seconds - now);
+	}
+}
 
-		// Unlock!
-		spinLock = false;
+
+ObjectId CObjectIdFactory::MakeObjectId(uint32 seconds, uint32 variantIndex) const
+{
+	CRY_ASSERT(variantIndex < VariantsPerSecond);
+
+	// A cheap integer mix gives each second its own starting point without needing to share any more state.
+	uint32 variantStart = (seconds ^ m_variantSalt) * 0x9E3779B1u;
+	variantStart ^= variantStart >> 16;
+
+	// We're storing our time as 32 bit, so this code here is susceptible to the Y2038 problem in 2038 when
+	// the value will roll over. It will still provide a 1 second window, but the dates derived from using this
+	// number will be nonsense. Still, it will take 70+ years before it starts to clash - so plenty of time to
+	// switch to 64 bit numbers or another method.
+	return (static_cast<uint64_t>(seconds) << (InstanceIdBits + RandomVariantBits))
+		+ (static_cast<uint64_t>((m_instanceId & MaxInstanceId)) << RandomVariantBits)
+		+ ((variantStart + variantIndex) & MaxRandomVariant);
+}
+
+
+uint32 CObjectIdFactory::GetCoarseSecondsSinceEpoch()
+{
+	static std::atomic<uint32> s_seconds { 0 };
+	static std::atomic<int64> s_refreshTicks { 0 };
+
+	// Any thread may refresh the clock. If two race, the worst case is the seconds briefly step back, which the
+	// factories already tolerate.
+	const int64 ticks = CryGetTicks();
+	if (ticks >= s_refreshTicks.load(std::memory_order_relaxed))
+	{
+		s_seconds.store(static_cast<uint32> (time(nullptr)), std::memory_order_relaxed);
+		s_refreshTicks.store(ticks + (CryGetTicksPerSec() / 8), std::memory_order_relaxed);
 	}
 
-	return objectId;
+	return s_seconds.load(std::memory_order_relaxed);
 }
 
 
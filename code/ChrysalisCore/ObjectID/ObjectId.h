@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 
 namespace Chrysalis
 {
@@ -17,7 +19,9 @@ the bits, use the accessors provided instead.
 and should be carefully assigned on a as-needed basis.
 50-63	:	A random component. Each second a new starting point is generated, and it increments with each
 Id generated during that second. This forces a hard limit on the number of Ids that can be generated
-in a single second. Currently this limit is 16,384. /
+in a single second. Currently this limit is 16,384. If that limit is reached, the factory borrows from
+the following second rather than failing, so the seconds field may run a little ahead of the clock
+during bursts.
 */
 
 typedef uint64_t ObjectId;
@@ -28,6 +32,9 @@ having a valid instanceId prior to instantiation.
 
 It is recommended that you create an instance of this factory for every entity class where you think
 you will need to create more the hard limit of ObjectId's / second. Currently, this limit is 16,384.
+
+The factory is lock-free and may be used from any thread. Each thread reserves Ids from the factory in blocks, so
+the shared state is only touched once for every IdBlockSize Ids a thread creates.
 */
 class CObjectIdFactory
 {
@@ -50,6 +57,15 @@ public:
 	/** Magic number to signify an invalid ID. */
 	static const ObjectId InvalidId = 0;
 
+	/** The number of Ids which are available in each second. */
+	static const uint32 VariantsPerSecond = MaxRandomVariant + 1;
+
+	/** The number of Ids a thread reserves from the factory at a time. This must divide evenly into VariantsPerSecond. */
+	static const uint32 IdBlockSize = 64;
+
+	/** We complain if borrowing puts the seconds this far ahead of the clock. */
+	static const uint32 MaxBorrowSeconds = 10;
+
 
 	/**
 	Constructor.
@@ -94,10 +110,44 @@ public:
 	uint32 GetRandomVariant(ObjectId objectId);
 
 private:
+	/**
+	Reserves a contiguous range of Ids, borrowing from the next second if the current one is full.
+
+	\param 	   	now			  The current seconds since epoch.
+	\param 	   	count		  The number of Ids to reserve.
+	\param [out]	seconds		  The seconds since epoch for the reserved Ids.
+	\param [out]	firstVariant  The index of the first reserved Id within that second.
+	**/
+	void ReserveIds(uint32 now, uint32 count, uint32& seconds, uint32& firstVariant);
+
+
+	/**
+	Packs the fields into an ObjectId. The index within the second is offset by a starting point that is picked for
+	each second, which makes the Ids harder to guess.
+
+	\return	The object identifier.
+	*/
+	ObjectId MakeObjectId(uint32 seconds, uint32 variantIndex) const;
+
+
+	/**
+	Gets the seconds since epoch from a clock which is only refreshed a few times each second, as calling time() for
+	every Id is needlessly expensive.
+
+	\return	The seconds since epoch.
+	*/
+	static uint32 GetCoarseSecondsSinceEpoch();
+
 	uint32 m_instanceId;
-	uint32 m_randomVariant;
-	uint32 m_lastRandomVariantSeed;
-	int32 m_secondsSinceEpoch;
+
+	/** Mixed with the seconds to choose the starting point for the random variant each second. */
+	uint32 m_variantSalt;
+
+	/** Identifies this factory in the per-thread block caches. Unlike its address, this is never re-used. */
+	uint32 m_serial;
+
+	/** The seconds since epoch in the top 32 bits, and the number of Ids used during that second in the bottom 32 bits. */
+	std::atomic<uint64> m_state;
 
 	// DO NOT IMPLEMENT.
 	CObjectIdFactory();
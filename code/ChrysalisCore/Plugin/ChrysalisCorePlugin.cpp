@@ -17,7 +17,16 @@
 #include "DynamicResponseSystem/ActionPlayAnimation.h"
 #include "DynamicResponseSystem/ActionSwitch.h"
 #include "DynamicResponseSystem/ActionUnlock.h"
+#include "DynamicResponseSystem/DRSSignalBus.h"
+#include "DynamicResponseSystem/EntityNameResolver.h"
 #include "ObjectID/ObjectIdMasterFactory.h"
+#include "Game/Physics/RaycastService.h"
+#include "Game/Physics/WaterLevelService.h"
+#include "Game/Spatial/InteractableSpatialHash.h"
+#include "Game/Cache/GameCache.h"
+#include "Game/Display/MechanicalDisplaySystem.h"
+#include "Actor/Movement/ActorPhysicsSnapshot.h"
+#include "StateMachine/StateMachine.h"
 #include "Actor/Character/CharacterAttributesComponent.h"
 #include "Actor/ActorComponent.h"
 #include "Actor/ActorControllerComponent.h"
@@ -72,6 +81,19 @@ CChrysalisCorePlugin::~CChrysalisCorePlugin()
 		gEnv->pSchematyc->GetEnvRegistry().DeregisterPackage(GetSchematycPackageGUID());
 	}
 
+	// The water level service cancels its probes with the ray-cast service, so it needs to go first.
+	SAFE_DELETE(m_pWaterLevelService);
+	SAFE_DELETE(m_pRaycastService);
+	SAFE_DELETE(m_pInteractableSpatialHash);
+	SAFE_DELETE(m_pGameCache);
+	SAFE_DELETE(m_pMechanicalDisplaySystem);
+	SAFE_DELETE(m_pEntityNameResolver);
+	SAFE_DELETE(m_pActorPhysicsSnapshot);
+	SAFE_DELETE(m_pDRSSignalBus);
+
+	// The state pools outlive every actor, so hand their storage back before the module goes away.
+	CStatePoolList::ReleaseAllPools();
+
 	// Unregister all the cvars.
 	g_cvars.UnregisterVariables();
 }
@@ -244,10 +266,56 @@ bool CChrysalisCorePlugin::Initialize(SSystemGlobalEnvironment& env, const SSyst
 	// #TODO: Get the InstanceId from the command line or cvars.
 	m_pObjectIdMasterFactory = new CObjectIdMasterFactory(0);
 
+	// Deferred ray-casts are batched and submitted once per frame.
+	m_pRaycastService = new CRaycastService();
+	m_pRaycastService->Init();
+
+	// Interactable entities register themselves into this as they are created.
+	m_pInteractableSpatialHash = new CInteractableSpatialHash();
+
+	// Assets are cached on first use, and evicted once their category is over budget.
+	m_pGameCache = new CGameCache();
+	m_pGameCache->Init();
+
+	// Clocks and gauges register themselves into this as they load their characters.
+	m_pMechanicalDisplaySystem = new CMechanicalDisplaySystem();
+
+	// DRS conditions and actions find their entities by name through this, and it forgets names as entities change.
+	m_pEntityNameResolver = new CEntityNameResolver();
+	m_pEntityNameResolver->Init();
+
+	// Actor controllers register themselves into this as they are initialised.
+	m_pActorPhysicsSnapshot = new CActorPhysicsSnapshot();
+
+	// Water levels are cached for everyone who wants to know if they should be swimming.
+	m_pWaterLevelService = new CWaterLevelService();
+
+	// Switches and other interactions queue their signals for linked entities on this.
+	m_pDRSSignalBus = new CDRSSignalBus();
+
+	// We need a regular update to drive our plugin wide services.
+	SetUpdateFlags(EUpdateType_Update);
+
 	return true;
 }
 
 
+void CChrysalisCorePlugin::OnPluginUpdate(EPluginUpdateType updateType)
+{
+	switch (updateType)
+	{
+		case EUpdateType_Update:
+			m_pRaycastService->Update();
+			m_pInteractableSpatialHash->Refresh();
+			m_pGameCache->Update();
+			m_pMechanicalDisplaySystem->Update();
+			m_pWaterLevelService->Update();
+			m_pDRSSignalBus->Update();
+			break;
+	}
+}
+
+
 void CChrysalisCorePlugin::OnSystemEvent(ESystemEvent event, UINT_PTR wparam, UINT_PTR lparam)
 {
 	switch (event)
@@ -317,7 +385,30 @@ void CChrysalisCorePlugin::OnSystemEvent(ESystemEvent event, UINT_PTR wparam, UI
 		}
 		break;
 
+		case ESYSTEM_EVENT_LEVEL_LOAD_START:
+			// Kick off the reads for the warm set now, so they run on the workers while the rest of the level loads.
+			m_pGameCache->PrimeWarmSet(g_cvars.m_gameCacheWarmSet->GetString());
+			break;
+
+		case ESYSTEM_EVENT_LEVEL_UNLOAD:
+			// Physics is torn down with the level, so nothing that's in-flight will ever come back.
+			m_pRaycastService->Reset();
+			m_pInteractableSpatialHash->Reset();
+			m_pGameCache->Reset();
+			m_pMechanicalDisplaySystem->Reset();
+			m_pEntityNameResolver->Reset();
+			m_pActorPhysicsSnapshot->Reset();
+			m_pWaterLevelService->Reset();
+			m_pDRSSignalBus->Reset();
+
+			// Storage for the states of the level's actors is only kept around for reuse, which a new level may never need.
+			CStatePoolList::ReleaseAllPools();
+			break;
+
 		case ESYSTEM_EVENT_LEVEL_LOAD_END:
+			// We're still behind the loading screen, so finish off whatever part of the warm set the updates haven't got to.
+			m_pGameCache->FlushPrefetches();
+
 			// In the editor, we wait until now before attempting to connect to the local player. This is to ensure all the
 			// entities are already loaded and initialised. It works differently in game mode. 
 			if (gEnv->IsEditor())
@@ -10,6 +10,14 @@ namespace Chrysalis
 {
 class CPlayerComponent;
 class CObjectIdMasterFactory;
+class CRaycastService;
+class CInteractableSpatialHash;
+class CGameCache;
+class CMechanicalDisplaySystem;
+class CEntityNameResolver;
+class CActorPhysicsSnapshot;
+class CWaterLevelService;
+class CDRSSignalBus;
 
 
 /**
@@ -39,7 +47,7 @@ public:
 	virtual const char* GetName() const override { return "ChrysalisCore"; }
 	virtual const char* GetCategory() const override { return "Game"; }
 	virtual bool Initialize(SSystemGlobalEnvironment& env, const SSystemInitParams& initParams) override;
-	virtual void OnPluginUpdate(EPluginUpdateType updateType) override {}
+	virtual void OnPluginUpdate(EPluginUpdateType updateType) override;
 	// ~ICryPlugin
 
 	// ISystemEventListener
@@ -71,6 +79,22 @@ public:
 
 	CObjectIdMasterFactory* GetObjectId() { return m_pObjectIdMasterFactory; }
 
+	CRaycastService* GetRaycastService() { return m_pRaycastService; }
+
+	CInteractableSpatialHash* GetInteractableSpatialHash() { return m_pInteractableSpatialHash; }
+
+	CGameCache* GetGameCache() { return m_pGameCache; }
+
+	CMechanicalDisplaySystem* GetMechanicalDisplaySystem() { return m_pMechanicalDisplaySystem; }
+
+	CEntityNameResolver* GetEntityNameResolver() { return m_pEntityNameResolver; }
+
+	CActorPhysicsSnapshot* GetActorPhysicsSnapshot() { return m_pActorPhysicsSnapshot; }
+
+	CWaterLevelService* GetWaterLevelService() { return m_pWaterLevelService; }
+
+	CDRSSignalBus* GetDRSSignalBus() { return m_pDRSSignalBus; }
+
 protected:
 	// Map containing player components, key is the channel id received in OnClientConnectionReceived
 	std::unordered_map<int, EntityId> m_players;
@@ -79,5 +103,29 @@ protected:
 private:
 	/** The object identifier master factory. */
 	CObjectIdMasterFactory* m_pObjectIdMasterFactory { nullptr };
+
+	/** Batches deferred ray-casts from all components into a single submission each frame. */
+	CRaycastService* m_pRaycastService { nullptr };
+
+	/** A spatial index of all the interactable entities, shared by every awareness component. */
+	CInteractableSpatialHash* m_pInteractableSpatialHash { nullptr };
+
+	/** Keeps commonly used assets loaded, within a memory budget for each type of asset. */
+	CGameCache* m_pGameCache { nullptr };
+
+	/** Moves the hands on every clock and gauge, but only when what they show has changed. */
+	CMechanicalDisplaySystem* m_pMechanicalDisplaySystem { nullptr };
+
+	/** Resolves the entity names used by our DRS conditions and actions, without walking the entity system each time. */
+	CEntityNameResolver* m_pEntityNameResolver { nullptr };
+
+	/** The physics state of every actor, gathered in one pass each frame for the movement state machines to read. */
+	CActorPhysicsSnapshot* m_pActorPhysicsSnapshot { nullptr };
+
+	/** Caches water levels and bottom depths on a coarse grid, so actors near water share the queries. */
+	CWaterLevelService* m_pWaterLevelService { nullptr };
+
+	/** Sends the signals our components queue for the DRS in one batch each frame, merging any repeats. */
+	CDRSSignalBus* m_pDRSSignalBus { nullptr };
 };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <CryCore/CryFlags.h>
 #include <CryString/StringUtils.h>
+#include <atomic>
 #include <Utility/AutoEnum.h>
 #include <Utility/CryHash.h>
 
@@ -25,7 +26,6 @@ struct SStateDebugContext;
 
 AUTOENUM_BUILDENUMWITHTYPE_WITHNUMEQUALS_WITHZERO(EStateEvent, eStateEvents, STATE_EVENT_CUSTOM, 100, EVENT_NONE);
 
-#define MAX_NUM_PENDING_EVENTS 4
 #define MAX_HSMEVENT_DATA	5
 
 
@@ -68,46 +68,78 @@ struct SStateEventData
 	const void* GetPtr() const { assert((m_pointer == NULL) || (m_type == eSEDT_voidptr)); return m_pointer; }
 };
 
+/**
+An event for the state machines. The payload is held inline, so an event never allocates, and it may only be moved.
+Events are handled by reference, so the only time one needs duplicating is when it's deferred for later, which is done
+explicitly with CopyFrom.
+**/
 struct SStateEvent
 {
 public:
 
-	typedef CryFixedArray<SStateEventData, MAX_HSMEVENT_DATA>			TStateEventData;
-
-	SStateEvent() : m_eventType(EVENT_NONE)
+	SStateEvent() : m_eventType(EVENT_NONE), m_dataSize(0)
 #ifdef STATE_DEBUG
 		, m_debugContextAt(-1)
 #endif
 	{}
-	SStateEvent(int type) : m_eventType(type)
+	SStateEvent(int type) : m_eventType(type), m_dataSize(0)
 #ifdef STATE_DEBUG
 		, m_debugContextAt(-1)
 #endif
 	{}
 #ifdef STATE_DEBUG
-	SStateEvent(int type, SStateDebugContext& context) : m_eventType(type)
+	SStateEvent(int type, SStateDebugContext& context) : m_eventType(type), m_dataSize(0)
 		, m_debugContextAt(-1) {
 		AddDebugContext(context);
 	}
 #endif
 
-	SStateEvent(const SStateEvent& rhs)
-		: m_eventType(rhs.m_eventType)
+	SStateEvent(SStateEvent&& rhs)
+		: m_eventType(EVENT_NONE), m_dataSize(0)
 #ifdef STATE_DEBUG
-		, m_debugContextAt(rhs.m_debugContextAt)
+		, m_debugContextAt(-1)
 #endif
 	{
-		for (unsigned int i = 0; i < rhs.GetDataSize(); ++i)
+		CopyFrom(rhs);
+		rhs.Clear();
+	}
+
+	SStateEvent& operator=(SStateEvent&& rhs)
+	{
+		if (this != &rhs)
 		{
-			AddData(rhs.GetData(i));
+			CopyFrom(rhs);
+			rhs.Clear();
 		}
+		return *this;
 	}
 
-	void AddData(const SStateEventData& data) { m_data.push_back(data); }
-	const SStateEventData& GetData(uint8 index) const { return m_data [index]; }
+	/** Makes this event a duplicate of another. The payload is plain data, so this is a single block copy. */
+	void CopyFrom(const SStateEvent& rhs)
+	{
+		m_eventType = rhs.m_eventType;
+		m_dataSize = rhs.m_dataSize;
+		memcpy(m_data, rhs.m_data, sizeof(SStateEventData) * rhs.m_dataSize);
+#ifdef STATE_DEBUG
+		m_debugContextAt = rhs.m_debugContextAt;
+#endif
+	}
+
+	/** Returns this event to the empty EVENT_NONE state. */
+	void Clear()
+	{
+		m_eventType = EVENT_NONE;
+		m_dataSize = 0;
+#ifdef STATE_DEBUG
+		m_debugContextAt = -1;
+#endif
+	}
+
+	void AddData(const SStateEventData& data) { CRY_ASSERT(m_dataSize < MAX_HSMEVENT_DATA); m_data [m_dataSize++] = data; }
+	const SStateEventData& GetData(uint8 index) const { CRY_ASSERT(index < m_dataSize); return m_data [index]; }
 	ILINE int GetEventId() const { return m_eventType; }
-	const unsigned int GetDataSize() const { return m_data.size(); }
-	void ClearData() { m_data.clear(); }
+	const unsigned int GetDataSize() const { return m_dataSize; }
+	void ClearData() { m_dataSize = 0; }
 
 	static SStateEvent CreateStateEvent(int type, const SStateEventData& data) { SStateEvent event(type); event.AddData(data); return event; }
 
@@ -115,23 +147,29 @@ public:
 	mutable int m_debugContextAt;
 	const SStateEvent& AddDebugContext(const SStateDebugContext& context) const
 	{
-		if (m_debugContextAt == -1 && m_data.size() < m_data.max_size())
+		if (m_debugContextAt == -1 && m_dataSize < MAX_HSMEVENT_DATA)
 		{
-			m_debugContextAt = m_data.size();
-			SStateEventData tmpData(&context);
-			m_data.push_back(tmpData);
+			m_debugContextAt = m_dataSize;
+			m_data [m_dataSize++] = SStateEventData(&context);
 		}
 		return *this;
 	}
 #endif
 
 private:
+	// Use CopyFrom when a duplicate is really needed.
+	SStateEvent(const SStateEvent&) = delete;
+	SStateEvent& operator=(const SStateEvent&) = delete;
 
 	int	m_eventType;
 #ifdef STATE_DEBUG
 	mutable
 #endif
-		TStateEventData	m_data;
+		uint8 m_dataSize;
+#ifdef STATE_DEBUG
+	mutable
+#endif
+		SStateEventData	m_data [MAX_HSMEVENT_DATA];
 };
 
 struct SStateEventSerialize : public SStateEvent
@@ -226,7 +264,7 @@ struct SStateDebugContext
 	mutable float  m_currentVertical;
 
 	template<typename HOST>
-	static const SStateEvent StateDebugAndLog(CStateHierarchy<HOST>* pState, const char* stateName, SStateEvent stateEvent);
+	static SStateEvent StateDebugAndLog(CStateHierarchy<HOST>* pState, const char* stateName, const SStateEvent& stateEvent);
 };
 
 #define DebugInit( pDebugName ) { m_pDebugName = pDebugName; }
@@ -255,13 +293,13 @@ va_end(args); \
 		}\
 
 template<typename HOST>
-const SStateEvent STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, const char* stateName, SStateEvent stateEvent)
+SStateEvent STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, const char* stateName, const SStateEvent& stateEvent)
 {
 	return SStateDebugContext::StateDebugAndLog(pState, stateName, stateEvent);
 }
 
 template<typename HOST>
-const SStateEvent STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, SStateEvent stateEvent)
+SStateEvent STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, const SStateEvent& stateEvent)
 {
 	return SStateDebugContext::StateDebugAndLog(pState, pState->m_currentState.m_pDebugName, stateEvent);
 }
@@ -282,8 +320,9 @@ const SStateEvent STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, SStat
 #define STATE_DEBUG_APPEND_EVENT( e ) e
 #define STATE_DEBUG_EVENTONLY( name, e ) e
 
+// Without the debug context there's nothing to add to the event, so it's passed straight through.
 template<typename HOST>
-const SStateEvent STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, SStateEvent stateEvent)
+const SStateEvent& STATE_DEBUG_RAW_EVENT_LOG(CStateHierarchy<HOST>* pState, const SStateEvent& stateEvent)
 {
 	return stateEvent;
 }
@@ -331,11 +370,85 @@ class CStateProxy
 public:
 	typedef const SStateIndex<HOST>(CStateHierarchy<HOST>::*StatePtr)(HOST&, const SStateEvent&);
 	typedef CStateHierarchy<HOST>* (*CreateStatePtr)(CStateMachineRegistration<HOST>& stateMachineReg);
-	typedef void(*DeleteStatePtr)(CStateHierarchy<HOST>*&);
+	typedef void(*DeleteStatePtr)(CStateMachineRegistration<HOST>& stateMachineReg, CStateHierarchy<HOST>*&);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// StatePool
+
+/**
+Counters for the state hierarchy pools, shared by every state machine. Once each pool has grown to cover the most states
+of its type which are alive at once, 'allocations' should stop increasing and all new states come from 'reuses'. State
+machines are updated on more than one thread, so the counters are atomic.
+**/
+struct SStatePoolStats
+{
+	std::atomic<int> allocations { 0 };
+	std::atomic<int> reuses { 0 };
+	std::atomic<int> live { 0 };
+
+	/** The number of pooled blocks which have been handed back to the heap. */
+	std::atomic<int> releases { 0 };
+};
+
+inline SStatePoolStats& GetStatePoolStats()
+{
+	static SStatePoolStats stats;
+	return stats;
+}
+
+
+/**
+Every state machine registration links itself into this list, so the storage held by all of their pools can be handed
+back to the heap in one go when a level is unloaded or the module shuts down.
+**/
+class CStatePoolList
+{
+public:
+	CStatePoolList()
+		: m_pNext(GetHead())
+	{
+		GetHead() = this;
+	}
+
+	virtual ~CStatePoolList()
+	{
+		for (CStatePoolList** ppLink = &GetHead(); *ppLink; ppLink = &(*ppLink)->m_pNext)
+		{
+			if (*ppLink == this)
+			{
+				*ppLink = m_pNext;
+				break;
+			}
+		}
+	}
+
+
+	/** Frees the storage for released states. States which are still alive keep theirs. */
+	virtual void ReleasePools() = 0;
+
+
+	/** Frees the storage for released states in every state machine. Only call this while no state machine is updating. */
+	static void ReleaseAllPools()
+	{
+		for (CStatePoolList* pPool = GetHead(); pPool; pPool = pPool->m_pNext)
+		{
+			pPool->ReleasePools();
+		}
+	}
+
+private:
+	static CStatePoolList*& GetHead()
+	{
+		static CStatePoolList* pHead { nullptr };
+		return pHead;
+	}
+
+	CStatePoolList* m_pNext;
 };
 
 template< typename HOST >
-class CStateMachineRegistration
+class CStateMachineRegistration : public CStatePoolList
 {
 	friend class CStateHelper<HOST, CStateHierarchy<HOST> >;
 	friend class CStateMachine<HOST>;
@@ -344,9 +457,12 @@ class CStateMachineRegistration
 		typename CStateProxy<HOST>::CreateStatePtr m_createPtr;
 		typename CStateProxy<HOST>::DeleteStatePtr m_deletePtr;
 
-		SStateFactory() {}
+		// Released state objects are kept on an intrusive free list, ready to be constructed into again.
+		void* m_pFreeList;
+
+		SStateFactory() : m_createPtr(NULL), m_deletePtr(NULL), m_pFreeList(NULL) {}
 		SStateFactory(typename CStateProxy<HOST>::CreateStatePtr createPtr, typename CStateProxy<HOST>::DeleteStatePtr deletePtr) :
-			m_createPtr(createPtr), m_deletePtr(deletePtr) {}
+			m_createPtr(createPtr), m_deletePtr(deletePtr), m_pFreeList(NULL) {}
 	};
 
 	typedef std::vector<SStateFactory> TStateFactory;
@@ -365,15 +481,35 @@ public:
 		m_factories [trueStateID] = SStateFactory(createPtr, deletePtr);
 	}
 
+	~CStateMachineRegistration()
+	{
+		ReleasePools();
+	}
+
 	void UnRegisterState(const uint stateID)
 	{
-		// TODO!
+		const uint trueStateID = stateID - STATE_FIRST;
+		if (trueStateID < m_factories.size())
+		{
+			// No more of these can be created, but any which are still alive can be deleted, so keep the delete function.
+			SStateFactory& factory = m_factories [trueStateID];
+			factory.m_createPtr = NULL;
+			ReleasePool(factory);
+		}
+	}
+
+	void ReleasePools() override
+	{
+		for (auto& factory : m_factories)
+		{
+			ReleasePool(factory);
+		}
 	}
 
 	CStateHierarchy<HOST>* CreateState(const uint stateID)
 	{
 		const uint trueStateID = stateID - STATE_FIRST;
-		if (trueStateID < m_factories.size())
+		if ((trueStateID < m_factories.size()) && m_factories [trueStateID].m_createPtr)
 		{
 			return CALL_STATE_CREATE_FN(trueStateID)(*this);
 		}
@@ -385,11 +521,117 @@ public:
 		const uint trueStateID = pState->GetStateID() - STATE_FIRST;
 		if (trueStateID < m_factories.size())
 		{
-			CALL_STATE_DELETE_FN(trueStateID)(pState);
+			CALL_STATE_DELETE_FN(trueStateID)(*this, pState);
+		}
+	}
+
+
+	/**
+	Provides storage for a state object, recycling the storage from a previously released state of the same type if
+	there is one. Only the state classes themselves should call this, from their Create function.
+
+	\param	stateID The state identifier.
+	\param	size    The size of the state class.
+
+	\return Storage for a state object of the given size.
+	**/
+	void* AllocateState(const uint stateID, const size_t size)
+	{
+		const uint trueStateID = stateID - STATE_FIRST;
+		CRY_ASSERT(trueStateID < m_factories.size());
+
+		SStatePoolStats& stats = GetStatePoolStats();
+		stats.live.fetch_add(1, std::memory_order_relaxed);
+
+		SStateFactory& factory = m_factories [trueStateID];
+		if (void* pBlock = factory.m_pFreeList)
+		{
+			factory.m_pFreeList = *static_cast<void**>(pBlock);
+			stats.reuses.fetch_add(1, std::memory_order_relaxed);
+
+			return pBlock;
+		}
+
+		stats.allocations.fetch_add(1, std::memory_order_relaxed);
+
+		return CryModuleMemalign(max(size, sizeof(void*)), alignof(std::max_align_t));
+	}
+
+
+	/**
+	Returns the storage for a destructed state object to the pool for its type.
+
+	\param	stateID The state identifier.
+	\param	pBlock  The storage.
+	**/
+	void FreeState(const uint stateID, void* pBlock)
+	{
+		const uint trueStateID = stateID - STATE_FIRST;
+		CRY_ASSERT(trueStateID < m_factories.size());
+
+		GetStatePoolStats().live.fetch_sub(1, std::memory_order_relaxed);
+
+		SStateFactory& factory = m_factories [trueStateID];
+		*static_cast<void**>(pBlock) = factory.m_pFreeList;
+		factory.m_pFreeList = pBlock;
+	}
+
+private:
+	/** Hands every block on a factory's free list back to the heap. */
+	void ReleasePool(SStateFactory& factory)
+	{
+		while (void* pBlock = factory.m_pFreeList)
+		{
+			factory.m_pFreeList = *static_cast<void**>(pBlock);
+			CryModuleMemalignFree(pBlock);
+			GetStatePoolStats().releases.fetch_add(1, std::memory_order_relaxed);
 		}
 	}
 };
 
+//////////////////////////////////////////////////////////////////////////
+// StateDispatchTable
+
+/**
+The routing for every sub-state of a state hierarchy class, flattened so that handling an event never needs to walk the
+parent pointers. It only depends on how the class was declared, so it is built once by the first instance of the class
+and shared by every instance after that.
+
+Sub-states are addressed by their sub-state index, which starts at 1 for Root. Slot 0 of each array is unused.
+**/
+struct SStateDispatchTable
+{
+	SStateDispatchTable() : m_stateCount(0), m_isBuilt(false) {}
+
+	ILINE bool IsBuilt() const { return m_isBuilt; }
+	ILINE uint GetStateCount() const { return m_stateCount; }
+
+	/** The ancestor chain for a sub-state. It starts with the sub-state itself, followed by its parent, and so on up to Root. */
+	ILINE const uint8* GetChain(const uint subStateIndex) const { return &m_chains [m_chainStart [subStateIndex]]; }
+	ILINE uint GetChainLength(const uint subStateIndex) const { return m_chainLength [subStateIndex]; }
+
+	/** The state ID of the closest ancestor shared by two sub-states. */
+	ILINE uint64 GetCommonParent(const uint subStateIndexA, const uint subStateIndexB) const
+	{
+		return m_commonParent [subStateIndexA * (m_stateCount + 1) + subStateIndexB];
+	}
+
+	/** Finds the sub-state index for a state name, returning 0 if the hierarchy has no sub-state with that name. */
+	uint FindSubStateIndex(const CryHash name) const
+	{
+		const auto it = m_nameToIndex.find(name);
+		return (it != m_nameToIndex.end()) ? it->second : 0;
+	}
+
+	uint m_stateCount;
+	std::vector<uint8> m_chains;
+	std::vector<uint16> m_chainStart;
+	std::vector<uint8> m_chainLength;
+	std::vector<uint64> m_commonParent;
+	std::unordered_map<CryHash, uint8> m_nameToIndex;
+	bool m_isBuilt;
+};
+
 //////////////////////////////////////////////////////////////////////////
 // StateIndex
 
@@ -399,22 +641,22 @@ struct SStateIndex
 	enum { UNDEFINED = -1 };
 
 	SStateIndex()
-		: m_name(CryHash(UNDEFINED)), m_func(0), m_stateID(UNDEFINED), m_hierarchy(UNDEFINED) {
+		: m_name(CryHash(UNDEFINED)), m_func(0), m_stateID(UNDEFINED), m_hierarchy(UNDEFINED), m_index(0) {
 		DebugInit("UNDEFINED_NEED_TO_ADD_STATE_TO_HIERARCHY_BEFORE_TRANSITIONING_TO_IT");
 	}
 	SStateIndex(CryHash hashName)
-		: m_name(hashName), m_func(0), m_parent(NULL), m_stateID(0), m_hierarchy(0) {
+		: m_name(hashName), m_func(0), m_parent(NULL), m_stateID(0), m_hierarchy(0), m_index(0) {
 		DebugInit("UnknownHash");
 	}
 	explicit SStateIndex(const char* pName)
-		: m_name(CryStringUtils::HashString(pName)), m_func(), m_parent(NULL), m_stateID(0), m_hierarchy(0) {
+		: m_name(CryStringUtils::HashString(pName)), m_func(), m_parent(NULL), m_stateID(0), m_hierarchy(0), m_index(0) {
 		DebugInit(pName);
 	}
 	SStateIndex(const char* pName, typename CStateProxy<HOST>::StatePtr func, const SStateIndex<HOST>* parent, uint stateID)
-		: m_name(CryStringUtils::HashString(pName)), m_func(func), m_parent(parent), m_stateID((1ULL << static_cast<uint64>(stateID))), m_hierarchy(0) {
+		: m_name(CryStringUtils::HashString(pName)), m_func(func), m_parent(parent), m_stateID((1ULL << static_cast<uint64>(stateID))), m_hierarchy(0), m_index(stateID) {
 		DebugInit(pName); RecursiveGenerateHierarchy(*this, m_hierarchy);
 	}
-	SStateIndex(const SStateIndex& rhs) : m_name(rhs.m_name), m_func(rhs.m_func), m_parent(rhs.m_parent), m_stateID(rhs.m_stateID), m_hierarchy(rhs.m_hierarchy)
+	SStateIndex(const SStateIndex& rhs) : m_name(rhs.m_name), m_func(rhs.m_func), m_parent(rhs.m_parent), m_stateID(rhs.m_stateID), m_hierarchy(rhs.m_hierarchy), m_index(rhs.m_index)
 #ifdef STATE_DEBUG
 		, m_pDebugName(rhs.m_pDebugName)
 #endif
@@ -424,7 +666,7 @@ struct SStateIndex
 	bool operator!=(const SStateIndex& rhs) const { return(m_name != rhs.m_name); }
 	SStateIndex& operator=(const SStateIndex& rhs)
 	{
-		m_name = rhs.m_name; m_func = rhs.m_func; m_parent = rhs.m_parent;  m_stateID = rhs.m_stateID; m_hierarchy = rhs.m_hierarchy;
+		m_name = rhs.m_name; m_func = rhs.m_func; m_parent = rhs.m_parent;  m_stateID = rhs.m_stateID; m_hierarchy = rhs.m_hierarchy; m_index = rhs.m_index;
 #ifdef STATE_DEBUG
 		m_pDebugName = rhs.m_pDebugName;
 #endif
@@ -437,6 +679,9 @@ struct SStateIndex
 	uint64 m_hierarchy;
 	uint m_stateID;
 
+	// The sub-state index within the owning hierarchy, or 0 for states which aren't part of one e.g. State_Done.
+	uint m_index;
+
 #ifdef STATE_DEBUG
 	const char* m_pDebugName;
 #endif
@@ -494,7 +739,7 @@ public:
 		STATE* pTransitionState = pActiveState->m_pTransitionStateHierarchy;
 		pActiveState->m_pTransitionStateHierarchy = NULL;
 
-		SStateEvent pendingEvent = pActiveState->m_pendingTransitionStateEvent;
+		SStateEvent pendingEvent(std::move(pActiveState->m_pendingTransitionStateEvent));
 
 		// Terminate the current state.
 		StateRelease(host, stateMachineReg, pActiveState);
@@ -546,33 +791,66 @@ public:
 		return stateCurrent.m_stateID;
 	}
 
-	static void RecursiveToCommonReverse(HOST& host, SStateIndex<HOST> stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
+	/**
+	Looks up the closest ancestor shared by two sub-states of the same hierarchy in the dispatch table, falling back to
+	walking the hierarchy for states which aren't part of one.
+	**/
+	static uint64 GetCommonParent(const STATE* pState, const SStateIndex<HOST>& stateCurrent, const SStateIndex<HOST>& stateCommon)
 	{
-		if (stateCurrent.m_stateID != stateCommonID)
+		if (pState->m_pDispatchTable && stateCurrent.m_index && stateCommon.m_index)
 		{
+			return pState->m_pDispatchTable->GetCommonParent(stateCurrent.m_index, stateCommon.m_index);
+		}
+		return GenerateCommonParent(stateCurrent, stateCommon);
+	}
 
-			if (stateCurrent.m_parent)
-			{
-				RecursiveToCommonReverse(host, *stateCurrent.m_parent, stateCommonID, pState, event);
-			}
+	static void RecursiveToCommonReverse(HOST& host, const SStateIndex<HOST>& stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
+	{
+		CRY_ASSERT(pState->m_pDispatchTable && stateCurrent.m_index);
+
+		const SStateDispatchTable& dispatchTable = *pState->m_pDispatchTable;
+		const uint8* pChain = dispatchTable.GetChain(stateCurrent.m_index);
+		const int chainLength = dispatchTable.GetChainLength(stateCurrent.m_index);
+
+		// Find where the chain meets the common parent, then visit the states below it from the top down.
+		int chainEnd = 0;
+		while ((chainEnd < chainLength) && (pState->GetSubState(pChain [chainEnd]).m_stateID != stateCommonID))
+		{
+			++chainEnd;
+		}
+
+		for (int i = chainEnd - 1; i >= 0; --i)
+		{
+			const SStateIndex<HOST>& state = pState->GetSubState(pChain [i]);
 
-			STATE_DEBUG_LOG(pState, "RecursiveToCommonReverse: Name: <%s>", stateCurrent.m_pDebugName);
+			STATE_DEBUG_LOG(pState, "RecursiveToCommonReverse: Name: <%s>", state.m_pDebugName);
 
-			CALL_SUBSTATE_FN(pState, stateCurrent)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(stateCurrent.m_pDebugName, event)));
+			CALL_SUBSTATE_FN(pState, state)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(state.m_pDebugName, event)));
 		}
 	}
 
-	static void RecursiveToCommon(HOST& host, SStateIndex<HOST> stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
+	static void RecursiveToCommon(HOST& host, const SStateIndex<HOST>& stateCurrent, const uint64 stateCommonID, STATE* pState, const SStateEvent& event)
 	{
-		if (stateCurrent.m_stateID != stateCommonID)
+		CRY_ASSERT(pState->m_pDispatchTable && stateCurrent.m_index);
+
+		const SStateDispatchTable& dispatchTable = *pState->m_pDispatchTable;
+		const uint8* pChain = dispatchTable.GetChain(stateCurrent.m_index);
+		const int chainLength = dispatchTable.GetChainLength(stateCurrent.m_index);
+
+		for (int i = 0; i < chainLength; ++i)
 		{
-			STATE_DEBUG_LOG(pState, "RecursiveToCommon: Name: <%s>", stateCurrent.m_pDebugName);
+			const SStateIndex<HOST>& state = pState->GetSubState(pChain [i]);
+			if (state.m_stateID == stateCommonID)
+			{
+				break;
+			}
 
-			const SStateIndex<HOST> stateReturn = CALL_SUBSTATE_FN(pState, stateCurrent)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(stateCurrent.m_pDebugName, event)));
+			STATE_DEBUG_LOG(pState, "RecursiveToCommon: Name: <%s>", state.m_pDebugName);
 
-			if (stateCurrent.m_parent && stateReturn != pState->State_Done)
+			const SStateIndex<HOST> stateReturn = CALL_SUBSTATE_FN(pState, state)(host, STATE_DEBUG_RAW_EVENT_LOG(pState, STATE_DEBUG_EVENTONLY(state.m_pDebugName, event)));
+			if (stateReturn == pState->State_Done)
 			{
-				RecursiveToCommon(host, *stateCurrent.m_parent, stateCommonID, pState, event);
+				break;
 			}
 		}
 	}
@@ -623,7 +901,7 @@ public:
 						// unless it was a system event (e.g. STATE_ENTER)
 						if (event.GetEventId() >= STATE_EVENT_CUSTOM)
 						{
-							const uint64 commonParent = CStateHelper<HOST, CStateHierarchy<HOST> >::GenerateCommonParent(oldState, pState->m_currentState);
+							const uint64 commonParent = GetCommonParent(pState, oldState, pState->m_currentState);
 
 							StateMachineHandleEventForState(host, stateMachineReg, pState, event, commonParent);
 						}
@@ -679,12 +957,12 @@ protected:
 
 	ILINE int GetStateID() const { return m_stateID; }
 
-	void RequestTransitionState(HOST& host, TStateIndex stateTransition, SStateEvent event)
+	void RequestTransitionState(HOST& host, TStateIndex stateTransition, const SStateEvent& event)
 	{
 		CRY_ASSERT(!m_pTransitionStateHierarchy);
 
 		m_pTransitionStateHierarchy = CStateHelper<HOST, CStateHierarchy<HOST> >::StateNew(host, m_stateMachineReg, stateTransition.m_name);
-		m_pendingTransitionStateEvent = event;
+		m_pendingTransitionStateEvent.CopyFrom(event);
 	}
 
 	void RequestTransitionState(HOST& host, TStateIndex stateTransition)
@@ -717,8 +995,15 @@ protected:
 	const TStateIndex State_Done;
 	const TStateIndex State_Continue;
 
-	typedef std::vector<SStateIndex<HOST>*> TStateIndexContainer;
-	TStateIndexContainer m_stateIndexContainer;
+	// Sub-state IDs are bits in a uint64 hierarchy mask, which puts a hard limit on how many a hierarchy can have.
+	enum { MAX_SUB_STATES = 64 };
+
+	// The sub-states for this hierarchy, in sub-state index order. Index 1 (Root) is stored in slot 0.
+	SStateIndex<HOST>* m_subStates [MAX_SUB_STATES];
+	uint m_subStateCount;
+
+	// Shared by every instance of the concrete state class.
+	const SStateDispatchTable* m_pDispatchTable;
 
 #ifdef STATE_DEBUG
 	SHistory m_historyDebug;
@@ -732,8 +1017,69 @@ protected:
 		m_pTransitionStateHierarchy(NULL),
 		m_currentState(CryHash(STATE_DONE)),
 		m_defaultState(defaultState),
-		m_stateMachineReg(stateMachineReg)
+		m_stateMachineReg(stateMachineReg),
+		m_subStateCount(0),
+		m_pDispatchTable(NULL)
+	{
+	}
+
+	void AddSubState(SStateIndex<HOST>& subState)
+	{
+		CRY_ASSERT_MESSAGE(m_subStateCount < MAX_SUB_STATES, "StateMachine: Too many sub-states in the one hierarchy.");
+		CRY_ASSERT(subState.m_index == m_subStateCount + 1);
+
+		m_subStates [m_subStateCount++] = &subState;
+	}
+
+	ILINE const TStateIndex& GetSubState(const uint subStateIndex) const
 	{
+		CRY_ASSERT((subStateIndex > 0) && (subStateIndex <= m_subStateCount));
+
+		return *m_subStates [subStateIndex - 1];
+	}
+
+
+	/**
+	Builds the dispatch table for the concrete state class from the sub-states that were just added, unless an earlier
+	instance has already done so, and then uses it for this instance.
+
+	\param [in,out]	dispatchTable The dispatch table for the concrete state class.
+	**/
+	void BindDispatchTable(SStateDispatchTable& dispatchTable)
+	{
+		if (!dispatchTable.IsBuilt())
+		{
+			const uint stateCount = m_subStateCount;
+			dispatchTable.m_stateCount = stateCount;
+			dispatchTable.m_chainStart.resize(stateCount + 1, 0);
+			dispatchTable.m_chainLength.resize(stateCount + 1, 0);
+			dispatchTable.m_commonParent.resize((stateCount + 1) * (stateCount + 1), 0);
+
+			for (uint i = 1; i <= stateCount; ++i)
+			{
+				const TStateIndex& subState = GetSubState(i);
+
+				dispatchTable.m_chainStart [i] = uint16(dispatchTable.m_chains.size());
+				for (const TStateIndex* pAncestor = &subState; pAncestor; pAncestor = pAncestor->m_parent)
+				{
+					dispatchTable.m_chains.push_back(uint8(pAncestor->m_index));
+				}
+				dispatchTable.m_chainLength [i] = uint8(dispatchTable.m_chains.size() - dispatchTable.m_chainStart [i]);
+
+				CRY_ASSERT_MESSAGE(dispatchTable.m_nameToIndex.find(subState.m_name) == dispatchTable.m_nameToIndex.end(), "StateMachine: Sub-state names must be unique within a hierarchy.");
+				dispatchTable.m_nameToIndex [subState.m_name] = uint8(i);
+
+				for (uint j = 1; j <= stateCount; ++j)
+				{
+					dispatchTable.m_commonParent [i * (stateCount + 1) + j] = CStateHelper<HOST, CStateHierarchy<HOST> >::GenerateCommonParent(subState, GetSubState(j));
+				}
+			}
+
+			dispatchTable.m_isBuilt = true;
+		}
+
+		CRY_ASSERT(dispatchTable.GetStateCount() == m_subStateCount);
+		m_pDispatchTable = &dispatchTable;
 	}
 
 private:
@@ -761,27 +1107,21 @@ private:
 	{
 		if ((m_currentState.m_stateID != stateID) || (m_currentState.m_hierarchy != stateHierarchy) || (m_currentState.m_name != stateName))
 		{
-			typename TStateIndexContainer::iterator it = m_stateIndexContainer.begin();
-			const typename TStateIndexContainer::const_iterator iEnd = m_stateIndexContainer.end();
-			for (; it != iEnd; ++it)
+			const uint subStateIndex = m_pDispatchTable->FindSubStateIndex(stateName);
+			if (subStateIndex == 0)
 			{
-				if ((*it)->m_stateID == stateID)
-				{
-					if ((*it)->m_hierarchy != stateHierarchy)
-					{
-						CryLog("StateMachine: Failed to Serialize state as the hierarchy has changed!");
-						return false;
-					}
-					if ((*it)->m_name != stateName)
-					{
-						CryLog("StateMachine: Failed to Serialize state as the name has changed!");
-						return false;
-					}
+				CryLog("StateMachine: Failed to Serialize state as the name has changed!");
+				return false;
+			}
 
-					TransitionFromCurrentToSubState(host, stateMachineReg, *(*it));
-					return true;
-				}
+			const TStateIndex& subState = GetSubState(subStateIndex);
+			if ((subState.m_stateID != stateID) || (subState.m_hierarchy != stateHierarchy))
+			{
+				CryLog("StateMachine: Failed to Serialize state as the hierarchy has changed!");
+				return false;
 			}
+
+			TransitionFromCurrentToSubState(host, stateMachineReg, subState);
 		}
 		return true;
 	}
@@ -794,7 +1134,7 @@ private:
 		const char* debugFromStateName = m_currentState.m_pDebugName;
 		const char* debugIntoStateName = toSubState.m_pDebugName;
 #endif
-		const uint64 commonParent = CStateHelper<HOST, CStateHierarchy<HOST> >::GenerateCommonParent(m_currentState, toSubState);
+		const uint64 commonParent = CStateHelper<HOST, CStateHierarchy<HOST> >::GetCommonParent(this, m_currentState, toSubState);
 
 		CStateHierarchy* pState = this;
 
@@ -817,6 +1157,25 @@ private: // DO_NOT_IMPLEMENT!
 //////////////////////////////////////////////////////////////////////////
 // StateMachine
 
+/**
+Counters for the deferred event rings, shared by every state machine. These are bumped from whichever thread is updating
+the machine, so they are atomic. If 'overflows' is ever above zero, the ring needs to be bigger.
+**/
+struct SStateEventStats
+{
+	/** The most events which have been waiting in any one ring at once. */
+	std::atomic<int> highWater { 0 };
+
+	/** The number of events which were dropped because a ring was full. */
+	std::atomic<int> overflows { 0 };
+};
+
+inline SStateEventStats& GetStateEventStats()
+{
+	static SStateEventStats stats;
+	return stats;
+}
+
 template<typename HOST>
 class CStateMachine
 {
@@ -824,6 +1183,8 @@ class CStateMachine
 public:
 	CStateMachine()
 		: m_pCurrentStateHierarchy(NULL)
+		, m_pendingEventsHead(0)
+		, m_pendingEventsCount(0)
 		, m_processingEvent(false)
 	{
 	}
@@ -848,7 +1209,7 @@ public:
 			STATE_HELPER::StateRelease(host, stateMachineReg, m_pCurrentStateHierarchy);
 			STATE_HELPER::StateDelete(host, stateMachineReg, m_pCurrentStateHierarchy);
 		}
-		stl::free_container(m_pendingEvents);
+		ClearPendingEvents();
 	}
 
 	void StateMachineHandleEvent(HOST& host, CStateMachineRegistration<HOST>& stateMachineReg, const SStateEvent& event)
@@ -859,10 +1220,11 @@ public:
 			STATE_HELPER::StateMachineHandleEventForState(host, stateMachineReg, m_pCurrentStateHierarchy, STATE_DEBUG_APPEND_EVENT(event), 0);
 			m_processingEvent = false;
 
-			while (!m_pendingEvents.empty())
+			while (m_pendingEventsCount > 0)
 			{
-				const SStateEvent pendingEvent = m_pendingEvents.front();
-				m_pendingEvents.pop();
+				SStateEvent pendingEvent(std::move(m_pendingEvents [m_pendingEventsHead]));
+				m_pendingEventsHead = (m_pendingEventsHead + 1) % maxPendingEvents;
+				m_pendingEventsCount--;
 				StateMachineHandleEvent(host, stateMachineReg, pendingEvent);
 			}
 		}
@@ -870,7 +1232,28 @@ public:
 		{
 			CRY_ASSERT(sizeof(event) == sizeof(SStateEvent));
 
-			m_pendingEvents.push(event);
+			SStateEventStats& stats = GetStateEventStats();
+
+			if (m_pendingEventsCount < maxPendingEvents)
+			{
+				const int tail = (m_pendingEventsHead + m_pendingEventsCount) % maxPendingEvents;
+				m_pendingEvents [tail].CopyFrom(event);
+				m_pendingEventsCount++;
+
+				int highWater = stats.highWater.load(std::memory_order_relaxed);
+				while ((m_pendingEventsCount > highWater) && !stats.highWater.compare_exchange_weak(highWater, m_pendingEventsCount, std::memory_order_relaxed))
+				{
+				}
+			}
+			else
+			{
+				// Dropping an event is almost certainly going to leave the state machine out of step with the host, so
+				// make some noise about it. The usual cause is states raising events in response to each other.
+				stats.overflows.fetch_add(1, std::memory_order_relaxed);
+				CRY_ASSERT_MESSAGE(false, "StateMachine: The pending event queue is full.");
+				CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_WARNING, "StateMachine: The pending event queue is full, dropping event %d. The oldest of the %d pending events is %d, the newest is %d.",
+					event.GetEventId(), m_pendingEventsCount, GetPendingEventId(0), GetPendingEventId(m_pendingEventsCount - 1));
+			}
 		}
 	}
 
@@ -981,7 +1364,7 @@ public:
 			STATE_HELPER::StateDelete(host, stateMachineReg, m_pCurrentStateHierarchy->m_pTransitionStateHierarchy);
 		}
 
-		stl::free_container(m_pendingEvents);
+		ClearPendingEvents();
 
 		// clear flags!
 		m_pCurrentStateHierarchy->m_flags.ClearAllFlags();
@@ -1022,18 +1405,45 @@ public:
 
 private:
 
+	void ClearPendingEvents()
+	{
+		for (auto& pendingEvent : m_pendingEvents)
+		{
+			pendingEvent.Clear();
+		}
+		m_pendingEventsHead = 0;
+		m_pendingEventsCount = 0;
+	}
+
+	/** The event ID of the nth oldest pending event. */
+	int GetPendingEventId(const int index) const
+	{
+		return m_pendingEvents [(m_pendingEventsHead + index) % maxPendingEvents].GetEventId();
+	}
+
+	/**
+	The most events which can be deferred while an event is being handled. Transitions raise at most a couple of events
+	each, and chains of states raising events for each other rarely go more than a few deep, so this leaves plenty of
+	headroom. Check hsm_stats for the high-water mark before changing it.
+	**/
+	static const int maxPendingEvents { 8 };
+
 	CStateHierarchy<HOST>* m_pCurrentStateHierarchy;
 
-	typedef std::queue<SStateEvent> TEventQueue;
-	TEventQueue m_pendingEvents;
+	// Events raised while an event is being handled are deferred until it's finished, in the order they arrive.
+	SStateEvent m_pendingEvents [maxPendingEvents];
+	int m_pendingEventsHead;
+	int m_pendingEventsCount;
+
 	bool m_processingEvent;
 };
 
 #ifdef STATE_DEBUG
 template<typename HOST>
-const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pState, const char* stateName, SStateEvent stateEvent)
+SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pState, const char* stateName, const SStateEvent& stateEvent)
 {
-	SStateEvent event(stateEvent);
+	SStateEvent event;
+	event.CopyFrom(stateEvent);
 	static SStateDebugContext debugContext(*gEnv->pRenderer, *gEnv->pRenderer->GetIRenderAuxGeom());
 	event.AddDebugContext(debugContext);
 	if (stateEvent.GetEventId() < STATE_EVENT_CUSTOM)
@@ -1075,6 +1485,10 @@ const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pS
 		}\
 		void host::UnRegisterState( uint stateID ) \
 		{\
+			if( s_pStateMachineRegistration##name ) \
+			{\
+				s_pStateMachineRegistration##name->UnRegisterState( stateID ); \
+			}\
 		}\
 		CStateMachineRegistration<host>* host::s_pStateMachineRegistration##name = NULL; \
 		void host::StateMachineHandleEvent##name( const SStateEvent& event ) \
@@ -1115,10 +1529,11 @@ const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pS
 		public:\
 			stateClass( CStateMachineRegistration<host>& stateMachineReg ); \
 			static CStateHierarchy<host>* Create( CStateMachineRegistration<host>& stateMachineReg ); \
-			static void					 Delete( CStateHierarchy<host>*& pState ); \
+			static void					 Delete( CStateMachineRegistration<host>& stateMachineReg, CStateHierarchy<host>*& pState ); \
 			static uint					 Register(); \
 			static void					 UnRegister(); \
-		private:
+		private: \
+			static SStateDispatchTable s_dispatchTable;
 
 #define DECLARE_STATE_CLASS_ADD( host, stateName ) \
 		const TStateIndex stateName( host& blah, const SStateEvent& event ); \
@@ -1131,8 +1546,21 @@ const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pS
 		DECLARE_STATE_CLASS_ADD( host, Root )
 
 #define DEFINE_STATE_CLASS_BEGIN( host, stateClass, stateId, defaultState )\
-		CStateHierarchy<host>* stateClass::Create( CStateMachineRegistration<host>& stateMachineReg ) { return new stateClass(stateMachineReg); } \
-		void					stateClass::Delete( CStateHierarchy<host>*& pState ) { SAFE_DELETE( pState ); } \
+		SStateDispatchTable stateClass::s_dispatchTable; \
+		CStateHierarchy<host>* stateClass::Create( CStateMachineRegistration<host>& stateMachineReg ) \
+		{ \
+			return new (stateMachineReg.AllocateState( stateId, sizeof(stateClass) )) stateClass(stateMachineReg); \
+		} \
+		void					stateClass::Delete( CStateMachineRegistration<host>& stateMachineReg, CStateHierarchy<host>*& pState ) \
+		{ \
+			if( pState ) \
+			{ \
+				stateClass* pConcreteState = static_cast<stateClass*>( pState ); \
+				pConcreteState->~stateClass(); \
+				stateMachineReg.FreeState( stateId, pConcreteState ); \
+				pState = NULL; \
+			} \
+		} \
 		uint stateClass::Register() \
 		{ \
 			host::RegisterState( &stateClass::Create, &stateClass::Delete, stateId );\
@@ -1147,17 +1575,18 @@ const SStateEvent SStateDebugContext::StateDebugAndLog(CStateHierarchy<HOST>* pS
 		, m_subStateIndex(1) \
 		{\
 			State_Root = SStateIndex<host> ("Root", (CStateProxy<host>::StatePtr)&stateClass::Root, NULL, m_subStateIndex++ ); \
-			m_stateIndexContainer.push_back( &State_Root ); 
+			AddSubState( State_Root ); 
 
 #define DEFINE_STATE_CLASS_ADD( host, stateClass, stateFunc, parentState )\
 		  State_##stateFunc = SStateIndex<host> (#stateFunc, (CStateProxy<host>::StatePtr)&stateClass::stateFunc, &State_##parentState, m_subStateIndex++ );\
-			m_stateIndexContainer.push_back( &State_##stateFunc ); 
+			AddSubState( State_##stateFunc ); 
 
 #define DEFINE_STATE_CLASS_ADD_DUMMY( host, stateClass, stateDummy, stateFunc, parentState )\
 		  State_##stateDummy = SStateIndex<host> (#stateDummy, (CStateProxy<host>::StatePtr)&stateClass::stateFunc, &State_##parentState, m_subStateIndex++ );\
-			m_stateIndexContainer.push_back( &State_##stateDummy ); 
+			AddSubState( State_##stateDummy ); 
 
 #define DEFINE_STATE_CLASS_END( host, stateClass )\
+			BindDispatchTable( s_dispatchTable ); \
 		}\
 		uint id##host##stateClass = stateClass::Register();
 }
\ No newline at end of file
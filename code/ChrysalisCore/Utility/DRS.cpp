@@ -1,39 +1,105 @@
 #include <StdAfx.h>
 
 #include "DRS.h"
+#include "Plugin/ChrysalisCorePlugin.h"
 
 
 namespace Chrysalis
 {
+namespace DRSKeys
+{
+const CHashedString kEmpty { "" };
+
+const CHashedString kVerb { "Verb" };
+const CHashedString kIsSwitchedOn { "IsSwitchedOn" };
+const CHashedString kIsInteractedOn { "IsInteractedOn" };
+const CHashedString kPlayAnimationFile { "PlayAnimationFile" };
+const CHashedString kPlayAnimationSpeed { "PlayAnimationSpeed" };
+const CHashedString kPlayAnimationBlendTime { "PlayAnimationBlendTime" };
+const CHashedString kPlayAnimationMovementIsControled { "PlayAnimationMovementIsControled" };
+const CHashedString kPlayAnimationLayer { "PlayAnimationLayer" };
+const CHashedString kPlayAnimationLooped { "PlayAnimationLooped" };
+const CHashedString kPlayAnimationRepeatLastFrame { "PlayAnimationRepeatLastFrame" };
+
+const CHashedString kInteractionSwitch { "interaction_switch" };
+const CHashedString kInteractionSwitchOn { "interaction_switch_on" };
+const CHashedString kInteractionSwitchOff { "interaction_switch_off" };
+const CHashedString kInteractionInteract { "interaction_interact" };
+const CHashedString kInteractionInteractStart { "interaction_interact_start" };
+const CHashedString kInteractionInteractTick { "interaction_interact_tick" };
+const CHashedString kInteractionInteractComplete { "interaction_interact_complete" };
+const CHashedString kInteractionInteractCancel { "interaction_interact_cancel" };
+}
+
+
 namespace DRSUtility
 {
+DRS::IVariableCollectionSharedPtr CContextCollectionPool::Acquire(uint32 layoutKey)
+{
+	SPooledCollection* pUnusedEntry { nullptr };
+
+	for (auto& entry : m_collections)
+	{
+		if (entry.pCollection.use_count() == 1)
+		{
+			if (entry.layoutKey == layoutKey)
+				return entry.pCollection;
+
+			pUnusedEntry = &entry;
+		}
+	}
+
+	auto pCollection = gEnv->pDynamicResponseSystem->CreateContextCollection();
+
+	// A collection set up for a layout which is no longer wanted can make way for the new one.
+	if (pUnusedEntry)
+		*pUnusedEntry = { pCollection, layoutKey };
+	else if (m_collections.size() < maxPooled)
+		m_collections.push_back({ pCollection, layoutKey });
+
+	return pCollection;
+}
+
+
 // Helper functions to make getting values from context variables easier.
 
-int GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const int default)
+int GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const int default)
 {
 	auto variable = pContextVariables->GetVariable(name);
 	return variable ? variable->GetValueAsInt() : default;
 }
 
 
-float GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const float default)
+float GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const float default)
 {
 	auto variable = pContextVariables->GetVariable(name);
 	return variable ? variable->GetValueAsFloat() : default;
 }
 
 
-CHashedString GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const CHashedString default)
+CHashedString GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const CHashedString& default)
 {
 	auto variable = pContextVariables->GetVariable(name);
 	return variable ? variable->GetValueAsHashedString() : default;
 }
 
 
-bool GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const bool default)
+bool GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const bool default)
 {
 	auto variable = pContextVariables->GetVariable(name);
 	return variable ? variable->GetValueAsBool() : default;
 }
+
+
+IEntity* GetTargetEntity(DRS::IResponseInstance* pResponseInstance, const string& targetName, SEntityNameHandle& handle)
+{
+	if (targetName.empty())
+	{
+		auto pResponseActor = pResponseInstance->GetCurrentActor();
+		return pResponseActor ? pResponseActor->GetLinkedEntity() : nullptr;
+	}
+
+	return CChrysalisCorePlugin::Get()->GetEntityNameResolver()->Resolve(targetName, handle);
+}
 }
 }
\ No newline at end of file
@@ -1,16 +1,102 @@
 #pragma once
 
 #include <CryDynamicResponseSystem/IDynamicResponseSystem.h>
+#include "DynamicResponseSystem/EntityNameResolver.h"
 
 
 namespace Chrysalis
 {
+/**
+The names of the signals and context variables we pass to the DRS. Each is hashed once, when the library is loaded,
+rather than every time a signal is sent or a variable is read.
+**/
+namespace DRSKeys
+{
+extern const CHashedString kEmpty;
+
+// Context variables.
+extern const CHashedString kVerb;
+extern const CHashedString kIsSwitchedOn;
+extern const CHashedString kIsInteractedOn;
+extern const CHashedString kPlayAnimationFile;
+extern const CHashedString kPlayAnimationSpeed;
+extern const CHashedString kPlayAnimationBlendTime;
+extern const CHashedString kPlayAnimationMovementIsControled;
+extern const CHashedString kPlayAnimationLayer;
+extern const CHashedString kPlayAnimationLooped;
+extern const CHashedString kPlayAnimationRepeatLastFrame;
+
+// Signals, and the verbs which are passed along with them.
+extern const CHashedString kInteractionSwitch;
+extern const CHashedString kInteractionSwitchOn;
+extern const CHashedString kInteractionSwitchOff;
+extern const CHashedString kInteractionInteract;
+extern const CHashedString kInteractionInteractStart;
+extern const CHashedString kInteractionInteractTick;
+extern const CHashedString kInteractionInteractComplete;
+extern const CHashedString kInteractionInteractCancel;
+}
+
+
 namespace DRSUtility
 {
-// Helper functions to make getting values from context variables easier.
-int GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const int default);
-float GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const float default);
-CHashedString GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const CHashedString default);
-bool GetValueOrDefault(const DRS::IVariableCollectionSharedPtr pContextVariables, const CHashedString& name, const bool default);
+/**
+A small pool of context variable collections, for a sender which queues signals often. A collection is handed out again
+once the DRS has finished with it, which we know because the pool holds the only remaining reference.
+
+Variables can't be removed from a collection, so the ones in a reused collection are simply overwritten. Each collection
+remembers the layout it was acquired for, and is only handed out again for the same layout. A sender which always sets
+the same variables can use the default layout. One whose variables can change should pass a key which identifies them,
+e.g. a hash of their names, so a collection never carries stale variables from a different set.
+**/
+class CContextCollectionPool
+{
+public:
+	CContextCollectionPool() = default;
+	~CContextCollectionPool() = default;
+
+
+	/**
+	Gets a collection which nothing else is using, creating one if they are all still queued or were set up for a
+	different layout.
+
+	\param	layoutKey (Optional) Identifies the set of variables the caller is going to set.
+
+	\return A context variable collection.
+	**/
+	DRS::IVariableCollectionSharedPtr Acquire(uint32 layoutKey = 0);
+
+private:
+	/** Beyond this many collections in-flight we stop pooling and let the extra ones go. */
+	static const size_t maxPooled { 16 };
+
+	struct SPooledCollection
+	{
+		DRS::IVariableCollectionSharedPtr pCollection;
+		uint32 layoutKey;
+	};
+
+	std::vector<SPooledCollection> m_collections;
+};
+
+
+// Helper functions to make getting values from context variables easier. Pass one of the DRSKeys as the name where
+// possible, so the name isn't hashed on every call.
+int GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const int default);
+float GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const float default);
+CHashedString GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const CHashedString& default);
+bool GetValueOrDefault(const DRS::IVariableCollectionSharedPtr& pContextVariables, const CHashedString& name, const bool default);
+
+/**
+Gets the entity a response should act upon. This is the entity with the target name, or the entity linked to the
+current actor when no target is named.
+
+\param 		   	pResponseInstance The response instance.
+\param 		   	targetName		  The name of the target entity, which may be empty.
+\param [in,out]	handle			  The cached resolution of the target name.
+
+\return Null if the entity couldn't be found, else the entity.
+**/
+IEntity* GetTargetEntity(DRS::IResponseInstance* pResponseInstance, const string& targetName, SEntityNameHandle& handle);
 }
 }
\ No newline at end of file
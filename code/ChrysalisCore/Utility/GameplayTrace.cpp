@@ -0,0 +1,231 @@
+#include <StdAfx.h>
+
+#include "GameplayTrace.h"
+#include <algorithm>
+#include <mutex>
+
+
+namespace Chrysalis
+{
+namespace
+{
+/** Names for each event, in the same order as EGameplayTraceEvent. */
+const char* const s_eventNames [] =
+{
+	"SwitchToggle",
+	"SwitchOn",
+	"SwitchOff",
+	"InteractStart",
+	"InteractTick",
+	"InteractComplete",
+	"InteractCancel",
+	"ItemInspect",
+	"ItemPickup",
+	"ItemDrop",
+	"ItemToss",
+	"ExamineStart",
+	"ExamineComplete",
+	"OpenableOpen",
+	"OpenableClose",
+	"LockableLock",
+	"LockableUnlock"
+};
+
+static_assert(CRY_ARRAY_COUNT(s_eventNames) == size_t(EGameplayTraceEvent::Count), "Every gameplay trace event needs a name.");
+
+
+struct SCategoryName
+{
+	const char* name;
+	uint32 categories;
+};
+
+const SCategoryName s_categoryNames [] =
+{
+	{ "switch", eGTC_Switch },
+	{ "interact", eGTC_Interact },
+	{ "item", eGTC_Item },
+	{ "openable", eGTC_Openable },
+	{ "all", eGTC_All },
+	{ "none", 0 }
+};
+
+
+/** A single event, small enough that four fit in a cache line. */
+struct SRecord
+{
+	int64 ticks;
+	EntityId entityId;
+	uint16 event;
+	uint16 threadIndex;
+};
+
+
+/** The number of records each thread keeps. This must be a power of two. */
+static const uint32 ringBufferSize = 1024;
+
+
+/** The records for one thread. Only that thread writes to it, so recording doesn't need a lock. */
+struct SRingBuffer
+{
+	SRecord records [ringBufferSize];
+
+	/** How many records have ever been written. The next one goes into the slot this wraps to. */
+	std::atomic<uint32> writeCount { 0 };
+
+	/**
+	The write count when the buffer was last cleared. Records before this are ignored by a dump. Only the owning thread
+	ever writes to writeCount, so clearing moves this instead.
+	**/
+	std::atomic<uint32> clearedAt { 0 };
+
+	uint16 threadIndex { 0 };
+};
+
+
+/** Guards the list of buffers, which is only changed the first time a thread records an event. */
+std::mutex s_buffersLock;
+std::vector<std::unique_ptr<SRingBuffer>> s_buffers;
+
+thread_local SRingBuffer* t_pBuffer { nullptr };
+
+
+SRingBuffer* GetThreadBuffer()
+{
+	if (!t_pBuffer)
+	{
+		std::lock_guard<std::mutex> lock(s_buffersLock);
+
+		// Buffers live until the library is unloaded, so a dump can still show what a thread did after it has exited.
+		s_buffers.emplace_back(new SRingBuffer());
+		t_pBuffer = s_buffers.back().get();
+		t_pBuffer->threadIndex = uint16(s_buffers.size() - 1);
+	}
+
+	return t_pBuffer;
+}
+}
+
+
+std::atomic<uint32> CGameplayTrace::s_enabledCategories { eGTC_All };
+
+
+void CGameplayTrace::Record(EGameplayTraceEvent event, EntityId entityId)
+{
+	SRingBuffer* pBuffer = GetThreadBuffer();
+	const uint32 writeCount = pBuffer->writeCount.load(std::memory_order_relaxed);
+
+	SRecord& record = pBuffer->records [writeCount & (ringBufferSize - 1)];
+	record.ticks = CryGetTicks();
+	record.entityId = entityId;
+	record.event = uint16(event);
+	record.threadIndex = pBuffer->threadIndex;
+
+	// Publish the record, so a dump on another thread sees it whole.
+	pBuffer->writeCount.store(writeCount + 1, std::memory_order_release);
+}
+
+
+void CGameplayTrace::Dump(uint32 maxRecords)
+{
+	std::vector<SRecord> records;
+
+	{
+		std::lock_guard<std::mutex> lock(s_buffersLock);
+
+		for (const auto& pBuffer : s_buffers)
+		{
+			// Read clearedAt first, so the write count can't be behind it.
+			const uint32 clearedAt = pBuffer->clearedAt.load(std::memory_order_acquire);
+			const uint32 writeCount = pBuffer->writeCount.load(std::memory_order_acquire);
+			const uint32 recordCount = min(writeCount - clearedAt, ringBufferSize);
+
+			const size_t firstRecord = records.size();
+			for (uint32 i = writeCount - recordCount; i != writeCount; ++i)
+				records.push_back(pBuffer->records [i & (ringBufferSize - 1)]);
+
+			// The owning thread carries on recording while we copy, so like a seqlock we check the write count again
+			// afterwards. Record i shares its slot with record i + ringBufferSize, which starts being written once the
+			// write count reaches that, so any record that far behind the new count may have been torn and is thrown away.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			const uint32 writeCountAfter = pBuffer->writeCount.load(std::memory_order_relaxed);
+			const int64 overwritten = int64(writeCountAfter - writeCount) + recordCount + 1 - ringBufferSize;
+			if (overwritten > 0)
+				records.erase(records.begin() + firstRecord, records.begin() + firstRecord + min(size_t(overwritten), size_t(recordCount)));
+		}
+	}
+
+	std::sort(records.begin(), records.end(), [](const SRecord& a, const SRecord& b) { return a.ticks < b.ticks; });
+
+	const size_t firstRecord = (records.size() > maxRecords) ? records.size() - maxRecords : 0;
+	CryLogAlways("Gameplay trace: showing %" PRISIZE_T " of %" PRISIZE_T " records, enabled categories: %s",
+		records.size() - firstRecord, records.size(), GetCategoryNames(GetEnabledCategories()).c_str());
+
+	if (records.empty())
+		return;
+
+	// Times are shown relative to the newest record, which is usually what we're trying to explain.
+	const int64 newestTicks = records.back().ticks;
+	const double ticksPerSecond = double(CryGetTicksPerSec());
+
+	for (size_t i = firstRecord; i < records.size(); ++i)
+	{
+		const SRecord& record = records [i];
+		const IEntity* pEntity = gEnv->pEntitySystem->GetEntity(record.entityId);
+
+		CryLogAlways("  %9.4fs  thread %2u  %-16s  entity %u (%s)",
+			(record.ticks - newestTicks) / ticksPerSecond, record.threadIndex, GetName(EGameplayTraceEvent(record.event)),
+			record.entityId, pEntity ? pEntity->GetName() : "removed");
+	}
+}
+
+
+void CGameplayTrace::Clear()
+{
+	std::lock_guard<std::mutex> lock(s_buffersLock);
+
+	// The owning threads may be recording right now, so leave their write counts alone and just move the start of the dump.
+	for (const auto& pBuffer : s_buffers)
+		pBuffer->clearedAt.store(pBuffer->writeCount.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+
+bool CGameplayTrace::GetCategoryFromName(const char* name, uint32& categories)
+{
+	for (const auto& categoryName : s_categoryNames)
+	{
+		if (stricmp(categoryName.name, name) == 0)
+		{
+			categories = categoryName.categories;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+string CGameplayTrace::GetCategoryNames(uint32 categories)
+{
+	string names;
+
+	// Only the single categories, not all or none.
+	for (const auto& categoryName : s_categoryNames)
+	{
+		if (categoryName.categories && ((categoryName.categories & (categoryName.categories - 1)) == 0) && (categories & categoryName.categories))
+		{
+			if (!names.empty())
+				names += " ";
+			names += categoryName.name;
+		}
+	}
+
+	return names.empty() ? string("none") : names;
+}
+
+
+const char* CGameplayTrace::GetName(EGameplayTraceEvent event)
+{
+	return (event < EGameplayTraceEvent::Count) ? s_eventNames [size_t(event)] : "Unknown";
+}
+}
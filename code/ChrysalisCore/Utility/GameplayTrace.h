@@ -0,0 +1,166 @@
+/**
+\file	Utility\GameplayTrace.h
+
+A lightweight trace of gameplay events, for finding out what happened without writing to the log while it happens. Each
+event is a small binary record holding what happened, to which entity, and when. Records go into a fixed size ring
+buffer belonging to the thread which made them, so recording never allocates, locks or touches the disk. Once a buffer is
+full the oldest records are overwritten.
+
+The buffers are only written out when asked for, with the gameplay_trace_dump command, and the gameplay_trace command
+picks which categories are recorded. Categories can also be removed at compile time by defining GAMEPLAY_TRACE_CATEGORIES,
+and the whole trace compiles away in release builds.
+**/
+#pragma once
+
+#include <atomic>
+
+
+namespace Chrysalis
+{
+#if !defined(_RELEASE)
+#define GAMEPLAY_TRACE_ENABLED			 (1)
+#else
+#define GAMEPLAY_TRACE_ENABLED			 (0)
+#endif
+
+// The categories which are compiled in. Events in any other category cost nothing at all.
+#if !defined(GAMEPLAY_TRACE_CATEGORIES)
+#define GAMEPLAY_TRACE_CATEGORIES		 (eGTC_All)
+#endif
+
+
+/** Categories of gameplay event, which can be recorded or ignored as a group. */
+enum EGameplayTraceCategory : uint32
+{
+	eGTC_Switch = BIT(0),
+	eGTC_Interact = BIT(1),
+	eGTC_Item = BIT(2),
+	eGTC_Openable = BIT(3),
+
+	eGTC_All = eGTC_Switch | eGTC_Interact | eGTC_Item | eGTC_Openable
+};
+
+
+/** The gameplay events which can be traced. Keep the names in GameplayTrace.cpp in the same order. */
+enum class EGameplayTraceEvent : uint16
+{
+	SwitchToggle,
+	SwitchOn,
+	SwitchOff,
+	InteractStart,
+	InteractTick,
+	InteractComplete,
+	InteractCancel,
+	ItemInspect,
+	ItemPickup,
+	ItemDrop,
+	ItemToss,
+	ExamineStart,
+	ExamineComplete,
+	OpenableOpen,
+	OpenableClose,
+	LockableLock,
+	LockableUnlock,
+
+	Count
+};
+
+
+class CGameplayTrace
+{
+public:
+	/**
+	Query if events in a category are being recorded.
+
+	\param	category The category.
+
+	\return True if the category is enabled, false if not.
+	**/
+	static bool IsEnabled(uint32 category) { return (s_enabledCategories.load(std::memory_order_relaxed) & category) != 0; }
+
+
+	/**
+	Sets which categories are recorded.
+
+	\param	categories A mask of EGameplayTraceCategory values.
+	**/
+	static void SetEnabledCategories(uint32 categories) { s_enabledCategories.store(categories, std::memory_order_relaxed); }
+
+
+	/** Gets which categories are recorded, as a mask of EGameplayTraceCategory values. */
+	static uint32 GetEnabledCategories() { return s_enabledCategories.load(std::memory_order_relaxed); }
+
+
+	/**
+	Records an event into the calling thread's ring buffer. Use the GameplayTrace macro rather than calling this directly,
+	so the call compiles away when the category isn't wanted.
+
+	\param	event    The event.
+	\param	entityId Identifier for the entity the event happened to.
+	**/
+	static void Record(EGameplayTraceEvent event, EntityId entityId);
+
+
+	/**
+	Writes the most recent records from every thread to the log, oldest first. Records which are written while the dump is
+	being made may not be included, and neither are the oldest records of a thread whose buffer wraps while it's copied.
+
+	\param	maxRecords The most records to write.
+	**/
+	static void Dump(uint32 maxRecords);
+
+
+	/** Throws away every record made so far. This is safe to call while other threads are recording. */
+	static void Clear();
+
+
+	/**
+	Finds a category, or every category, from its name.
+
+	\param 		   	name	   The name, which is one of switch, interact, item, openable, all or none.
+	\param [in,out]	categories The mask of EGameplayTraceCategory values for that name.
+
+	\return False if there is no category with that name.
+	**/
+	static bool GetCategoryFromName(const char* name, uint32& categories);
+
+
+	/**
+	Gets the names of the categories in a mask, for showing which are enabled.
+
+	\param	categories A mask of EGameplayTraceCategory values.
+
+	\return The names, separated by spaces, or none if the mask is empty.
+	**/
+	static string GetCategoryNames(uint32 categories);
+
+
+	/**
+	Gets the name of an event, for the dump.
+
+	\param	event The event.
+
+	\return The name.
+	**/
+	static const char* GetName(EGameplayTraceEvent event);
+
+private:
+	static std::atomic<uint32> s_enabledCategories;
+};
+
+
+#if GAMEPLAY_TRACE_ENABLED
+
+#define GameplayTrace(category, event, entityId)																	\
+	do																												\
+	{																												\
+		if (((GAMEPLAY_TRACE_CATEGORIES) & (category)) && ::Chrysalis::CGameplayTrace::IsEnabled(category))			\
+			::Chrysalis::CGameplayTrace::Record(event, entityId);													\
+	} while (0)
+
+#else
+
+#define GameplayTrace(category, event, entityId)		((void)0)
+
+#endif // GAMEPLAY_TRACE_ENABLED
+}
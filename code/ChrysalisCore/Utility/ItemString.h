@@ -18,6 +18,7 @@
 
 #include <CrySystem/ISystem.h>
 #include <StlUtils.h>
+#include <atomic>
 
 namespace Chrysalis
 {
@@ -30,24 +31,29 @@ namespace Chrysalis
 namespace SharedString
 {
 // Name entry header, immediately after this header in memory starts actual string data.
+// Entries live in the name table's arena and are never freed individually. Once the last reference is released the
+// entry stays interned, ready to be handed out again, so there's no race between a release and a concurrent lookup.
 struct SNameEntry
 {
-	int nRefCount;      // Reference count of this string.
+	std::atomic<int> nRefCount; // Reference count of this string.
 	int nLength;        // Current length of string.
-	int nAllocSize;     // Size of memory allocated at the end of this class.
+	int nAllocSize;     // Size of memory allocated for this entry, including the header.
+	uint32 nHash;       // Hash of the string, calculated once when it was interned.
 #if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
 	bool allocatedOnLevelHeap;
 #endif
 
-	// Here in memory starts character buffer of size nAllocSize.
-	//char data[nAllocSize]
+	// Here in memory starts character buffer of size nLength + 1.
+	//char data[nLength + 1]
 
 	char* GetStr() { return (char*)(this + 1); }
-	void AddRef() { ++nRefCount; }
-	int  Release() { return --nRefCount; }
+	void AddRef() { nRefCount.fetch_add(1, std::memory_order_relaxed); }
+	int  Release() { return nRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1; }
 };
 
 //////////////////////////////////////////////////////////////////////////
+// A thread safe table of interned strings. The table is split into shards by hash, each with its own lock and arena, so
+// threads interning different names will rarely contend. The hash for a string is only ever calculated once per call.
 class CNameTable
 {
 public:
@@ -59,57 +65,81 @@ public:
 	}
 
 	~CNameTable()
-	{}
+	{
+		for (auto& shard : m_shards)
+		{
+			for (auto pPage : shard.pages)
+				free(pPage);
+		}
+	}
 
 	// Only finds an existing name table entry, return 0 if not found.
 	SNameEntry* FindEntry(const char* str)
 	{
-		SNameEntry* pEntry = stl::find_in_map(m_nameMap, str, 0);
-		return pEntry;
+		int nLen;
+		const uint32 hash = HashName(str, nLen);
+		SShard& shard = GetShard(hash);
+
+		CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+		return stl::find_in_map(shard.nameMap, SNameKey(str, hash), 0);
 	}
 
 	// Finds an existing name table entry, or creates a new one if not found.
 	SNameEntry* GetEntry(const char* str)
 	{
-		SNameEntry* pEntry = stl::find_in_map(m_nameMap, str, 0);
+		int nLen;
+		const uint32 hash = HashName(str, nLen);
+		SShard& shard = GetShard(hash);
+
+		CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+		SNameEntry* pEntry = stl::find_in_map(shard.nameMap, SNameKey(str, hash), 0);
 		if (!pEntry)
 		{
 			// Create a new entry.
-			unsigned int nLen = strlen(str);
-			unsigned int allocLen = sizeof(SNameEntry) + (nLen + 1) * sizeof(char);
-			pEntry = (SNameEntry*)malloc(allocLen);
-			pEntry->nRefCount = 0;
+			const int allocLen = Align(sizeof(SNameEntry) + (nLen + 1) * sizeof(char));
+			pEntry = new(shard.Allocate(allocLen)) SNameEntry;
+			pEntry->nRefCount.store(0, std::memory_order_relaxed);
 			pEntry->nLength = nLen;
 			pEntry->nAllocSize = allocLen;
+			pEntry->nHash = hash;
 #if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
-			pEntry->allocatedOnLevelHeap = (m_trackLevelHeapAllocs);
+			pEntry->allocatedOnLevelHeap = m_trackLevelHeapAllocs;
 #endif
 			// Copy string to the end of name entry.
 			memcpy(pEntry->GetStr(), str, nLen + 1);
 
 			// put in map.
-			m_nameMap.insert(NameMap::value_type(pEntry->GetStr(), pEntry));
+			shard.nameMap.insert(NameMap::value_type(SNameKey(pEntry->GetStr(), hash), pEntry));
 		}
+#if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
+		else if (pEntry->nRefCount.load(std::memory_order_relaxed) == 0)
+		{
+			// An unused entry being brought back to life belongs to whoever is using it now.
+			pEntry->allocatedOnLevelHeap = m_trackLevelHeapAllocs;
+		}
+#endif
 		return pEntry;
 	}
 
-	// Release existing name table entry.
-	void Release(SNameEntry* pEntry)
-	{
-		assert(pEntry);
-		m_nameMap.erase(pEntry->GetStr());
-		free(pEntry);
-	}
-
 	void Dump()
 	{
-		CryLogAlways("NameTable: %" PRISIZE_T " entries", m_nameMap.size());
-		NameMap::const_iterator iter = m_nameMap.begin();
-		NameMap::const_iterator iterEnd = m_nameMap.end();
-		while (iter != iterEnd)
+		size_t entryCount = 0;
+		size_t arenaBytes = 0;
+		for (auto& shard : m_shards)
+		{
+			CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+			entryCount += shard.nameMap.size();
+			arenaBytes += shard.pages.size() * pageSize;
+		}
+
+		CryLogAlways("NameTable: %" PRISIZE_T " entries, %" PRISIZE_T " bytes of arena", entryCount, arenaBytes);
+		for (auto& shard : m_shards)
 		{
-			CryLogAlways("'%s'", iter->first);
-			++iter;
+			CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+			for (auto& entry : shard.nameMap)
+			{
+				CryLogAlways("'%s' : Ref count: '%d'", entry.first.str, entry.second->nRefCount.load(std::memory_order_relaxed));
+			}
 		}
 	}
 
@@ -121,25 +151,105 @@ public:
 
 	void DumpLevelHeapLeakedStrings()
 	{
-		NameMap::const_iterator iter = m_nameMap.begin();
-		NameMap::const_iterator iterEnd = m_nameMap.end();
-		while (iter != iterEnd)
+		for (auto& shard : m_shards)
 		{
-			if (iter->second->allocatedOnLevelHeap)
+			CryAutoLock<CryCriticalSectionNonRecursive> lock(shard.lock);
+			for (auto& entry : shard.nameMap)
 			{
-				CRY_ASSERT_TRACE(false, ("Level allocated SharedString leaking '%s'", iter->first));
-				CryLogAlways("Level allocated SharedString leaking '%s' : Ref count: '%d'", iter->first, iter->second->nRefCount);
+				// Released entries stay in the table, so only those still referenced have leaked.
+				const int refCount = entry.second->nRefCount.load(std::memory_order_relaxed);
+				if (entry.second->allocatedOnLevelHeap && (refCount > 0))
+				{
+					CRY_ASSERT_TRACE(false, ("Level allocated SharedString leaking '%s'", entry.first.str));
+					CryLogAlways("Level allocated SharedString leaking '%s' : Ref count: '%d'", entry.first.str, refCount);
+				}
 			}
-			++iter;
 		}
 	}
 #endif
 
 private:
-	typedef std::unordered_map<const char*, SNameEntry*, stl::hash_strcmp<const char*>, stl::hash_strcmp<const char*> > NameMap;
-	NameMap m_nameMap;
+	enum
+	{
+		shardCount = 16,                // Must be a power of two.
+		pageSize = 16 * 1024,           // Size of each page of arena memory.
+		entryAlignment = alignof(SNameEntry),
+	};
+
+	// The key pairs a string with its precomputed hash, so neither the map nor the shard needs to hash it again.
+	struct SNameKey
+	{
+		SNameKey(const char* _str, uint32 _hash) : str(_str), hash(_hash) {}
+
+		const char* str;
+		uint32 hash;
+	};
+
+	struct SNameKeyHash
+	{
+		size_t operator()(const SNameKey& key) const { return key.hash; }
+	};
+
+	struct SNameKeyEqual
+	{
+		bool operator()(const SNameKey& lhs, const SNameKey& rhs) const { return (lhs.hash == rhs.hash) && (strcmp(lhs.str, rhs.str) == 0); }
+	};
+
+	typedef std::unordered_map<SNameKey, SNameEntry*, SNameKeyHash, SNameKeyEqual> NameMap;
+
+	struct SShard
+	{
+		// Bump allocates from the current page. Names too large for a page are given a page of their own.
+		void* Allocate(int size)
+		{
+			if (size > pageSize)
+			{
+				void* pMemory = malloc(size);
+				pages.push_back(pMemory);
+				return pMemory;
+			}
+
+			if (!pCurrentPage || (pageUsed + size > pageSize))
+			{
+				pCurrentPage = (char*)malloc(pageSize);
+				pages.push_back(pCurrentPage);
+				pageUsed = 0;
+			}
+
+			void* pMemory = pCurrentPage + pageUsed;
+			pageUsed += size;
+			return pMemory;
+		}
+
+		CryCriticalSectionNonRecursive lock;
+		NameMap nameMap;
+		std::vector<void*> pages;
+		char* pCurrentPage { nullptr };
+		int pageUsed { 0 };
+	};
+
+	static int Align(size_t size) { return int((size + entryAlignment - 1) & ~size_t(entryAlignment - 1)); }
+
+	// FNV-1a, which lets us find the length in the same pass.
+	static uint32 HashName(const char* str, int& nLen)
+	{
+		uint32 hash = 2166136261u;
+		const char* pChar = str;
+		for (; *pChar; ++pChar)
+		{
+			hash ^= uint8(*pChar);
+			hash *= 16777619u;
+		}
+		nLen = int(pChar - str);
+		return hash;
+	}
+
+	// The low bits are left for the buckets within each shard's map.
+	SShard& GetShard(uint32 hash) { return m_shards [(hash >> 24) & (shardCount - 1)]; }
+
+	SShard m_shards [shardCount];
 #if SHARED_STRING_TRACK_LEVEL_HEAP_LEAKS
-	bool m_trackLevelHeapAllocs;
+	std::atomic<bool> m_trackLevelHeapAllocs;
 #endif
 };
 
@@ -217,11 +327,9 @@ private:
 	void        _addref(const char* pBuffer) { if (pBuffer) _entry(pBuffer)->AddRef(); }
 	void        _release(const char* pBuffer)
 	{
-		if (pBuffer && _entry(pBuffer)->Release() <= 0)
-		{
-			if (CNameTable* pNT = GetNameTable())
-				pNT->Release(_entry(pBuffer));
-		}
+		// The name table keeps the entry once it's unused, so there is nothing more to do here.
+		if (pBuffer)
+			_entry(pBuffer)->Release();
 	}
 
 	const char* m_str;
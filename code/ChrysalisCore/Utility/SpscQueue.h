@@ -0,0 +1,75 @@
+/**
+\file	Utility\SpscQueue.h
+
+A fixed size, lock-free queue for passing values from exactly one producer thread to exactly one consumer thread. The
+storage is allocated up front, so pushing and popping never allocate or block.
+**/
+#pragma once
+
+#include <atomic>
+
+
+namespace Chrysalis
+{
+template<typename TYPE, uint32 CAPACITY>
+class CSpscQueue
+{
+	static_assert((CAPACITY > 0) && ((CAPACITY & (CAPACITY - 1)) == 0), "The capacity must be a power of two.");
+
+public:
+	CSpscQueue() = default;
+	CSpscQueue(const CSpscQueue&) = delete;
+	CSpscQueue& operator=(const CSpscQueue&) = delete;
+
+
+	/**
+	Adds a value to the back of the queue. Only call this from the producer thread.
+
+	\param	value The value.
+
+	\return False if the queue is full, in which case the value is not added.
+	**/
+	bool Push(const TYPE& value)
+	{
+		const uint32 tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) >= CAPACITY)
+			return false;
+
+		m_items [tail & (CAPACITY - 1)] = value;
+		m_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	/**
+	Removes the value at the front of the queue. Only call this from the consumer thread.
+
+	\param [out]	value The value.
+
+	\return False if the queue is empty.
+	**/
+	bool Pop(TYPE& value)
+	{
+		const uint32 head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+
+		value = m_items [head & (CAPACITY - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+
+	/** Determines if the queue is empty. This is only a snapshot if the other thread is active. */
+	bool IsEmpty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+private:
+	TYPE m_items [CAPACITY];
+
+	/** The head and tail are kept on separate cache lines, so the two threads don't fight over them. */
+	alignas(64) std::atomic<uint32> m_head { 0 };
+	alignas(64) std::atomic<uint32> m_tail { 0 };
+};
+}